@@ -0,0 +1,697 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <bygg/bygg.hpp>
+#include <bygg/HTML/HTML.hpp>
+#include <bygg/CSS/CSS.hpp>
+
+// NOLINTBEGIN
+namespace {
+    std::atomic<std::size_t> allocations{0};
+}
+
+/*
+ * Count every allocation made by the process, so that each benchmark can
+ * report how many allocations a single operation needs.
+ */
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+    /*
+     * A single workload. run() performs one operation and returns the number
+     * of bytes it produced or consumed, or 0 if bytes/s is meaningless for it.
+     */
+    struct Benchmark {
+        std::string name{};
+        bygg::size_type nodes{};
+        std::function<bygg::size_type()> run{};
+    };
+
+    struct Result {
+        std::string name{};
+        bygg::size_type iterations{};
+        bygg::size_type nodes{};
+        bygg::size_type bytes{};
+        double ns_per_op{};
+        double allocs_per_op{};
+    };
+
+    struct Settings {
+        std::vector<bygg::size_type> sizes{1000, 10000};
+        std::string filter{};
+        std::string json{};
+        double min_time{0.2};
+        bool list{false};
+    };
+
+    // keeps the compiler from dropping the work being measured
+    volatile bygg::size_type sink{};
+
+    bygg::size_type count_nodes(const bygg::HTML::Section& section) {
+        bygg::size_type ret{1};
+
+        for (const auto& it : section) {
+            if (const auto* child = std::get_if<bygg::HTML::Section>(&it)) {
+                ret += count_nodes(*child);
+            } else {
+                ++ret;
+            }
+        }
+
+        return ret;
+    }
+
+    // the parse benchmarks name the backend, since the default depends on how bygg was built
+    bygg::HTML::Parser::Options native_options() {
+        bygg::HTML::Parser::Options ret{};
+        ret.backend = bygg::HTML::Parser::Backend::Native;
+        return ret;
+    }
+
+    bygg::HTML::Section make_paragraphs(const bygg::size_type count) {
+        using namespace bygg::HTML;
+
+        Section sect{Tag::Html, Property{"i-hope", "you-are-ready-for-a-thousand-paragraphs"},
+            Section{Tag::Div, Property{"brace", "yourself"}},
+        };
+
+        auto& div = sect.at_section(0);
+        for (bygg::size_type i{1}; i <= count; ++i) {
+            div += Element{Tag::P, "This is paragraph " + std::to_string(i)};
+        }
+
+        return sect;
+    }
+
+    /*
+     * A page with a head, navigation and a table, with about count nodes.
+     */
+    bygg::HTML::Section make_page(const bygg::size_type count, const std::string& title = "Benchmark page") {
+        using namespace bygg::HTML;
+
+        Section table{Tag::Table, Property{"class", "data"}};
+        for (bygg::size_type i{0}; i < count / 4; ++i) {
+            table += Section{Tag::Tr, make_properties(Property{"id", "row-" + std::to_string(i)}, Property{"class", i % 2 ? "odd" : "even"}),
+                Element{Tag::Td, std::to_string(i)},
+                Element{Tag::Td, "Name of item " + std::to_string(i)},
+                Element{Tag::Td, "<b>" + std::to_string(i * 3) + "</b> & more"},
+            };
+        }
+
+        return Section{Tag::Html,
+            Section{Tag::Head,
+                Element{Tag::Title, title},
+                Element{Tag::Meta, make_properties(Property{"charset", "utf-8"})},
+                Element{Tag::Link, make_properties(Property{"rel", "stylesheet"}, Property{"href", "style.css"})},
+            },
+            Section{Tag::Body,
+                Section{Tag::Header,
+                    Element{Tag::H1, "Benchmark page"},
+                    Section{Tag::Nav,
+                        Element{Tag::A, make_properties(Property{"href", "/"}), "Home"},
+                        Element{Tag::A, make_properties(Property{"href", "/about"}), "About"},
+                    },
+                },
+                Section{Tag::Main, table},
+                Section{Tag::Footer,
+                    Element{Tag::P, "Footer"},
+                },
+            },
+        };
+    }
+
+    /*
+     * Hand-written markup resembling a typical content page, with comments,
+     * entities, inline scripts and styles, and irregular whitespace.
+     */
+    std::string make_real_page() {
+        std::string article{};
+        for (int i{0}; i < 40; ++i) {
+            article += "      <article class=\"post\" id=\"post-" + std::to_string(i) + "\">\n"
+                "        <h2><a href=\"/posts/" + std::to_string(i) + "\" title=\"Post &amp; more\">Post number " + std::to_string(i) + "</a></h2>\n"
+                "        <p class=\"meta\">Posted on <time datetime=\"2024-01-01\">January 1st</time> by <span class=\"author\">someone</span></p>\n"
+                "        <p>Lorem ipsum dolor sit amet, <em>consectetur</em> adipiscing elit. Sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.</p>\n"
+                "        <ul>\n"
+                "          <li>First point</li>\n"
+                "          <li>Second point with <code>code</code></li>\n"
+                "        </ul>\n"
+                "        <img src=\"/images/" + std::to_string(i) + ".png\" alt=\"Image\" width=\"640\" height=\"480\">\n"
+                "      </article>\n";
+        }
+
+        return "<!DOCTYPE html>\n"
+            "<html lang=\"en\">\n"
+            "  <head>\n"
+            "    <meta charset=\"utf-8\">\n"
+            "    <meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">\n"
+            "    <title>A weblog &mdash; Home</title>\n"
+            "    <link rel=\"stylesheet\" href=\"/style.css\">\n"
+            "    <style>body { margin: 0; } .post { padding: 1em; }</style>\n"
+            "    <script>window.analytics = window.analytics || [];</script>\n"
+            "  </head>\n"
+            "  <body>\n"
+            "    <!-- navigation -->\n"
+            "    <header>\n"
+            "      <nav><a href=\"/\">Home</a> | <a href=\"/archive\">Archive</a> | <a href=\"/about\">About</a></nav>\n"
+            "    </header>\n"
+            "    <main>\n" + article +
+            "    </main>\n"
+            "    <footer><p>&copy; 2024 Someone. All rights reserved.</p></footer>\n"
+            "  </body>\n"
+            "</html>\n";
+    }
+
+    /*
+     * A single paragraph holding count runs of nested inline markup, which the
+     * parser writes into the data of the paragraph.
+     */
+    std::string make_inline_page(const bygg::size_type count) {
+        std::string ret{"<html><body><p>"};
+        for (bygg::size_type i{0}; i < count; ++i) {
+            ret += "Some <b>bold and <i>italic <a href=\"/" + std::to_string(i) + "\">linked</a></i></b> text,\n";
+        }
+
+        return ret + "</p></body></html>";
+    }
+
+    std::string make_formatter_input(const bygg::size_type count) {
+        static const char* const tokens[] = {"@STRONG(bold)", "@ITALIC(italic)", "@CODE(code)", "@MARK(marked)", "@SUB(sub)", "@SPAN(span)"};
+
+        std::string ret{};
+        for (bygg::size_type i{0}; i < count; ++i) {
+            ret += "Some text with ";
+            ret += tokens[i % (sizeof(tokens) / sizeof(tokens[0]))];
+            ret += " in it. ";
+        }
+
+        return ret;
+    }
+
+    bygg::CSS::Stylesheet make_stylesheet(const bygg::size_type count) {
+        using namespace bygg::CSS;
+
+        Stylesheet ret{};
+        for (bygg::size_type i{0}; i < count; ++i) {
+            ret.push_back(Element{".class-" + std::to_string(i), make_properties(
+                Property{"color", "#" + std::to_string(100000 + i % 900000)},
+                Property{"margin", std::to_string(i % 16) + "px"},
+                Property{"display", i % 2 ? "block" : "flex"}
+            )});
+        }
+
+        return ret;
+    }
+
+    std::string format_name(const std::string& group, const std::string& variant, const bygg::size_type size) {
+        return group + "/" + variant + "/" + std::to_string(size);
+    }
+
+    std::vector<Benchmark> make_benchmarks(const bygg::size_type size) {
+        using namespace bygg::HTML;
+
+        std::vector<Benchmark> ret{};
+
+        ret.push_back({format_name("build", "paragraphs", size), size, [size]() -> bygg::size_type {
+            sink = sink + make_paragraphs(size).size();
+            return 0;
+        }});
+        ret.push_back({format_name("build", "page", size), size, [size]() -> bygg::size_type {
+            sink = sink + make_page(size).size();
+            return 0;
+        }});
+
+        const auto page = std::make_shared<Section>(make_page(size));
+        const bygg::size_type page_nodes{count_nodes(*page)};
+
+        const std::pair<const char*, Formatting> formattings[] = {
+            {"none", Formatting::None},
+            {"pretty", Formatting::Pretty},
+            {"newline", Formatting::Newline},
+        };
+
+        for (const auto& [name, formatting] : formattings) {
+            ret.push_back({format_name("render", name, size), page_nodes, [page, formatting = formatting]() {
+                return page->get(formatting).size();
+            }});
+        }
+
+        for (const auto& [name, formatting] : formattings) {
+            ret.push_back({format_name("write_to", name, size), page_nodes, [page, formatting = formatting]() {
+                std::string out{};
+                bygg::StringSink out_sink{out};
+                page->write_to(out_sink, formatting);
+                return out.size();
+            }});
+        }
+
+        // a whole page in fixed chunks, against only the head ahead of it
+        const auto flushed = std::make_shared<Section>(*page);
+        flushed->at_section(0).set_flush_point();
+        ret.push_back({format_name("renderer", "chunks", size), page_nodes, [flushed]() {
+            char buffer[4096];
+            bygg::size_type ret{0};
+            Renderer renderer{*flushed, Formatting::Pretty};
+
+            for (bygg::size_type n{}; (n = renderer.next_chunk(buffer, sizeof(buffer))) != 0;) {
+                ret += n;
+            }
+
+            return ret;
+        }});
+        ret.push_back({format_name("renderer", "first_chunk", size), page_nodes, [flushed]() {
+            char buffer[4096];
+            Renderer renderer{*flushed, Formatting::Pretty};
+            return renderer.next_chunk(buffer, sizeof(buffer));
+        }});
+
+        // the table of the page written straight to the output, against building and rendering it
+        ret.push_back({format_name("writer", "table", size), page_nodes, [size]() {
+            std::string out{};
+            bygg::StringSink out_sink{out};
+            Writer writer{out_sink};
+            Properties row{Property{"id", ""}, Property{"class", ""}};
+            std::string data{};
+
+            writer.open(Tag::Table, Properties{Property{"class", "data"}});
+            for (bygg::size_type i{0}; i < size / 4; ++i) {
+                row.at(0).set_value("row-" + std::to_string(i));
+                row.at(1).set_value(i % 2 ? "odd" : "even");
+                writer.open(Tag::Tr, row).element(Tag::Td, std::to_string(i));
+
+                data.assign("Name of item ").append(std::to_string(i));
+                writer.element(Tag::Td, data);
+                data.assign("<b>").append(std::to_string(i * 3)).append("</b> & more");
+                writer.element(Tag::Td, data).close();
+            }
+            writer.close().finish();
+
+            return out.size();
+        }});
+        ret.push_back({format_name("writer", "build_table", size), page_nodes, [size]() {
+            Section table{Tag::Table, Property{"class", "data"}};
+            for (bygg::size_type i{0}; i < size / 4; ++i) {
+                table += Section{Tag::Tr, make_properties(Property{"id", "row-" + std::to_string(i)}, Property{"class", i % 2 ? "odd" : "even"}),
+                    Element{Tag::Td, std::to_string(i)},
+                    Element{Tag::Td, "Name of item " + std::to_string(i)},
+                    Element{Tag::Td, "<b>" + std::to_string(i * 3) + "</b> & more"},
+                };
+            }
+
+            return table.get().size();
+        }});
+
+        const auto paragraphs = std::make_shared<Section>(make_paragraphs(size).at_section(0));
+        const Element last{Tag::P, "This is paragraph " + std::to_string(size)};
+
+        const std::string data{last.get_data()};
+        const std::string serialized{last.get()};
+
+        ret.push_back({format_name("find", "element", size), size, [paragraphs, last]() -> bygg::size_type {
+            sink = sink + paragraphs->find(last);
+            return 0;
+        }});
+        ret.push_back({format_name("find", "data", size), size, [paragraphs, data]() -> bygg::size_type {
+            sink = sink + paragraphs->find(data, 0, FindParameters::Search_Data | FindParameters::Exact);
+            return 0;
+        }});
+        ret.push_back({format_name("find", "deserialized", size), size, [paragraphs, serialized]() -> bygg::size_type {
+            sink = sink + paragraphs->find(serialized, 0, FindParameters::Search_Deserialized | FindParameters::Exact);
+            return 0;
+        }});
+        ret.push_back({format_name("find", "tag", size), size, [paragraphs]() -> bygg::size_type {
+            sink = sink + paragraphs->find(Tag::Span);
+            return 0;
+        }});
+
+        const auto selector = std::make_shared<Selector>("table.data > tr.odd > td:first-child");
+        ret.push_back({format_name("query", "selector", size), page_nodes, [page, selector]() -> bygg::size_type {
+            sink = sink + selector->query_all(*page).size();
+            return 0;
+        }});
+
+        // rebuilding and serializing the whole page, against filling in a compiled one
+        ret.push_back({format_name("template", "rebuild", size), page_nodes, [size]() {
+            return make_page(size, "Page title").get().size();
+        }});
+        const auto tmpl = std::make_shared<CompiledTemplate>(make_page(size, make_slot("title")));
+        ret.push_back({format_name("template", "render", size), page_nodes, [tmpl]() {
+            return tmpl->get({{"title", std::string{"Page title"}}}).size();
+        }});
+
+        const auto synthetic = std::make_shared<std::string>(Document{*page}.get(Formatting::Pretty));
+        ret.push_back({format_name("parse", "synthetic", size), page_nodes, [synthetic]() {
+            sink = sink + Parser::parse_html_string(*synthetic, native_options()).size();
+            return synthetic->size();
+        }});
+#ifdef BYGG_USE_LIBXML2
+        ret.push_back({format_name("parse", "synthetic_libxml2", size), page_nodes, [synthetic]() {
+            Parser::Options options{};
+            options.backend = Parser::Backend::Libxml2;
+
+            sink = sink + Parser::parse_html_string(*synthetic, options).size();
+            return synthetic->size();
+        }});
+#endif
+        ret.push_back({format_name("parse", "stream", size), page_nodes, [synthetic]() {
+            std::istringstream stream{*synthetic};
+            sink = sink + Parser::parse_html_stream(stream, native_options()).size();
+            return synthetic->size();
+        }});
+
+        ret.push_back({format_name("parse", "document", size), page_nodes, [synthetic]() {
+            sink = sink + Parser::ParsedDocument{*synthetic, std::pmr::get_default_resource(), Parser::Backend::Native}.size();
+            return synthetic->size();
+        }});
+
+        // inline markup is written into the data of the element holding it
+        const auto inline_page = std::make_shared<std::string>(make_inline_page(size));
+        ret.push_back({format_name("parse", "inline", size), size * 3, [inline_page]() {
+            sink = sink + Parser::parse_html_string(*inline_page, native_options()).size();
+            return inline_page->size();
+        }});
+
+        ret.push_back({format_name("pseudocode", "page", size), page_nodes, [page]() {
+            return generate_pseudocode(*page).size();
+        }});
+
+        const bygg::size_type tokens{std::max<bygg::size_type>(size / 10, 1)};
+        const auto input = std::make_shared<std::string>(make_formatter_input(tokens));
+        ret.push_back({format_name("content_formatter", "get", size), tokens, [input]() {
+            std::string str{*input};
+            sink = sink + ContentFormatter{str}.get().size();
+            return input->size();
+        }});
+
+        const auto stylesheet = std::make_shared<bygg::CSS::Stylesheet>(make_stylesheet(size));
+        ret.push_back({format_name("css", "none", size), size, [stylesheet]() {
+            return stylesheet->get(bygg::CSS::Formatting::None).size();
+        }});
+        ret.push_back({format_name("css", "pretty", size), size, [stylesheet]() {
+            return stylesheet->get(bygg::CSS::Formatting::Pretty).size();
+        }});
+
+        return ret;
+    }
+
+    std::vector<Benchmark> make_fixed_benchmarks() {
+        std::vector<Benchmark> ret{};
+
+        const auto real = std::make_shared<std::string>(make_real_page());
+        const bygg::size_type nodes{count_nodes(bygg::HTML::Parser::parse_html_string(*real))};
+
+        ret.push_back({"parse/real", nodes, [real]() {
+            sink = sink + bygg::HTML::Parser::parse_html_string(*real, native_options()).size();
+            return real->size();
+        }});
+        ret.push_back({"parse/real_stream", nodes, [real]() {
+            std::istringstream stream{*real};
+            sink = sink + bygg::HTML::Parser::parse_html_stream(stream, native_options()).size();
+            return real->size();
+        }});
+        ret.push_back({"parse/real_document", nodes, [real]() {
+            sink = sink + bygg::HTML::Parser::ParsedDocument{*real, std::pmr::get_default_resource(), bygg::HTML::Parser::Backend::Native}.size();
+            return real->size();
+        }});
+#ifdef BYGG_USE_LIBXML2
+        // the same page through libxml2, which the native backend is compared against
+        ret.push_back({"parse/real_libxml2", nodes, [real]() {
+            bygg::HTML::Parser::Options options{};
+            options.backend = bygg::HTML::Parser::Backend::Libxml2;
+
+            sink = sink + bygg::HTML::Parser::parse_html_string(*real, options).size();
+            return real->size();
+        }});
+#endif
+
+        // a batch of pages, parsed on every core
+        const auto batch = std::make_shared<std::vector<std::string>>(64, *real);
+        ret.push_back({"parse/many", nodes * batch->size(), [batch]() {
+            sink = sink + bygg::HTML::Parser::parse_many(*batch, native_options()).size();
+            return batch->size() * batch->front().size();
+        }});
+#ifdef BYGG_USE_LIBXML2
+        ret.push_back({"parse/many_libxml2", nodes * batch->size(), [batch]() {
+            bygg::HTML::Parser::Options options{};
+            options.backend = bygg::HTML::Parser::Backend::Libxml2;
+
+            sink = sink + bygg::HTML::Parser::parse_many(*batch, options).size();
+            return batch->size() * batch->front().size();
+        }});
+#endif
+
+        return ret;
+    }
+
+    Result run(const Benchmark& benchmark, const Settings& settings) {
+        using clock = std::chrono::steady_clock;
+
+        Result ret{benchmark.name, 0, benchmark.nodes};
+
+        // warm up caches, and find out how many bytes one operation handles
+        ret.bytes = benchmark.run();
+
+        const auto min_time = std::chrono::duration<double>(settings.min_time);
+        const std::size_t allocations_before{allocations.load(std::memory_order_relaxed)};
+        const auto begin = clock::now();
+        auto elapsed = clock::duration{};
+
+        do {
+            sink = sink + benchmark.run();
+            ++ret.iterations;
+            elapsed = clock::now() - begin;
+        } while (elapsed < min_time || ret.iterations < 3);
+
+        const std::size_t allocations_after{allocations.load(std::memory_order_relaxed)};
+
+        ret.ns_per_op = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(ret.iterations);
+        ret.allocs_per_op = static_cast<double>(allocations_after - allocations_before) / static_cast<double>(ret.iterations);
+
+        return ret;
+    }
+
+    double get_ns_per_node(const Result& result) {
+        return result.nodes == 0 ? 0.0 : result.ns_per_op / static_cast<double>(result.nodes);
+    }
+
+    double get_bytes_per_second(const Result& result) {
+        return result.ns_per_op == 0.0 ? 0.0 : static_cast<double>(result.bytes) * 1e9 / result.ns_per_op;
+    }
+
+    void print_result(std::ostream& stream, const Result& result) {
+        stream << std::left << std::setw(36) << result.name << std::right
+            << std::setw(10) << result.iterations
+            << std::setw(16) << std::fixed << std::setprecision(0) << result.ns_per_op
+            << std::setw(12) << std::setprecision(2) << get_ns_per_node(result)
+            << std::setw(12) << std::setprecision(1) << get_bytes_per_second(result) / (1024.0 * 1024.0)
+            << std::setw(14) << std::setprecision(1) << result.allocs_per_op << "\n";
+    }
+
+    std::string escape_json(const std::string& str) {
+        std::string ret{};
+
+        for (const char c : str) {
+            if (c == '"' || c == '\\') {
+                ret += '\\';
+            }
+            ret += c;
+        }
+
+        return ret;
+    }
+
+    void write_json(std::ostream& stream, const std::vector<Result>& results, const Settings& settings) {
+        stream << "{\n"
+            << "  \"context\": {\n"
+            << "    \"library\": \"bygg\",\n"
+#ifdef BYGG_VERSION
+            << "    \"version\": \"" << escape_json(BYGG_VERSION) << "\",\n"
+#endif
+            << "    \"min_time_s\": " << settings.min_time << "\n"
+            << "  },\n"
+            << "  \"benchmarks\": [\n";
+
+        for (std::size_t i{0}; i < results.size(); ++i) {
+            const Result& it = results[i];
+
+            stream << std::fixed << std::setprecision(3)
+                << "    {\"name\": \"" << escape_json(it.name) << "\""
+                << ", \"iterations\": " << it.iterations
+                << ", \"nodes\": " << it.nodes
+                << ", \"bytes\": " << it.bytes
+                << ", \"ns_per_op\": " << it.ns_per_op
+                << ", \"ns_per_node\": " << get_ns_per_node(it)
+                << ", \"bytes_per_second\": " << get_bytes_per_second(it)
+                << ", \"allocs_per_op\": " << it.allocs_per_op
+                << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+
+        stream << "  ]\n"
+            << "}\n";
+    }
+
+    void print_help(const char* name) {
+        std::cout << "usage: " << name << " [options]\n"
+            << "  --size N[,N...]   Number of nodes in the generated workloads (default: 1000,10000)\n"
+            << "  --filter STR      Only run benchmarks whose name contains STR\n"
+            << "  --min-time S      Minimum time to run each benchmark for, in seconds (default: 0.2)\n"
+            << "  --json FILE       Write the results as JSON to FILE, or to stdout if FILE is -\n"
+            << "  --list            List the benchmarks without running them\n"
+            << "  --help            Show this help\n";
+    }
+
+    bool parse_arguments(const int argc, char** argv, Settings& settings) {
+        for (int i{1}; i < argc; ++i) {
+            const std::string arg{argv[i]};
+
+            const auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument{"Missing value for " + arg};
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--size") {
+                settings.sizes.clear();
+                std::stringstream stream{value()};
+                for (std::string size; std::getline(stream, size, ',');) {
+                    settings.sizes.push_back(std::stoull(size));
+                }
+            } else if (arg == "--filter") {
+                settings.filter = value();
+            } else if (arg == "--min-time") {
+                settings.min_time = std::stod(value());
+            } else if (arg == "--json") {
+                settings.json = value();
+            } else if (arg == "--list") {
+                settings.list = true;
+            } else if (arg == "--help" || arg == "-h") {
+                print_help(argv[0]);
+                return false;
+            } else {
+                throw std::invalid_argument{"Unknown argument " + arg};
+            }
+        }
+
+        return true;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    Settings settings{};
+
+    try {
+        if (!parse_arguments(argc, argv, settings)) {
+            return 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        print_help(argv[0]);
+        return 1;
+    }
+
+    std::vector<Benchmark> benchmarks{make_fixed_benchmarks()};
+    for (const bygg::size_type size : settings.sizes) {
+        for (Benchmark& it : make_benchmarks(size)) {
+            benchmarks.push_back(std::move(it));
+        }
+    }
+
+    if (settings.list) {
+        for (const Benchmark& it : benchmarks) {
+            std::cout << it.name << "\n";
+        }
+        return 0;
+    }
+
+    // keep the table off stdout when the JSON goes there
+    std::ostream& table = settings.json == "-" ? std::cerr : std::cout;
+
+    table << std::left << std::setw(36) << "benchmark" << std::right
+        << std::setw(10) << "iters"
+        << std::setw(16) << "ns/op"
+        << std::setw(12) << "ns/node"
+        << std::setw(12) << "MiB/s"
+        << std::setw(14) << "allocs/op" << "\n";
+
+    std::vector<Result> results{};
+    for (const Benchmark& it : benchmarks) {
+        if (!settings.filter.empty() && it.name.find(settings.filter) == std::string::npos) {
+            continue;
+        }
+
+        results.push_back(run(it, settings));
+        print_result(table, results.back());
+    }
+
+    if (settings.json == "-") {
+        write_json(std::cout, results, settings);
+    } else if (!settings.json.empty()) {
+        std::ofstream file{settings.json};
+
+        if (!file) {
+            std::cerr << "Failed to open " << settings.json << "\n";
+            return 1;
+        }
+
+        write_json(file, results, settings);
+    }
+
+    return 0;
+}
+// NOLINTEND
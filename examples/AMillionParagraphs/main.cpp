@@ -0,0 +1,57 @@
+#include <chrono>
+#include <iostream>
+#include <bygg/HTML/HTML.hpp> // for all HTML related features
+
+int main() {
+   using namespace bygg::HTML;
+   using clock = std::chrono::steady_clock;
+
+   const auto elapsed = [](const clock::time_point begin, const clock::time_point end) {
+      return std::chrono::duration<double, std::milli>(end - begin).count();
+   };
+
+   Section sect{Tag::Html, Property{"i-hope", "you-are-ready-for-a-million-paragraphs"},
+      Section{Tag::Div, Property{"brace", "yourself"},
+      },
+   };
+
+   try {
+      auto& s = sect.at_section(0);
+
+      const auto build_begin = clock::now();
+
+      // add a million paragraphs to the inner div
+      for (int i = 1; i <= 1000000; ++i) {
+         s += Element{Tag::P, "This is paragraph " + std::to_string(i)};
+      }
+
+      const auto build_end = clock::now();
+      const Document document{sect};
+
+      // serialized_size() walks the tree once without producing any output,
+      // which is what get() uses to allocate the result up front
+      const auto size_begin = clock::now();
+      const auto size = document.serialized_size(Formatting::Pretty);
+      const auto size_end = clock::now();
+
+      const auto get_begin = clock::now();
+      const auto html = document.get<std::string>(Formatting::Pretty);
+      const auto get_end = clock::now();
+
+      // write_to() streams into a sink instead, without building the page in memory at all
+      std::string streamed{};
+      bygg::StringSink sink{streamed};
+
+      const auto write_begin = clock::now();
+      document.write_to(sink, Formatting::Pretty);
+      const auto write_end = clock::now();
+
+      std::cout << "build:           " << elapsed(build_begin, build_end) << " ms\n";
+      std::cout << "serialized_size: " << elapsed(size_begin, size_end) << " ms (" << size << " bytes)\n";
+      std::cout << "get:             " << elapsed(get_begin, get_end) << " ms (" << html.size() << " bytes, capacity " << html.capacity() << ")\n";
+      std::cout << "write_to:        " << elapsed(write_begin, write_end) << " ms (" << streamed.size() << " bytes, capacity " << streamed.capacity() << ")\n";
+   } catch (bygg::out_of_range& e) {
+      std::cerr << "Failed to get the inner div: " << e.what() << "\n";
+      return 1;
+   }
+}
@@ -0,0 +1,76 @@
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+#include <vector>
+#include <bygg/HTML/HTML.hpp> // for all HTML related features
+
+// Each "request" builds a page with a few thousand nodes, renders it and throws it away.
+static constexpr int requests{2000};
+static constexpr int items{500};
+
+int main() {
+   using namespace bygg::HTML;
+   using clock = std::chrono::steady_clock;
+
+   const auto run = [](const char* name, const auto& request) {
+      std::size_t bytes{};
+
+      const auto begin = clock::now();
+      for (int i = 0; i < requests; ++i) {
+         bytes += request();
+      }
+      const auto end = clock::now();
+
+      const double seconds = std::chrono::duration<double>(end - begin).count();
+      std::cout << name << static_cast<double>(requests) / seconds << " requests/s (" << bytes / requests << " bytes per page)\n";
+   };
+
+   // the usual way: a Section tree on the default allocator
+   run("Section:              ", []() {
+      Section page{Tag::Html,
+         Section{Tag::Head, Element{Tag::Title, "Items"}},
+      };
+
+      Section& list = page.emplace_back<Section>(Tag::Body).emplace_back<Section>(Tag::Ul, make_properties(Property{"class", "items"}));
+      for (int i = 0; i < items; ++i) {
+         list.emplace_back<Element>(Tag::Li, make_properties(Property{"id", "item-" + std::to_string(i)}), "Item number " + std::to_string(i));
+      }
+
+      return page.get(Formatting::Pretty).size();
+   });
+
+   const auto build_tree = [](Tree& page) {
+      const Tree::index_type head = page.add_section(Tree::root(), Tag::Head);
+      page.add_element(head, Tag::Title, "Items");
+
+      const Tree::index_type body = page.add_section(Tree::root(), Tag::Body);
+      const Tree::index_type list = page.add_section(body, Tag::Ul, make_properties(Property{"class", "items"}));
+      for (int i = 0; i < items; ++i) {
+         page.add_element(list, Tag::Li, make_properties(Property{"id", "item-" + std::to_string(i)}), "Item number " + std::to_string(i));
+      }
+   };
+
+   // a flat Tree on the default allocator
+   run("Tree:                 ", [&build_tree]() {
+      Tree page{Section{Tag::Html}};
+      build_tree(page);
+
+      return page.get(Formatting::Pretty).size();
+   });
+
+   // a flat Tree in an arena; everything is released at once at the end of the request,
+   // and the arena reuses the same buffer for every request
+   std::vector<std::byte> buffer(1 << 20);
+   run("Tree (monotonic):     ", [&build_tree, &buffer]() {
+      std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size()};
+      Tree page{Section{Tag::Html}, &arena};
+      build_tree(page);
+
+      // the page is rendered into the arena as well
+      const std::size_t size = page.serialized_size(Formatting::Pretty);
+      bygg::FixedBufferSink html{static_cast<char*>(arena.allocate(size, 1)), size};
+      page.write_to(html, Formatting::Pretty);
+
+      return html.size();
+   });
+}
@@ -49,4 +49,5 @@ int main() {
     }
 
     // TIP: You can strategically use Property objects to find specific elements.
+    // TIP: query_selector(root, "body > div#content > p") finds the same paragraph in a single call.
 }
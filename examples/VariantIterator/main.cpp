@@ -28,6 +28,7 @@ int main() {
    // This object can be one of the following types:
    // - bygg::HTML::Element
    // - bygg::HTML::Section
+   // - bygg::HTML::SharedSection (a subtree shared between several sections, see SharedSection)
    // In order to determine which type it is, we can use std::holds_alternative<>().
    // If it's an Element, we can use std::get<bygg::HTML::Element>() to get the Element object.
    // If it's a Section, we can use std::get<bygg::HTML::Section>() to get the Section object.
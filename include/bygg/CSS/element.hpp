@@ -286,7 +286,9 @@ namespace bygg::CSS {
              * @param type The type of the element
              * @param p The pseudo class of the element
              */
-            Element(string_type tag, const bygg::CSS::Properties& properties, Type type = Type::Selector, PseudoClass p = {}) : selector(std::move(tag)), children({properties}), type(type), pseudo(std::move(p)) {};
+            Element(string_type tag, bygg::CSS::Properties properties, Type type = Type::Selector, PseudoClass p = {}) : selector(std::move(tag)), type(type), pseudo(std::move(p)) {
+                children.emplace_back(std::move(properties));
+            }
             /**
              * @brief Construct a new Element object
              * @param tag The tag of the element
@@ -294,7 +296,9 @@ namespace bygg::CSS {
              * @param type The type of the element
              * @param p The pseudo class of the element
              */
-            Element(HTML::Tag tag, const Properties& properties, Type type = Type::Selector, PseudoClass p = {}) : selector(resolve_tag(tag).first), children({properties}), type(type), pseudo(std::move(p)) {};
+            Element(HTML::Tag tag, Properties properties, Type type = Type::Selector, PseudoClass p = {}) : selector(get_tag_info(tag).name), type(type), pseudo(std::move(p)) {
+                children.emplace_back(std::move(properties));
+            }
             /**
              * @brief Construct a new Element object
              * @param tag The tag of the element
@@ -302,7 +306,9 @@ namespace bygg::CSS {
              * @param p The pseudo class of the element
              * @param properties The properties of the element
              */
-            Element(string_type tag, Type type, PseudoClass p, const Properties& properties) : selector(std::move(tag)), children({properties}), type(type), pseudo(std::move(p)) {};
+            Element(string_type tag, Type type, PseudoClass p, Properties properties) : selector(std::move(tag)), type(type), pseudo(std::move(p)) {
+                children.emplace_back(std::move(properties));
+            }
             /**
              * @brief Construct a new Element object
              * @param tag The tag of the element
@@ -310,32 +316,43 @@ namespace bygg::CSS {
              * @param p The pseudo class of the element
              * @param properties The properties of the element
              */
-            Element(HTML::Tag tag, Type type, PseudoClass p, const Properties& properties) : selector(resolve_tag(tag).first), children({properties}), type(type), pseudo(std::move(p)) {};
+            Element(HTML::Tag tag, Type type, PseudoClass p, Properties properties) : selector(get_tag_info(tag).name), type(type), pseudo(std::move(p)) {
+                children.emplace_back(std::move(properties));
+            }
             /**
              * @brief Construct a new Element object
              * @param tag The tag of the element
              * @param type The type of the element
              * @param properties The properties of the element
              */
-            Element(string_type tag, Type type, const Properties& properties) : selector(std::move(tag)), children({properties}), type(type) {};
+            Element(string_type tag, Type type, Properties properties) : selector(std::move(tag)), type(type) {
+                children.emplace_back(std::move(properties));
+            }
             /**
              * @brief Construct a new Element object
              * @param tag The tag of the element
              * @param type The type of the element
              * @param properties The properties of the element
              */
-            Element(HTML::Tag tag, Type type, const Properties& properties) : selector(resolve_tag(tag).first), children({properties}), type(type) {};
+            Element(HTML::Tag tag, Type type, Properties properties) : selector(get_tag_info(tag).name), type(type) {
+                children.emplace_back(std::move(properties));
+            }
             /**
              * @brief Construct a new Element object
              * @param element The element to set
              */
             Element(const Element& element) = default;
+            /**
+             * @brief Construct a new Element object
+             * @param element The element to move from
+             */
+            Element(Element&& element) noexcept = default;
             /**
              * @brief Construct a new Element object
              * @param tag The tag of the element
              * @param args The properties of the element
              */
-            template <typename... Args, typename = std::enable_if_t<std::conjunction_v<std::disjunction<std::is_same<Args, Property>, std::is_same<Args, Element>, std::is_same<Args, Properties>>...>>>
+            template <typename... Args, typename = std::enable_if_t<std::conjunction_v<std::disjunction<std::is_same<std::decay_t<Args>, Property>, std::is_same<std::decay_t<Args>, Element>, std::is_same<std::decay_t<Args>, Properties>>...>>>
             explicit Element(string_type tag, Args&&... args) :
                 selector(std::move(tag)),
                 children({bygg::CSS::Properties(std::forward<Args>(args)...)}) {};
@@ -344,9 +361,9 @@ namespace bygg::CSS {
              * @param tag The tag of the element
              * @param args The properties of the element
              */
-            template <typename... Args, typename = std::enable_if_t<std::conjunction_v<std::disjunction<std::is_same<Args, Property>, std::is_same<Args, Element>, std::is_same<Args, Properties>>...>>>
+            template <typename... Args, typename = std::enable_if_t<std::conjunction_v<std::disjunction<std::is_same<std::decay_t<Args>, Property>, std::is_same<std::decay_t<Args>, Element>, std::is_same<std::decay_t<Args>, Properties>>...>>>
             explicit Element(HTML::Tag tag, Args&&... args) :
-                selector(resolve_tag(tag).first),
+                selector(get_tag_info(tag).name),
                 children({bygg::CSS::Properties(std::forward<Args>(args)...)}) {};
             /**
              * @brief Construct a new Element object
@@ -369,7 +386,7 @@ namespace bygg::CSS {
              * @param args The properties of the element
              */
             template <typename... Args> explicit Element(HTML::Tag tag, Type type, PseudoClass p, Args&&... args) :
-                selector(resolve_tag(tag).first),
+                selector(get_tag_info(tag).name),
                 type(type),
                 pseudo(std::move(p)) {
                 (push_back(std::forward<Args>(args)), ...);
@@ -380,7 +397,7 @@ namespace bygg::CSS {
              * @param type The type of the element
              * @param args The properties of the element
              */
-            template <typename... Args, typename = std::enable_if_t<std::conjunction_v<std::disjunction<std::is_same<Args, Property>, std::is_same<Args, Element>, std::is_same<Args, Properties>>...>>>
+            template <typename... Args, typename = std::enable_if_t<std::conjunction_v<std::disjunction<std::is_same<std::decay_t<Args>, Property>, std::is_same<std::decay_t<Args>, Element>, std::is_same<std::decay_t<Args>, Properties>>...>>>
             explicit Element(string_type tag, Type type, Args&&... args) :
                 selector(std::move(tag)),
                 type(type) {
@@ -392,9 +409,9 @@ namespace bygg::CSS {
              * @param type The type of the element
              * @param args The properties of the element
              */
-            template <typename... Args, typename = std::enable_if_t<std::conjunction_v<std::disjunction<std::is_same<Args, Property>, std::is_same<Args, Element>, std::is_same<Args, Properties>>...>>>
+            template <typename... Args, typename = std::enable_if_t<std::conjunction_v<std::disjunction<std::is_same<std::decay_t<Args>, Property>, std::is_same<std::decay_t<Args>, Element>, std::is_same<std::decay_t<Args>, Properties>>...>>>
             explicit Element(HTML::Tag tag, Type type, Args&&... args) :
-                selector(resolve_tag(tag).first),
+                selector(get_tag_info(tag).name),
                 type(type) {
                 (push_back(std::forward<Args>(args)), ...);
             }
@@ -417,6 +434,16 @@ namespace bygg::CSS {
              * @param property The property to push
              */
             void push_back(const Property& property);
+            /**
+             * @brief Prepend a property to the element
+             * @param property The property to push
+             */
+            void push_front(Property&& property);
+            /**
+             * @brief Append a property to the element
+             * @param property The property to push
+             */
+            void push_back(Property&& property);
             /**
              * @brief Prepend properties to the element
              * @param properties The properties to push
@@ -437,12 +464,28 @@ namespace bygg::CSS {
              * @param element The element to push
              */
             void push_back(const Element& element);
+            /**
+             * @brief Prepend an element to the element
+             * @param element The element to push
+             */
+            void push_front(Element&& element);
+            /**
+             * @brief Append an element to the element
+             * @param element The element to push
+             */
+            void push_back(Element&& element);
             /**
              * @brief Insert a property into the element
              * @param index The index to insert the property
              * @param property The property to insert
              */
             void insert(size_type index, const Property& property);
+            /**
+             * @brief Insert a property into the element
+             * @param index The index to insert the property
+             * @param property The property to insert
+             */
+            void insert(size_type index, Property&& property);
             /**
              * @brief Insert an element into the element
              * @param index The index to insert the element
@@ -575,7 +618,7 @@ namespace bygg::CSS {
              * @param type The type of the element
              * @param pseudo The pseudo class of the element
              */
-            void set(const string_type& tag, const bygg::CSS::Properties& properties, Type type = Type::Selector, const PseudoClass& pseudo = {});
+            void set(string_type tag, bygg::CSS::Properties properties, Type type = Type::Selector, PseudoClass pseudo = {});
             /**
              * @brief Set the properties of the element
              * @param tag The tag of the element
@@ -583,12 +626,12 @@ namespace bygg::CSS {
              * @param type The type of the element
              * @param pseudo The pseudo class of the element
              */
-            void set(HTML::Tag tag, const bygg::CSS::Properties& properties, Type type = Type::Selector, const PseudoClass& pseudo = {});
+            void set(HTML::Tag tag, bygg::CSS::Properties properties, Type type = Type::Selector, PseudoClass pseudo = {});
             /**
              * @brief Set the tag of the element
              * @param tag The tag to set
              */
-            void set_tag(const string_type& tag);
+            void set_tag(string_type tag);
             /**
              * @brief Set the tag of the element
              * @param tag The tag to set
@@ -598,7 +641,7 @@ namespace bygg::CSS {
              * @brief Set the properties of the element
              * @param properties The properties to set
              */
-            void set_properties(const bygg::CSS::Properties& properties);
+            void set_properties(bygg::CSS::Properties properties);
             /**
              * @brief Set the type of the element
              * @param type The type to set
@@ -608,7 +651,7 @@ namespace bygg::CSS {
              * @brief Set the pseudo class of the element
              * @param pseudo The pseudo class to set
              */
-            void set_pseudo(const PseudoClass& pseudo);
+            void set_pseudo(PseudoClass pseudo);
             /**
              * @brief Get the element
              * @return std::pair<string_type, bygg::CSS::Properties> The element
@@ -653,6 +696,7 @@ namespace bygg::CSS {
             [[nodiscard]] PseudoClass get_pseudo() const;
 
             Element& operator=(const Element& element);
+            Element& operator=(Element&& element) noexcept;
             Element& operator=(const std::pair<string_type, bygg::CSS::Properties>& element);
             Element& operator+=(const Property& property);
             Property& operator[](const size_type& index);
@@ -33,12 +33,27 @@ namespace bygg::CSS {
         template <typename... Args> explicit Function(string_type name, Args&&... args) : name(std::move(name)) {
             (this->push_back(std::forward<Args>(args)), ...);
         }
+        /**
+         * @brief Construct a new Function object
+         * @param other The function to copy
+         */
+        Function(const Function& other) = default;
+        /**
+         * @brief Construct a new Function object
+         * @param other The function to move from
+         */
+        Function(Function&& other) noexcept = default;
         /**
         * @brief Push a parameter to the function
         * @param parameter The parameter to push
         */
         void push_back(const string_type& parameter);
         /**
+        * @brief Push a parameter to the function
+        * @param parameter The parameter to push
+        */
+        void push_back(string_type&& parameter);
+        /**
         * @brief Emplace a parameter to the function
         * @param parameter The parameter to emplace
         */
@@ -177,25 +192,26 @@ namespace bygg::CSS {
         * @brief Set the name of the function
         * @param name The name of the function
         */
-        void set_name(const string_type& name);
+        void set_name(string_type name);
         /**
         * @brief Set the parameters of the function
         * @note It is possible to convert the parameters to string_type using e.g. std::to_string
         * @param parameters The parameters of the function
         */
-        void set_parameters(const std::vector<string_type>& parameters);
+        void set_parameters(std::vector<string_type> parameters);
         /**
         * @brief Set the function name and parameters
         * @param name The name of the function
         * @param parameters The parameters of the function
         */
-        void set(const string_type& name, const std::vector<string_type>& parameters);
+        void set(string_type name, std::vector<string_type> parameters);
 
         [[nodiscard]] string_type& operator[](size_type index);
         [[nodiscard]] string_type operator[](size_type index) const;
         bool operator==(const Function& other) const;
         bool operator==(const string_type& other) const;
         Function& operator=(const Function& other);
+        Function& operator=(Function&& other) noexcept;
         operator string_type() const; // NOLINT
         void operator+=(const string_type& parameter);
         void operator+=(const Function& other);
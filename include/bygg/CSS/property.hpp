@@ -29,11 +29,16 @@ namespace bygg::CSS {
              * @param key The key of the property
              * @param value The value of the property
              */
-            Property(const string_type& key, const string_type& value) : property(std::make_pair(key, value)) {};
+            Property(string_type key, string_type value) : property(std::move(key), std::move(value)) {};
             /**
              * @brief Construct a new Property object
              */
             Property(const Property& property) = default;
+            /**
+             * @brief Construct a new Property object
+             * @param property The property to move from
+             */
+            Property(Property&& property) noexcept = default;
             /**
              * @brief Construct a new Property object
              */
@@ -89,20 +94,21 @@ namespace bygg::CSS {
              * @brief Set the key of the property.
              * @param key The key.
              */
-            void set_key(const string_type& key);
+            void set_key(string_type key);
             /**
              * @brief Set the value of the property.
              * @param value The value.
              */
-            void set_value(const string_type& value);
+            void set_value(string_type value);
             /**
              * @brief Set the property
              * @param key The key of the property
              * @param value The value of the property
              */
-            void set(const string_type& key, const string_type& value);
+            void set(string_type key, string_type value);
 
             Property& operator=(const Property& property);
+            Property& operator=(Property&& property) noexcept;
             bool operator==(const Property& property) const;
             bool operator!=(const Property& property) const;
             #ifndef BYGG_ALLOW_IMPLICIT_CONVERSIONS
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <bygg/types.hpp>
 #include <bygg/CSS/formatting_enum.hpp>
@@ -87,13 +88,19 @@ namespace bygg::CSS {
             /**
              * @brief Construct a new Stylesheet object
              */
-            template <typename... Args> explicit Stylesheet(Args... args) { (this->push_back(args), ...); }
-            explicit Stylesheet(const ElementList& elements) : elements(elements) {};
+            template <typename... Args, typename = std::enable_if_t<!(sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, Stylesheet> && ...))>>
+            explicit Stylesheet(Args&&... args) { (this->push_back(std::forward<Args>(args)), ...); }
+            explicit Stylesheet(ElementList elements) : elements(std::move(elements)) {};
             /**
              * @brief Construct a new Stylesheet object
              * @param stylesheet The stylesheet to set
              */
             Stylesheet(const Stylesheet& stylesheet) = default;
+            /**
+             * @brief Construct a new Stylesheet object
+             * @param stylesheet The stylesheet to move from
+             */
+            Stylesheet(Stylesheet&& stylesheet) noexcept = default;
             /**
              * @brief Construct a new Stylesheet object
              */
@@ -113,12 +120,36 @@ namespace bygg::CSS {
              * @param element The element to add
              */
             void push_back(const Element& element);
+            /**
+             * @brief Prepend an element to the stylesheet
+             * @param element The element to add
+             */
+            void push_front(Element&& element);
+            /**
+             * @brief Append an element to the stylesheet
+             * @param element The element to add
+             */
+            void push_back(Element&& element);
+            /**
+             * @brief Construct an element in place at the end of the stylesheet
+             * @param args The arguments to construct the element from
+             * @return Element& The new element
+             */
+            template <typename... Args> Element& emplace_back(Args&&... args) {
+                return this->elements.emplace_back(std::forward<Args>(args)...);
+            }
             /**
              * @brief Insert an element into the stylesheet
              * @param index The index to insert the element
              * @param element The element to insert
              */
             void insert(size_type index, const Element& element);
+            /**
+             * @brief Insert an element into the stylesheet
+             * @param index The index to insert the element
+             * @param element The element to insert
+             */
+            void insert(size_type index, Element&& element);
             /**
              * @brief Erase an element from the stylesheet. Note that this will NOT change the size/index.
              * @param index The index of the element to erase
@@ -198,7 +229,7 @@ namespace bygg::CSS {
              * @brief Set the elements of the stylesheet
              * @param elements The elements to set
              */
-            void set_elements(const ElementList& elements);
+            void set_elements(ElementList elements);
             /**
              * @brief Get the elements of the stylesheet
              * @return ElementList The elements of the stylesheet
@@ -221,7 +252,9 @@ namespace bygg::CSS {
             }
 
             Stylesheet& operator=(const Stylesheet& stylesheet);
+            Stylesheet& operator=(Stylesheet&& stylesheet) noexcept;
             Stylesheet& operator+=(const Element& element);
+            Stylesheet& operator+=(Element&& element);
             Element operator[](const int& index) const;
             Element& operator[](const int& index);
             bool operator==(const Stylesheet& stylesheet) const;
@@ -8,19 +8,26 @@
 
 #include <bygg/types.hpp>
 #include <bygg/except.hpp>
+#include <bygg/sink.hpp>
 
 #include <bygg/HTML/tag.hpp>
 #include <bygg/HTML/type_enum.hpp>
 #include <bygg/HTML/formatting_enum.hpp>
 #include <bygg/HTML/find_enum.hpp>
 #include <bygg/HTML/element_enum.hpp>
+#include <bygg/HTML/escaping_enum.hpp>
 #include <bygg/HTML/property.hpp>
 #include <bygg/HTML/properties.hpp>
 #include <bygg/HTML/element.hpp>
 #include <bygg/HTML/section.hpp>
+#include <bygg/HTML/selector.hpp>
+#include <bygg/HTML/shared_section.hpp>
+#include <bygg/HTML/compiled_template.hpp>
+#include <bygg/HTML/parallel.hpp>
+#include <bygg/HTML/tree.hpp>
 #include <bygg/HTML/document.hpp>
+#include <bygg/HTML/renderer.hpp>
+#include <bygg/HTML/writer.hpp>
 #include <bygg/HTML/pseudocode_generator.hpp>
 #include <bygg/HTML/content_formatter.hpp>
-#ifdef BYGG_USE_LIBXML2
 #include <bygg/HTML/parser.hpp>
-#endif
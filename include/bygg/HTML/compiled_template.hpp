@@ -0,0 +1,156 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <bygg/types.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/formatting_enum.hpp>
+#include <bygg/HTML/escaping_enum.hpp>
+#include <bygg/HTML/element.hpp>
+#include <bygg/HTML/section.hpp>
+#include <bygg/HTML/shared_section.hpp>
+
+namespace bygg::HTML {
+    /**
+     * @brief Get the marker for a template slot, to be placed in element data or property values
+     * @note To fill a slot with an element or section, place the marker alone in an element of Type::Text_No_Formatting, or of Type::Text to have it indented with Formatting::Pretty.
+     * @note The marker is the name between the Unicode noncharacters U+FDD0 and U+FDD1, which are reserved for internal use, so text such as {{name}} is never taken for a slot.
+     * @param name The name of the slot. May contain letters, digits, '_', '-' and '.'.
+     * @return string_type The marker
+     */
+    [[nodiscard]] string_type make_slot(const string_type& name);
+
+    /**
+     * @brief The values to fill the slots of a CompiledTemplate with, by name.
+     */
+    class Slots {
+        public:
+            /**
+             * @brief A slot value. Text is escaped as the template requires, elements and sections are serialized.
+             */
+            using value_type = std::variant<string_type, Element, Section, SharedSection>;
+        private:
+            std::unordered_map<string_type, value_type> values{};
+        public:
+            /**
+             * @brief Construct a new Slots object, with no values
+             */
+            Slots() = default;
+            /**
+             * @brief Construct a new Slots object
+             * @param values The names and values of the slots
+             */
+            Slots(std::initializer_list<std::pair<const string_type, value_type>> values) : values(values) {}
+
+            /**
+             * @brief Set the value of a slot, replacing any previous value
+             * @param name The name of the slot
+             * @param value The value of the slot
+             * @return Slots& The slots, for chaining
+             */
+            Slots& set(const string_type& name, value_type value);
+            /**
+             * @brief Get the value of a slot
+             * @param name The name of the slot
+             * @return const value_type* The value, or nullptr if it has not been set
+             */
+            [[nodiscard]] const value_type* get(const string_type& name) const;
+            /**
+             * @brief Remove all values
+             */
+            void clear();
+    };
+
+    /**
+     * @brief A section frozen into serialized chunks, with named slots left to fill in when it is rendered.
+     * @note The section is serialized once when the template is compiled. Every slot marker (see make_slot()) in element data or property values becomes a hole in the output. Rendering writes the chunks and slot values in turn, without walking the tree. The section must not contain the noncharacter U+FDD2, which is used while compiling.
+     * @note Text values are escaped where each marker is: in property values unless the escaping is Escaping::None, and in element data if the escaping is Escaping::All. Element parameters of the element holding a marker do not apply to the value.
+     * @note With Formatting::None, the output is identical to that of the section with each marker replaced by its value, except that a property whose value is left empty is still written. With other formattings, a marker that starts a line is indented to that line, and elements and sections are serialized at that indentation.
+     */
+    class CompiledTemplate {
+        private:
+            /*
+             * A hole in the output. It follows the static text up to offset, which runs
+             * from the end of the previous slot. tabc is the indentation of a marker that
+             * starts a line, and -1 for markers inside a line. newline is set if the
+             * template ends the line right after such a marker.
+             */
+            struct Slot {
+                size_type offset{};
+                size_type name{};
+                integer_type tabc{-1};
+                bool newline{false};
+                bool attribute{false};
+            };
+
+            string_type data{};
+            std::vector<string_type> names{};
+            std::vector<Slot> slots{};
+            Formatting formatting{Formatting::None};
+            Escaping escaping{Escaping::None};
+
+            void write_value(Sink& sink, const Slot& slot, const Slots::value_type& value) const;
+        public:
+            /**
+             * @brief Construct a new CompiledTemplate object
+             * @param section The section to compile
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data, including the values of slots
+             * @throws bygg::invalid_argument If the section contains the noncharacter U+FDD2
+             */
+            explicit CompiledTemplate(const Section& section, Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None);
+            /**
+             * @brief Construct a new CompiledTemplate object
+             * @param tmpl The template to copy
+             */
+            CompiledTemplate(const CompiledTemplate& tmpl) = default;
+            /**
+             * @brief Construct a new CompiledTemplate object
+             * @param tmpl The template to move from
+             */
+            CompiledTemplate(CompiledTemplate&& tmpl) noexcept = default;
+            /**
+             * @brief Destroy the CompiledTemplate object
+             */
+            ~CompiledTemplate() = default;
+
+            /**
+             * @brief Get the names of the slots, in the order they first appear
+             * @return const std::vector<string_type>& The names
+             */
+            [[nodiscard]] const std::vector<string_type>& get_slots() const;
+            /**
+             * @brief Check if the template has a slot
+             * @param name The name of the slot
+             * @return bool True if the template has the slot, false otherwise
+             */
+            [[nodiscard]] bool has_slot(const string_type& name) const;
+            /**
+             * @brief Render the template
+             * @param slots The values of the slots. Slots without a value are left empty.
+             * @return string_type The rendered template
+             */
+            [[nodiscard]] string_type get(const Slots& slots = {}) const;
+            /**
+             * @brief Render the template to a sink, producing the same output as get() without building intermediate strings.
+             * @param sink The sink to write to
+             * @param slots The values of the slots. Slots without a value are left empty.
+             */
+            void write_to(Sink& sink, const Slots& slots = {}) const;
+
+            CompiledTemplate& operator=(const CompiledTemplate& tmpl) = default;
+            CompiledTemplate& operator=(CompiledTemplate&& tmpl) noexcept = default;
+    };
+} // namespace bygg::HTML
@@ -17,6 +17,8 @@ namespace bygg::HTML {
     class Document {
             Section document{};
             string_type doctype{"<!DOCTYPE html>"};
+
+            friend class Renderer;
         public:
             /**
              * @brief The npos value
@@ -27,19 +29,54 @@ namespace bygg::HTML {
              * @brief Get the document
              * @param formatting The formatting type to use
              * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
              * @return string_type The document
              */
-            [[nodiscard]] string_type get(Formatting formatting = Formatting::None, integer_type tabc = 0) const;
+            [[nodiscard]] string_type get(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
             /**
              * @brief Get the document in the form of a specific type.
              * @return T The document in the form of a specific type
              */
-            template <typename T> T get(const Formatting formatting = Formatting::None, integer_type tabc = 0) const {
+            template <typename T> T get(const Formatting formatting = Formatting::None, integer_type tabc = 0, const Escaping escaping = Escaping::None) const {
                 if (std::is_same_v<T, string_type>) {
-                    return this->get(formatting, tabc);
+                    return this->get(formatting, tabc, escaping);
                 }
-                return T(this->get(formatting, tabc));
+                return T(this->get(formatting, tabc, escaping));
             }
+            /**
+             * @brief Write the document to a sink, producing the same output as get() without building intermediate strings.
+             * @param sink The sink to write to
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             */
+            void write_to(Sink& sink, Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Get the document, serializing large sections on several threads. The output is identical to that of get(formatting, tabc).
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param options The threads or executor to use, and which sections to split
+             * @param escaping Whether to escape attribute values and element data
+             * @return string_type The document
+             */
+            [[nodiscard]] string_type get(Formatting formatting, integer_type tabc, const ParallelOptions& options, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Write the document to a sink, serializing large sections on several threads.
+             * @param sink The sink to write to
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param options The threads or executor to use, and which sections to split
+             * @param escaping Whether to escape attribute values and element data
+             */
+            void write_to(Sink& sink, Formatting formatting, integer_type tabc, const ParallelOptions& options, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Compute the exact number of bytes get() would return for the document, without producing the output.
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             * @return size_type The size of the serialized output
+             */
+            [[nodiscard]] size_type serialized_size(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
             /**
              * @brief Get the section
              * @return Section The section
@@ -70,12 +107,12 @@ namespace bygg::HTML {
              * @brief Set the document
              * @param document The document to set
              */
-            void set(const Section& document);
+            void set(Section document);
             /**
              * @brief Set the doctype of the document
              * @param doctype The doctype to set
              */
-            void set_doctype(const string_type& doctype);
+            void set_doctype(string_type doctype);
             /**
              * @brief Get the size of the document
              * @return size_type The size of the document
@@ -102,15 +139,22 @@ namespace bygg::HTML {
              * @param document The section to be assigned to the document
              * @param doctype The doctype to prepend at the top, before the section
              */
-            explicit Document(const Section& document, string_type doctype = "<!DOCTYPE html>") : document(document), doctype(std::move(doctype)) {};
+            explicit Document(Section document, string_type doctype = "<!DOCTYPE html>") : document(std::move(document)), doctype(std::move(doctype)) {};
             /**
              * @brief Construct a new Document object
              * @param document The document to set
              */
             Document(const Document& document) = default;
+            /**
+             * @brief Construct a new Document object
+             * @param document The document to move from
+             */
+            Document(Document&& document) noexcept = default;
 
             Document& operator=(const Document& document);
+            Document& operator=(Document&& document) noexcept;
             Document& operator=(const Section& section);
+            Document& operator=(Section&& section);
             bool operator==(const Document& document) const;
             bool operator==(const Section& section) const;
             bool operator!=(const Document& document) const;
@@ -6,9 +6,14 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <bygg/types.hpp>
+#include <bygg/sink.hpp>
 #include <bygg/HTML/formatting_enum.hpp>
+#include <bygg/HTML/escaping_enum.hpp>
 #include <bygg/HTML/type_enum.hpp>
 #include <bygg/HTML/tag.hpp>
 #include <bygg/HTML/properties.hpp>
@@ -18,6 +23,28 @@
  * @brief A namespace to represent HTML elements and documents
  */
 namespace bygg::HTML {
+    class Section;
+
+    namespace impl {
+        /*
+         * Link from an element or section to the section that contains it, used to
+         * invalidate render caches. Copies and moves deliberately start out unlinked;
+         * the containing section sets the link.
+         */
+        class ParentLink {
+                const Section* section{nullptr};
+
+                friend class bygg::HTML::Section;
+            public:
+                ParentLink() = default;
+                ParentLink(const ParentLink&) noexcept {}
+                ParentLink& operator=(const ParentLink&) noexcept { return *this; }
+
+                void set(const Section* section) noexcept { this->section = section; }
+                void invalidate() const noexcept;
+        };
+    } // namespace impl
+
     /**
      * @brief A class to represent an HTML element
      */
@@ -28,6 +55,15 @@ namespace bygg::HTML {
             string_type data{};
             Type type{Type::Data};
             ElementParameters params{_default_element_parameters};
+            impl::ParentLink parent{};
+
+            size_type measure(Formatting formatting, integer_type tabc, Escaping escaping, char& last) const;
+            static std::uint64_t hash_properties(std::uint64_t seed, const Properties& properties) noexcept;
+            static void write(Sink& sink, std::string_view tag, const Properties& properties, std::string_view data, Type type, ElementParameters params, Formatting formatting, integer_type tabc, Escaping escaping);
+            friend class Section;
+            friend class Selector;
+            friend class Tree;
+            friend class Writer;
         public:
             /**
              * @brief The npos value
@@ -42,7 +78,7 @@ namespace bygg::HTML {
              * @param type The close tag type.
              * @param params The parameters of the element
              */
-            explicit Element(string_type tag, const Properties& properties, string_type data = {}, const Type& type = Type::Data, ElementParameters params = _default_element_parameters) : tag(std::move(tag)), properties(properties), data(std::move(data)), type(type), params(params) {};
+            explicit Element(string_type tag, Properties properties, string_type data = {}, const Type& type = Type::Data, ElementParameters params = _default_element_parameters) : tag(std::move(tag)), properties(std::move(properties)), data(std::move(data)), type(type), params(params) {};
             /**
              * @brief Construct a new Element object
              * @param tag The tag of the element
@@ -50,7 +86,7 @@ namespace bygg::HTML {
              * @param data The data of the element
              * @param params The parameters of the element
              */
-            explicit Element(const Tag tag, const Properties& properties, string_type data = {}, ElementParameters params = _default_element_parameters) : tag(resolve_tag(tag).first), properties(properties), data(std::move(data)), type(resolve_tag(tag).second), params(params) {};
+            explicit Element(const Tag tag, Properties properties, string_type data = {}, ElementParameters params = _default_element_parameters) : tag(get_tag_info(tag).name), properties(std::move(properties)), data(std::move(data)), type(get_tag_info(tag).type), params(params) {};
             /**
              * @brief Construct a new Element object
              * @param tag The tag of the element
@@ -65,12 +101,17 @@ namespace bygg::HTML {
              * @param data The data of the element
              * @param params The parameters of the element
              */
-            explicit Element(const Tag tag, string_type data = {}, ElementParameters params = _default_element_parameters) : tag(resolve_tag(tag).first), data(std::move(data)), type(resolve_tag(tag).second), params(params) {};
+            explicit Element(const Tag tag, string_type data = {}, ElementParameters params = _default_element_parameters) : tag(get_tag_info(tag).name), data(std::move(data)), type(get_tag_info(tag).type), params(params) {};
             /**
              * @brief Construct a new Element object
              * @param element The element to set
              */
             Element(const Element& element) = default;
+            /**
+             * @brief Construct a new Element object
+             * @param element The element to move from
+             */
+            Element(Element&& element) noexcept = default;
             /**
              * @brief Construct a new Element object
              */
@@ -87,7 +128,7 @@ namespace bygg::HTML {
              * @param type The close tag type.
              * @param params The parameters of the element
              */
-            void set(const string_type& tag, const Properties& properties, const string_type& data, Type type, ElementParameters params = _default_element_parameters);
+            void set(string_type tag, Properties properties, string_type data, Type type, ElementParameters params = _default_element_parameters);
             /**
              * @brief Set the tag, properties, and data of the element
              * @param tag The tag of the element
@@ -95,12 +136,12 @@ namespace bygg::HTML {
              * @param data The data of the element
              * @param params The parameters of the element
              */
-            void set(Tag tag, const Properties& properties, const string_type& data, ElementParameters params = _default_element_parameters);
+            void set(Tag tag, Properties properties, string_type data, ElementParameters params = _default_element_parameters);
             /**
              * @brief Set the tag of the element
              * @param tag The tag of the element
              */
-            void set_tag(const string_type& tag);
+            void set_tag(string_type tag);
             /**
              * @brief Set the tag of the element
              * @param tag The tag of the element
@@ -110,12 +151,12 @@ namespace bygg::HTML {
              * @brief Set the data of the element
              * @param data The data of the element
              */
-            void set_data(const string_type& data);
+            void set_data(string_type data);
             /**
              * @brief Set the properties of the element
              * @param properties The properties of the element
              */
-            void set_properties(const Properties& properties);
+            void set_properties(Properties properties);
             /**
              * @brief Set the type of the element
              * @param type The type of the element
@@ -130,17 +171,33 @@ namespace bygg::HTML {
              * @brief Get the element in the form of an HTML tag.
              * @return string_type The tag of the element
              */
-            [[nodiscard]] string_type get(Formatting formatting = Formatting::None, integer_type tabc = 0) const;
+            [[nodiscard]] string_type get(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
             /**
              * @brief Get the element in the form of a specific type.
              * @return T The element in the form of a specific type
              */
-            template <typename T> [[nodiscard]] T get(const Formatting formatting = Formatting::None, const integer_type tabc = 0) const {
+            template <typename T> [[nodiscard]] T get(const Formatting formatting = Formatting::None, const integer_type tabc = 0, const Escaping escaping = Escaping::None) const {
                 if (std::is_same_v<T, string_type>) {
-                    return this->get(formatting, tabc);
+                    return this->get(formatting, tabc, escaping);
                 }
-                return T(this->get(formatting, tabc));
+                return T(this->get(formatting, tabc, escaping));
             }
+            /**
+             * @brief Write the element to a sink, producing the same output as get() without building a string.
+             * @param sink The sink to write to
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             */
+            void write_to(Sink& sink, Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Compute the exact number of bytes get() would return for the element, without producing the output.
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             * @return size_type The size of the serialized output
+             */
+            [[nodiscard]] size_type serialized_size(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
             /**
              * @brief Get the tag of the element
              * @return string_type The data of the element
@@ -195,10 +252,23 @@ namespace bygg::HTML {
              * @return bool True if the element is empty, false otherwise.
              */
             [[nodiscard]] bool empty() const;
+            /**
+             * @brief Get a hash of the tag, properties, data and type of the element. Elements that compare equal have equal hashes.
+             * @return std::uint64_t The hash
+             */
+            [[nodiscard]] std::uint64_t get_hash() const noexcept;
 
             Element& operator=(const Element& element);
+            Element& operator=(Element&& element) noexcept;
             Element& operator+=(const string_type& data);
             bool operator==(const Element& element) const;
             bool operator!=(const Element& element) const;
     };
 } // namespace bygg
+
+/**
+ * @brief Hash an element by its contents, so that equal elements can be deduplicated in unordered containers
+ */
+template <> struct std::hash<bygg::HTML::Element> {
+    std::size_t operator()(const bygg::HTML::Element& element) const noexcept { return static_cast<std::size_t>(element.get_hash()); }
+};
@@ -0,0 +1,18 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+namespace bygg::HTML {
+    /**
+     * @brief Enum for escaping options. Escaping replaces &, <, >, " and ' with &amp;, &lt;, &gt;, &quot; and &apos;.
+     */
+    enum class Escaping {
+        None, /* No escaping. Attribute values and element data are written as they are. */
+        Attributes, /* Escape attribute values. */
+        All, /* Escape attribute values and element data. Entities written by ElementParameters are not escaped again. */
+    };
+} // namespace bygg
@@ -0,0 +1,28 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <string_view>
+#include <bygg/types.hpp>
+#include <bygg/sink.hpp>
+
+namespace bygg::HTML::impl {
+    /*
+     * Index of the first byte at or after pos that has to be escaped, or npos.
+     * Scans 32 bytes at a time with AVX2 or 16 with SSE2 where available.
+     */
+    size_type find_escape(std::string_view data, size_type pos = 0);
+    /*
+     * Write the data with &, <, >, " and ' replaced by entities. Runs without
+     * any of them are written as they are.
+     */
+    void write_escaped(Sink& sink, std::string_view data);
+    /*
+     * Size of the output of write_escaped().
+     */
+    size_type escaped_size(std::string_view data);
+} // namespace bygg::HTML::impl
@@ -0,0 +1,35 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace bygg::HTML::impl {
+    /*
+     * Seeds telling the kinds of node apart, so that an element and a section
+     * with the same contents do not hash alike.
+     */
+    constexpr std::uint64_t element_seed{0x6a09e667f3bcc908ULL};
+    constexpr std::uint64_t section_seed{0xbb67ae8584caa73bULL};
+
+    /*
+     * Mix a value into a running hash. The result depends on the order values are
+     * mixed in, and the splitmix64 finalizer spreads every input bit over it.
+     */
+    inline std::uint64_t hash_combine(const std::uint64_t seed, const std::uint64_t value) noexcept {
+        std::uint64_t x{seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2))};
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    inline std::uint64_t hash_string(const std::string_view str) noexcept {
+        return hash_combine(str.size(), std::hash<std::string_view>{}(str));
+    }
+} // namespace bygg::HTML::impl
@@ -6,20 +6,36 @@
  */
 #pragma once
 
-#include <bygg/HTML/type_enum.hpp>
-#include <bygg/HTML/properties.hpp>
+#include <exception>
 #include <bygg/types.hpp>
+#include <bygg/HTML/impl/sax.hpp>
 
 namespace bygg {
-    struct TagData {
-        string_type tag;
-        HTML::Type type;
-        std::string data;
-        HTML::Properties properties;
-        int depth{};
-    };
+    struct PushParserCallbacks;
+
+    /*
+     * Incremental parser on top of libxml2's HTML push parser. Exceptions thrown
+     * by the handler stop the parser and are thrown again from feed() or finish().
+     */
+    class PushParser : public SAXParser {
+            void* context{nullptr}; /* htmlParserCtxtPtr, kept opaque to leave libxml2 out of the header */
+            SAXHandler& handler;
+            string_type pending{}; /* text of the current text node, which may span several chunks */
+            SAXAttributes attributes{}; /* attributes of the current element, reused for every element */
+            std::exception_ptr error{};
+            bool finished{false};
 
-    using TagList = std::vector<TagData>;
+            void flush_text();
+            void check();
 
-    TagList parse_html_string(const string_type& html);
-} // namespace bygg
+            friend struct PushParserCallbacks;
+        public:
+            explicit PushParser(SAXHandler& handler);
+            PushParser(const PushParser&) = delete;
+            PushParser& operator=(const PushParser&) = delete;
+            ~PushParser() override;
+
+            void feed(const char* data, size_type size) override;
+            void finish() override;
+    };
+} // namespace bygg
\ No newline at end of file
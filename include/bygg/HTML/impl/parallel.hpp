@@ -0,0 +1,25 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <functional>
+#include <bygg/types.hpp>
+#include <bygg/HTML/parallel.hpp>
+
+namespace bygg::HTML::impl {
+    /*
+     * Get the number of threads to use, resolving 0 to the hardware concurrency.
+     */
+    size_type get_thread_count(const ParallelOptions& options);
+    /*
+     * Call task once for each index in [0, count), spread across the executor or
+     * the number of threads in the options, and return once every call has
+     * finished. The calling thread runs one of the tasks itself. The first
+     * exception thrown by a task is rethrown afterwards.
+     */
+    void run_tasks(size_type count, const std::function<void(size_type)>& task, const ParallelOptions& options);
+} // namespace bygg::HTML::impl
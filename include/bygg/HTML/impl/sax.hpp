@@ -0,0 +1,63 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <bygg/HTML/type_enum.hpp>
+#include <bygg/types.hpp>
+
+namespace bygg {
+    /*
+     * Get the type of element a tag produces, or the default type for unknown tags.
+     */
+    HTML::Type resolve_type(std::string_view tag);
+
+    /*
+     * An attribute as the parser reports it, valid until the handler returns.
+     */
+    struct SAXAttribute {
+        std::string_view key{};
+        std::string_view value{};
+    };
+
+    using SAXAttributes = std::vector<SAXAttribute>;
+
+    /*
+     * Receives the elements of a document from a SAXParser, in document order.
+     * Text is passed once per text node, as the DOM would hold it, and only if
+     * it is not all whitespace. Strings are only valid until the handler returns.
+     */
+    class SAXHandler {
+        public:
+            virtual void start_element(std::string_view tag, const SAXAttributes& attributes) = 0;
+            virtual void end_element() = 0;
+            virtual void text(std::string_view text) = 0;
+
+            SAXHandler() = default;
+            SAXHandler(const SAXHandler&) = delete;
+            SAXHandler& operator=(const SAXHandler&) = delete;
+            virtual ~SAXHandler() = default;
+    };
+
+    /*
+     * An incremental parser reporting to a SAXHandler, implemented by each backend.
+     * Input may be split anywhere, including inside tags and characters, and every
+     * element still open is closed by finish(). Exceptions thrown by the handler
+     * are thrown from feed() or finish().
+     */
+    class SAXParser {
+        public:
+            virtual void feed(const char* data, size_type size) = 0;
+            virtual void finish() = 0;
+
+            SAXParser() = default;
+            SAXParser(const SAXParser&) = delete;
+            SAXParser& operator=(const SAXParser&) = delete;
+            virtual ~SAXParser() = default;
+    };
+} // namespace bygg
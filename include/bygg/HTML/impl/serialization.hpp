@@ -0,0 +1,98 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <bygg/types.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/element_enum.hpp>
+
+namespace bygg::HTML::impl {
+    /*
+     * An ElementParameters value compiled into a table with one action per byte,
+     * so that text can be erased, collapsed and escaped in a single pass. Runs of
+     * bytes that need no action are found a block at a time and copied whole.
+     */
+    class TextTransform {
+        public:
+            enum Action : unsigned char {
+                Keep,
+                Erase,
+                Collapse, /* A space, where runs of spaces become one and leading and trailing spaces are dropped */
+                Replace, /* Replace + n replaces the byte with entity n */
+            };
+
+            /*
+             * Throws invalid_argument if the parameters both erase and replace the same character.
+             */
+            explicit TextTransform(ElementParameters params = ElementParameters::Erase_None);
+
+            [[nodiscard]] ElementParameters get_params() const { return this->params; }
+            /*
+             * Index of the first byte at or after pos that may need an action, or npos.
+             * Single spaces that are collapsed are skipped unless the next byte needs an
+             * action as well; leading spaces are left to the caller.
+             */
+            [[nodiscard]] size_type find(std::string_view data, size_type pos) const;
+            /*
+             * Check whether the output would differ from the data, so that the
+             * common case of plain text can be written out as is.
+             */
+            [[nodiscard]] bool required(std::string_view data) const;
+            /*
+             * Write the output. If escape is set, bytes copied from the data are escaped,
+             * but entities written by the transform itself are not.
+             */
+            void write(Sink& sink, std::string_view data, bool escape = false) const;
+            /*
+             * Write the output for one piece of a longer text, split where other
+             * output goes in between. preceded and followed tell whether there is
+             * output before and after the piece, so that spaces next to it are
+             * collapsed rather than dropped, as if the whole text were written.
+             */
+            void write_part(Sink& sink, std::string_view data, bool preceded, bool followed) const;
+            /*
+             * Size of the output. If it is not empty, last is set to its final byte.
+             */
+            [[nodiscard]] size_type measure(std::string_view data, char& last, bool escape = false) const;
+            [[nodiscard]] string_type apply(std::string_view data) const;
+        private:
+            template <typename Output> void run(std::string_view data, Output&& output, bool preceded = false, bool followed = false) const;
+
+            ElementParameters params{};
+            std::array<unsigned char, 256> actions{};
+            std::array<char, 8> specials{};
+            size_type special_count{};
+            std::string_view space{" "};
+            /*
+             * Set if a single space between two kept bytes stays as it is, so that
+             * find() can skip over it.
+             */
+            bool collapse_runs{false};
+    };
+
+    /*
+     * Get the compiled transform for the parameters. Transforms are compiled once
+     * per thread and kept, so the reference stays valid for the life of the thread.
+     */
+    const TextTransform& get_transform(ElementParameters params);
+
+    /*
+     * Throw invalid_argument if the parameters both erase and replace the same character.
+     */
+    void validate_parameters(ElementParameters params);
+    /*
+     * Check whether the parameters would change the data at all, so that the
+     * common case of plain text can be written out without copying it first.
+     */
+    bool requires_transform(std::string_view data, ElementParameters params);
+    /*
+     * Apply the erase and replace parameters to the data.
+     */
+    string_type apply_parameters(std::string_view data, ElementParameters params);
+} // namespace bygg::HTML::impl
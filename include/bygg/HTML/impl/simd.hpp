@@ -0,0 +1,22 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+/*
+ * BYGG_HAS_SSE2 is defined when SSE2 can be used unconditionally.
+ * BYGG_HAS_AVX2_DISPATCH is defined when functions can be compiled for AVX2
+ * with a target attribute, and picked at runtime if the processor supports it.
+ */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BYGG_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(BYGG_HAS_SSE2) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BYGG_HAS_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
@@ -0,0 +1,72 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <bygg/types.hpp>
+#include <bygg/HTML/impl/sax.hpp>
+
+namespace bygg {
+    /*
+     * The native parser backend, which has no dependencies. Text is scanned for <
+     * and &, and quoted attribute values for the quote and &, 16 bytes at a time
+     * with SSE2 where available. Void elements are those of Type::Standalone in
+     * the tag table.
+     *
+     * The elements are reported as libxml2 reports them for the same input: html,
+     * head, body and p are implied where libxml2 implies them, the elements an
+     * opening tag closes are taken from libxml2's table, and the contents of
+     * scripts and styles end at the first </ followed by a letter. Input is kept
+     * between calls to feed() only while a tag, reference or comment is incomplete.
+     */
+    class Tokenizer : public SAXParser {
+            SAXHandler& handler;
+            /* input not yet parsed, as it ends in the middle of a tag, reference or comment */
+            string_type buffer{};
+            /* text of the current text node, and where the text since the last tag starts in it */
+            string_type pending{};
+            size_type run{};
+            /* the tag and attributes of the current tag, with its name, keys and values end to end */
+            SAXAttributes attributes{};
+            string_type values{};
+            std::vector<size_type> ends{};
+            std::vector<string_type> open{};
+            /* misplaced html, head and body tags, whose closing tags are ignored */
+            size_type misplaced{};
+            bool seen_head{false};
+            bool seen_body{false};
+            /* inside a comment, or the contents of a script or style */
+            bool comment{false};
+            bool raw{false};
+            /* set once a closing tag leaves no element open, after which libxml2 ignores the input */
+            bool ended{false};
+            bool finished{false};
+
+            size_type parse(const char* begin, const char* end, bool final);
+            const char* parse_start_tag(const char* begin, const char* end, bool final);
+            const char* parse_end_tag(const char* begin, const char* end, bool final);
+
+            void characters(std::string_view data);
+            void flush_text();
+            void push(std::string_view tag, const SAXAttributes& attributes);
+            void pop();
+            void auto_close(std::string_view tag);
+            void check_implied(std::string_view tag);
+            void check_paragraph();
+            void start_tag(std::string_view tag, bool self_closing);
+            void end_tag(std::string_view tag);
+        public:
+            explicit Tokenizer(SAXHandler& handler);
+            Tokenizer(const Tokenizer&) = delete;
+            Tokenizer& operator=(const Tokenizer&) = delete;
+            ~Tokenizer() override = default;
+
+            void feed(const char* data, size_type size) override;
+            void finish() override;
+    };
+} // namespace bygg
@@ -0,0 +1,40 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <functional>
+#include <bygg/types.hpp>
+
+namespace bygg::HTML {
+    /**
+     * @brief Function used to run tasks concurrently. It is called once for every task but one, which runs on the calling thread, and may run the task on any thread, including the calling one.
+     */
+    using Executor = std::function<void(std::function<void()>)>;
+
+    /**
+     * @brief Options for serializing a section on several threads.
+     * @note Sections with at least min_members members are split into chunks of consecutive members, which are serialized concurrently and written out in order. Everything else is serialized on the calling thread. The output is identical to that of the serial functions.
+     */
+    struct ParallelOptions {
+        /**
+         * @brief The number of threads to use. 0 uses std::thread::hardware_concurrency().
+         */
+        size_type threads{0};
+        /**
+         * @brief The minimum number of members a section must have to be split into chunks
+         */
+        size_type min_members{1024};
+        /**
+         * @brief The number of members in each chunk. 0 picks a size giving a few chunks per thread.
+         */
+        size_type chunk_size{0};
+        /**
+         * @brief Executor to run the chunks with. If empty, threads are started for each split section.
+         */
+        Executor executor{};
+    };
+} // namespace bygg::HTML
@@ -6,10 +6,29 @@
  */
 #pragma once
 
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include <bygg/types.hpp>
+#include <bygg/HTML/properties.hpp>
 #include <bygg/HTML/section.hpp>
+#include <bygg/HTML/parallel.hpp>
 
 namespace bygg::HTML::Parser {
+    /**
+     * @brief The backends HTML can be parsed with
+     */
+    enum class Backend {
+        Default, /* The backend set with set_default_backend(), or the one chosen with BYGG_PARSER_BACKEND when bygg was built. */
+        Native, /* The built-in parser, which has no dependencies. It builds the same sections as libxml2 for well-formed input. */
+        Libxml2, /* libxml2's HTML parser. Only available if bygg was built with BYGG_USE_LIBXML2. */
+    };
+
     /**
      * @brief Options for the HTML parser
      */
@@ -18,13 +37,237 @@ namespace bygg::HTML::Parser {
         bool handle_inner_tags{true}; /* Handle tags inside text data. */
         bool assume_inner_tag_is_non_self_closing{false}; /* Assume inner tags are non-self-closing. */
         bool replace_newlines{true}; /* Replace newlines with a single space. Usually does more good than harm, but disable if you want to keep newlines. */
+        Backend backend{Backend::Default}; /* The backend to parse with. */
     };
 
     /**
-     * @brief Parse an HTML string into a list of tags
+     * @brief Check if a backend can be used
+     * @param backend The backend to check
+     * @return bool True if bygg was built with the backend, false otherwise
+     */
+    bool is_backend_available(Backend backend);
+    /**
+     * @brief Set the backend used when the options ask for Backend::Default
+     * @note This affects every parser constructed afterwards, in any thread.
+     * @param backend The backend to use, or Backend::Default for the one chosen when bygg was built
+     */
+    void set_default_backend(Backend backend);
+    /**
+     * @brief Get the backend used when the options ask for Backend::Default
+     * @return Backend The backend, never Backend::Default
+     */
+    Backend get_default_backend();
+
+    /**
+     * @brief Parse an HTML string into a section
+     * @note The section is built in a single pass over the input, in time linear in its size.
      * @param html The HTML string to parse
      * @param options The options for the parser
-     * @return TagList The list of tags
+     * @return Section The parsed document
      */
     Section parse_html_string(const string_type& html, const Options& options = {});
+    /**
+     * @brief Parse HTML from a stream, a chunk at a time
+     * @param stream The stream to read from until its end
+     * @param options The options for the parser
+     * @return Section The parsed document
+     */
+    Section parse_html_stream(std::istream& stream, const Options& options = {});
+    /**
+     * @brief Parse several HTML strings into sections, on several threads
+     * @note Each document is parsed on a single thread, as parse_html_string() would parse it. libxml2 contexts are kept per thread and reused from one document to the next. Only the threads and the executor of the parallel options are used.
+     * @param documents The HTML strings to parse
+     * @param options The options for the parser
+     * @param parallel The threads to parse on
+     * @return std::vector<Section> The parsed documents, in the order they were given
+     */
+    std::vector<Section> parse_many(const std::vector<string_type>& documents, const Options& options = {}, const ParallelOptions& parallel = {});
+    /**
+     * @brief Parse several HTML files into sections, on several threads
+     * @note Each file is read and parsed on a single thread, as parse_html_stream() would parse it. Only the threads and the executor of the parallel options are used.
+     * @param paths The paths of the files to parse
+     * @param options The options for the parser
+     * @param parallel The threads to parse on
+     * @return std::vector<Section> The parsed documents, in the order they were given
+     */
+    std::vector<Section> parse_many_files(const std::vector<string_type>& paths, const Options& options = {}, const ParallelOptions& parallel = {});
+
+    /**
+     * @brief An incremental HTML parser, for documents that arrive in pieces
+     * @note Input may be split anywhere, including inside tags and characters. Sections are built as the input is parsed, so apart from the tree being built, only the element currently being parsed is held, along with any elements inside it that end up in its data. The result is the same as that of parse_html_string() on the whole input, except that empty input produces an empty section instead of throwing.
+     */
+    class StreamParser {
+            struct State;
+            std::unique_ptr<State> state;
+        public:
+            /**
+             * @brief Construct a new StreamParser object
+             * @param options The options for the parser
+             */
+            explicit StreamParser(const Options& options = {});
+            /**
+             * @brief Construct a new StreamParser object
+             * @param parser The parser to move from
+             */
+            StreamParser(StreamParser&& parser) noexcept;
+            /**
+             * @brief Destroy the StreamParser object
+             */
+            ~StreamParser();
+
+            /**
+             * @brief Parse the next piece of the input
+             * @param data The input
+             * @param size The size of the input
+             */
+            void feed(const char* data, size_type size);
+            /**
+             * @brief Parse the next piece of the input
+             * @param data The input
+             */
+            void feed(const string_type& data);
+            /**
+             * @brief Parse the end of the input, closing any elements that are still open
+             * @note The parser can not be used after this.
+             * @return Section The parsed document
+             */
+            Section finish();
+
+            StreamParser& operator=(StreamParser&& parser) noexcept;
+    };
+    /**
+     * @brief A parsed document, kept as the elements and text the parser reported, without building sections.
+     * @note Nodes are stored in document order in a single array, and every tag, attribute and text is stored once in a single text buffer, so tags, attributes and text can be read as string views without allocating. The buffers are sized from the input up front, so parsing allocates a fixed number of blocks rather than a few per node.
+     * @note Text is stored once per text node, and only if it is not all whitespace. Text directly inside containers is kept, unlike in sections.
+     * @note to_section() builds the same section parse_html_string() would, when it is needed.
+     */
+    class ParsedDocument {
+        public:
+            /**
+             * @brief Type used to refer to a node in the document
+             */
+            using index_type = std::uint32_t;
+            /**
+             * @brief The npos value, used for the parent of top-level nodes
+             */
+            static constexpr index_type npos = static_cast<index_type>(-1);
+
+            /**
+             * @brief A range of bytes in the text buffer of the document
+             */
+            struct Span {
+                size_type offset{};
+                size_type size{};
+            };
+            /**
+             * @brief An attribute of an element, stored as two spans in the text buffer
+             */
+            struct Attribute {
+                Span key{};
+                Span value{};
+            };
+            /**
+             * @brief A single node in the document, either an element or text
+             */
+            struct Node {
+                index_type parent{npos};
+                index_type end{}; /* Index of the first node after the element and everything inside it */
+                index_type attribute_begin{};
+                index_type attribute_count{};
+                Span data{}; /* The tag of an element, or the text */
+                bool text{false};
+            };
+        private:
+            std::pmr::vector<Node> nodes;
+            std::pmr::vector<Attribute> attributes;
+            std::pmr::string text;
+
+            struct Recorder;
+        public:
+            /**
+             * @brief Construct a new ParsedDocument object by parsing HTML
+             * @param html The HTML to parse
+             * @param resource The memory resource to allocate from
+             * @param backend The backend to parse with
+             */
+            explicit ParsedDocument(std::string_view html, std::pmr::memory_resource* resource = std::pmr::get_default_resource(), Backend backend = Backend::Default);
+            /**
+             * @brief Construct a new ParsedDocument object
+             * @param document The document to copy
+             */
+            ParsedDocument(const ParsedDocument& document) = default;
+            /**
+             * @brief Construct a new ParsedDocument object
+             * @param document The document to move from
+             */
+            ParsedDocument(ParsedDocument&& document) noexcept = default;
+            /**
+             * @brief Destroy the ParsedDocument object
+             */
+            ~ParsedDocument() = default;
+
+            /**
+             * @brief Get a node
+             * @param index The index of the node
+             * @return const Node& The node
+             */
+            [[nodiscard]] const Node& at(index_type index) const;
+            /**
+             * @brief Get the tag of an element
+             * @param index The index of the node
+             * @return std::string_view The tag, or an empty string for text
+             */
+            [[nodiscard]] std::string_view get_tag(index_type index) const;
+            /**
+             * @brief Get the text of a text node
+             * @param index The index of the node
+             * @return std::string_view The text, or an empty string for an element
+             */
+            [[nodiscard]] std::string_view get_text(index_type index) const;
+            /**
+             * @brief Get an attribute of an element
+             * @param index The index of the node
+             * @param attribute The position of the attribute among those of the element
+             * @return std::pair<std::string_view, std::string_view> The key and value of the attribute
+             */
+            [[nodiscard]] std::pair<std::string_view, std::string_view> get_attribute(index_type index, size_type attribute) const;
+            /**
+             * @brief Find the value of an attribute of an element
+             * @param index The index of the node
+             * @param key The key of the attribute
+             * @return std::string_view The value, or an empty string if the element has no such attribute
+             */
+            [[nodiscard]] std::string_view find_attribute(index_type index, std::string_view key) const;
+            /**
+             * @brief Get the attributes of an element as properties
+             * @param index The index of the node
+             * @return Properties The properties
+             */
+            [[nodiscard]] Properties get_properties(index_type index) const;
+            /**
+             * @brief Get the number of nodes in the document
+             * @return size_type The number of nodes
+             */
+            [[nodiscard]] size_type size() const;
+            /**
+             * @brief Check if the document has no nodes
+             * @return bool True if the document is empty, false otherwise
+             */
+            [[nodiscard]] bool empty() const;
+            /**
+             * @brief Get the memory resource the document allocates from
+             * @return std::pmr::memory_resource* The memory resource
+             */
+            [[nodiscard]] std::pmr::memory_resource* get_resource() const;
+
+            /**
+             * @brief Build sections from the document
+             * @param options The options for the parser
+             * @return Section The parsed document, as parse_html_string() would return it
+             */
+            [[nodiscard]] Section to_section(const Options& options = {}) const;
+
+            ParsedDocument& operator=(const ParsedDocument& document);
+            ParsedDocument& operator=(ParsedDocument&& document);
+    };
 } // namespace bygg::HTML::Parser
\ No newline at end of file
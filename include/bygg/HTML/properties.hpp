@@ -7,6 +7,7 @@
 #pragma once
 
 #include <vector>
+#include <type_traits>
 #include <bygg/types.hpp>
 #include <bygg/HTML/property.hpp>
 
@@ -87,7 +88,7 @@ namespace bygg::HTML {
              * @brief Set the properties of the element
              * @param properties The properties to set
              */
-            void set(const std::vector<Property>& properties);
+            void set(std::vector<Property> properties);
             /**
              * @brief Get the property at an index
              * @param index The index of the property
@@ -106,6 +107,12 @@ namespace bygg::HTML {
              * @param property The property to insert
              */
             void insert(size_type index, const Property& property);
+            /**
+             * @brief Insert a property into the element
+             * @param index The index to insert the property
+             * @param property The property to insert
+             */
+            void insert(size_type index, Property&& property);
             /**
              * @brief Erase a property from the element
              * @param index The index of the property to erase
@@ -181,17 +188,36 @@ namespace bygg::HTML {
              * @param property The property to add
              */
             void push_front(const Property& property);
+            /**
+             * @brief Prepend a property to the element
+             * @param property The property to add
+             */
+            void push_front(Property&& property);
             /**
              * @brief Append a property to the element
              * @param property The property to add
              */
             void push_back(const Property& property);
-            template <typename... Args> explicit Properties(Args... args) { (this->push_back(args), ...); }
+            /**
+             * @brief Append a property to the element
+             * @param property The property to add
+             */
+            void push_back(Property&& property);
+            /**
+             * @brief Construct a property in place at the end of the element
+             * @param args The arguments to construct the property from
+             * @return Property& The new property
+             */
+            template <typename... Args> Property& emplace_back(Args&&... args) {
+                return this->properties.emplace_back(std::forward<Args>(args)...);
+            }
+            template <typename... Args, typename = std::enable_if_t<!(sizeof...(Args) == 1 && (std::is_same_v<std::decay_t<Args>, Properties> && ...))>>
+            explicit Properties(Args&&... args) { (this->push_back(std::forward<Args>(args)), ...); }
             /**
              * @brief Construct a new Properties object
              * @param properties The properties to set
              */
-            explicit Properties(const std::vector<Property>& properties) : properties(properties) {};
+            explicit Properties(std::vector<Property> properties) : properties(std::move(properties)) {};
             /**
              * @brief Construct a new Properties object
              * @param property The property to add
@@ -202,6 +228,11 @@ namespace bygg::HTML {
              * @param properties The properties to set
              */
             Properties(const Properties& properties) = default;
+            /**
+             * @brief Construct a new Properties object
+             * @param properties The properties to move from
+             */
+            Properties(Properties&& properties) noexcept = default;
             /**
              * @brief Construct a new Properties object
              */
@@ -211,6 +242,7 @@ namespace bygg::HTML {
              */
             ~Properties() = default;
             Properties& operator=(const Properties& properties);
+            Properties& operator=(Properties&& properties) noexcept;
             Properties& operator=(const std::vector<Property>& properties);
             Properties& operator=(const Property& property);
             bool operator==(const Properties& properties) const;
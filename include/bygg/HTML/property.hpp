@@ -8,15 +8,23 @@
 
 #include <string>
 #include <bygg/types.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/escaping_enum.hpp>
 
 namespace bygg::HTML {
     class Properties;
+    class Section;
 
     /**
      * @brief A class to represent an HTML property
      */
     class Property {
             std::pair<string_type, string_type> property{};
+
+            friend class Element;
+            friend class Section;
+            friend class Selector;
+            friend class Tree;
         public:
             /**
              * @brief The npos value
@@ -28,12 +36,17 @@ namespace bygg::HTML {
              * @param key The key of the property
              * @param value The value of the property
              */
-            Property(const string_type& key, const string_type& value) : property(std::make_pair(key, value)) {};
+            Property(string_type key, string_type value) : property(std::move(key), std::move(value)) {};
             /**
              * @brief Construct a new Property object
              * @param property The property to set
              */
             Property(const Property& property) = default;
+            /**
+             * @brief Construct a new Property object
+             * @param property The property to move from
+             */
+            Property(Property&& property) noexcept = default;
             /**
              * @brief Construct a new Property object
              */
@@ -76,37 +89,50 @@ namespace bygg::HTML {
             }
             /**
              * @brief Get the formatted property.
+             * @param escaping Whether to escape the value
              * @return string_type Formatted property.
              */
-            [[nodiscard]] string_type get() const;
+            [[nodiscard]] string_type get(Escaping escaping = Escaping::None) const;
             /**
              * @brief Get the formatted property in a specific type.
              * @return T The formatted property.
              */
-            template <typename T> T get() const {
-                return T(get());
+            template <typename T> T get(const Escaping escaping = Escaping::None) const {
+                return T(get(escaping));
             }
+            /**
+             * @brief Write the formatted property to a sink.
+             * @param sink The sink to write to.
+             * @param escaping Whether to escape the value. The key is always written as it is.
+             */
+            void write_to(Sink& sink, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Get the number of bytes write_to() would write.
+             * @param escaping Whether to escape the value
+             * @return size_type The size of the formatted property.
+             */
+            [[nodiscard]] size_type serialized_size(Escaping escaping = Escaping::None) const;
             /**
              * @brief Set the key of the property.
              * @param key The key.
              */
-            void set_key(const string_type& key);
+            void set_key(string_type key);
             /**
              * @brief Set the value of the property.
              * @param value The value.
              */
-            void set_value(const string_type& value);
+            void set_value(string_type value);
             /**
              * @brief Set the property
              * @param property The property.
              */
-            void set(const std::pair<string_type, string_type>& property);
+            void set(std::pair<string_type, string_type> property);
             /**
              * @brief Set the property
              * @param key The key of the property
              * @param value The value of the property
              */
-            void set(const string_type& key, const string_type& value);
+            void set(string_type key, string_type value);
             /**
              * @brief Clear the property
              */
@@ -118,6 +144,7 @@ namespace bygg::HTML {
             [[nodiscard]] bool empty() const;
 
             Property& operator=(const Property& property);
+            Property& operator=(Property&& property) noexcept;
             bool operator==(const Property& property) const;
             bool operator!=(const Property& property) const;
             operator Properties() const; // NOLINT
@@ -0,0 +1,91 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <stack>
+#include <string>
+#include <string_view>
+
+#include <bygg/types.hpp>
+#include <bygg/HTML/formatting_enum.hpp>
+#include <bygg/HTML/escaping_enum.hpp>
+#include <bygg/HTML/section.hpp>
+#include <bygg/HTML/document.hpp>
+
+namespace bygg::HTML {
+    /**
+     * @brief Serializes a section or document a chunk at a time, into buffers supplied by the caller.
+     * @note The output is identical to that of get() on the section or document. Rendering resumes where the previous chunk ended, so only the sections currently being rendered and the output of a single element are held at any time, however large the page is.
+     * @note A chunk ends early after the closing tag of a section marked with Section::set_flush_point(), so that the start of a page, such as its head, can be sent before the rest of it has been rendered.
+     * @note The section or document is not copied, and must outlive the renderer and remain unchanged while it is in use. Cached output is reused, but nothing is recorded into caches.
+     * @note A renderer cannot be copied or moved, as the chunk in progress may point into it.
+     */
+    class Renderer {
+        private:
+            /*
+             * A section being rendered. opened is set once its opening tag has been
+             * written, and index is the next member to render.
+             */
+            struct Entry {
+                const Section* section{nullptr};
+                integer_type tabc{};
+                size_type index{};
+                bool opened{false};
+            };
+
+            std::stack<Entry> s_stack{};
+            Formatting formatting{Formatting::None};
+            Escaping escaping{Escaping::None};
+
+            /* the piece being copied out, which points into buffer or into a cache */
+            string_type buffer{};
+            std::string_view data{};
+            size_type offset{};
+            /* a newline held back, as get() drops the last one, and whether it goes before data */
+            bool newline{false};
+            bool lead{false};
+            bool flush{false};
+
+            void step();
+        public:
+            /**
+             * @brief Construct a new Renderer object
+             * @param section The section to render
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             */
+            explicit Renderer(const Section& section, Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None);
+            /**
+             * @brief Construct a new Renderer object
+             * @param document The document to render, starting with its doctype
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             */
+            explicit Renderer(const Document& document, Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None);
+            Renderer(const Renderer&) = delete;
+            Renderer& operator=(const Renderer&) = delete;
+            /**
+             * @brief Destroy the Renderer object
+             */
+            ~Renderer() = default;
+
+            /**
+             * @brief Render the next chunk of output
+             * @param buffer The buffer to write to
+             * @param capacity The size of the buffer
+             * @return size_type The number of bytes written. Less than the capacity at a flush point or at the end of the output, and 0 once everything has been rendered.
+             */
+            [[nodiscard]] size_type next_chunk(char* buffer, size_type capacity);
+            /**
+             * @brief Check if everything has been rendered
+             * @return bool True if the output is complete, false otherwise
+             */
+            [[nodiscard]] bool done() const;
+    };
+} // namespace bygg::HTML
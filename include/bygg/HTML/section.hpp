@@ -6,16 +6,26 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 #include <variant>
+#include <unordered_map>
+#include <iterator>
+#include <type_traits>
 
 #include <bygg/types.hpp>
 #include <bygg/except.hpp>
 #include <bygg/HTML/find_enum.hpp>
+#include <bygg/HTML/escaping_enum.hpp>
 #include <bygg/HTML/tag.hpp>
 #include <bygg/HTML/properties.hpp>
 #include <bygg/HTML/element.hpp>
+#include <bygg/HTML/shared_section.hpp>
+#include <bygg/HTML/parallel.hpp>
 
 namespace bygg::HTML {
     class Section;
@@ -29,74 +39,157 @@ namespace bygg::HTML {
      */
     using ElementList = std::vector<Element>;
 
+    /**
+     * @brief Bidirectional iterator over the members of a Section that hold a specific type. Other members are skipped, and the iterator refers to the objects stored in the section, so no copies are made.
+     * @tparam T The type to iterate over, Element or Section
+     * @tparam Iterator The underlying iterator over the members of the section
+     */
+    template <typename T, typename Iterator> class FilterIterator {
+            template <typename, typename> friend class FilterIterator;
+
+            Iterator it{};
+            Iterator last{};
+
+            void skip() {
+                while (it != last && !std::holds_alternative<T>(*it)) {
+                    ++it;
+                }
+            }
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+            using reference = std::conditional_t<std::is_const_v<std::remove_reference_t<typename std::iterator_traits<Iterator>::reference>>, const T&, T&>;
+            using pointer = std::remove_reference_t<reference>*;
+
+            FilterIterator() = default;
+            /**
+             * @brief Construct a new FilterIterator object
+             * @param it The position to start at. The iterator is advanced to the first matching member.
+             * @param last The end of the members
+             */
+            FilterIterator(Iterator it, Iterator last) : it(it), last(last) {
+                skip();
+            }
+            /**
+             * @brief Convert a mutable iterator to a const iterator
+             * @param other The iterator to convert
+             */
+            template <typename Other, typename = std::enable_if_t<std::is_convertible_v<Other, Iterator> && !std::is_same_v<Other, Iterator>>>
+            FilterIterator(const FilterIterator<T, Other>& other) : it(other.it), last(other.last) {}
+
+            reference operator*() const { return std::get<T>(*it); }
+            pointer operator->() const { return &std::get<T>(*it); }
+
+            FilterIterator& operator++() {
+                ++it;
+                skip();
+                return *this;
+            }
+            FilterIterator operator++(int) {
+                FilterIterator ret{*this};
+                ++*this;
+                return ret;
+            }
+            FilterIterator& operator--() {
+                do {
+                    --it;
+                } while (!std::holds_alternative<T>(*it));
+                return *this;
+            }
+            FilterIterator operator--(int) {
+                FilterIterator ret{*this};
+                --*this;
+                return ret;
+            }
+
+            /**
+             * @brief Get the underlying iterator over the members of the section
+             * @return Iterator The underlying iterator
+             */
+            [[nodiscard]] Iterator base() const { return it; }
+
+            bool operator==(const FilterIterator& other) const { return it == other.it; }
+            bool operator!=(const FilterIterator& other) const { return it != other.it; }
+    };
+
     /**
      * @brief A class to represent an HTML section (head, body, etc.)
      */
     class Section {
         public:
             /**
-             * @brief Iterator for elements.
+             * @brief Variant type holding an Element, a Section or a SharedSection.
              */
-            using element_iterator = ElementList::iterator;
+            using variant_t = std::variant<Element, Section, SharedSection>;
             /**
-             * @brief Const iterator for elements.
+             * @brief List of variants. May be used to iterate over multiple types.
              */
-            using element_const_iterator = ElementList::const_iterator;
+            using variant_list = std::vector<variant_t>;
             /**
-             * @brief Reverse iterator for elements.
+             * @brief Iterator for variants.
              */
-            using element_reverse_iterator = ElementList::reverse_iterator;
+            using iterator = variant_list::iterator;
             /**
-             * @brief Const reverse iterator for elements.
+             * @brief Const iterator for variants.
              */
-            using element_const_reverse_iterator = ElementList::const_reverse_iterator;
+            using const_iterator = variant_list::const_iterator;
             /**
-             * @brief Iterator for sections.
+             * @brief Reverse iterator for variants.
              */
-            using section_iterator = SectionList::iterator;
+            using reverse_iterator = variant_list::reverse_iterator;
             /**
-             * @brief Const iterator for sections.
+             * @brief Const reverse iterator for variants.
              */
-            using section_const_iterator = SectionList::const_iterator;
+            using const_reverse_iterator = variant_list::const_reverse_iterator;
             /**
-             * @brief Reverse iterator for sections.
+             * @brief Iterator for elements.
              */
-            using section_reverse_iterator = SectionList::reverse_iterator;
+            using element_iterator = FilterIterator<Element, iterator>;
             /**
-             * @brief Const reverse iterator for sections.
+             * @brief Const iterator for elements.
              */
-            using section_const_reverse_iterator = SectionList::const_reverse_iterator;
+            using element_const_iterator = FilterIterator<Element, const_iterator>;
             /**
-             * @brief Variant type holding either an Element or a Section.
+             * @brief Reverse iterator for elements.
              */
-            using variant_t = std::variant<Element, Section>;
+            using element_reverse_iterator = std::reverse_iterator<element_iterator>;
             /**
-             * @brief List of variants. May be used to iterate over multiple types.
+             * @brief Const reverse iterator for elements.
              */
-            using variant_list = std::vector<variant_t>;
+            using element_const_reverse_iterator = std::reverse_iterator<element_const_iterator>;
             /**
-             * @brief Iterator for variants.
+             * @brief Iterator for sections.
              */
-            using iterator = variant_list::iterator;
+            using section_iterator = FilterIterator<Section, iterator>;
             /**
-             * @brief Const iterator for variants.
+             * @brief Const iterator for sections.
              */
-            using const_iterator = variant_list::const_iterator;
+            using section_const_iterator = FilterIterator<Section, const_iterator>;
             /**
-             * @brief Reverse iterator for variants.
+             * @brief Reverse iterator for sections.
              */
-            using reverse_iterator = variant_list::reverse_iterator;
+            using section_reverse_iterator = std::reverse_iterator<section_iterator>;
             /**
-             * @brief Const reverse iterator for variants.
+             * @brief Const reverse iterator for sections.
              */
-            using const_reverse_iterator = variant_list::const_reverse_iterator;
+            using section_const_reverse_iterator = std::reverse_iterator<section_const_iterator>;
 
             /**
              * @brief Return a variant_list of all elements and sections.
              * @note To use the result, you must use std::visit.
              * @example std::visit([](auto&& arg) { if constexpr (std::is_same_v<decltype(arg), Element>) {}}, section.get_all());
              */
-            [[nodiscard]] variant_list& get_all() const {
+            [[nodiscard]] variant_list& get_all() {
+                this->invalidate_cache();
+                return members;
+            }
+            /**
+             * @brief Return a variant_list of all elements and sections.
+             * @note To use the result, you must use std::visit.
+             * @return const variant_list& The members, which can not be changed through a const section
+             */
+            [[nodiscard]] const variant_list& get_all() const {
                 return members;
             }
             /**
@@ -105,6 +198,8 @@ namespace bygg::HTML {
              * @return variant_t The variant_t at the index.
              */
             [[nodiscard]] variant_t& get_any(size_type index) {
+                this->invalidate_cache();
+
                 for (size_type i{}; i < members.size(); ++i) {
                     if (i == index) {
                         return members.at(i);
@@ -118,266 +213,102 @@ namespace bygg::HTML {
              * @brief Return an iterator to the beginning.
              * @return element_iterator The iterator to the beginning.
              */
-            element_iterator element_begin() {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-                return element_iterator(elements.begin());
-            }
+            element_iterator element_begin() { return element_iterator(members.begin(), members.end()); }
             /**
              * @brief Return an iterator to the end.
              * @return element_iterator The iterator to the end.
              */
-            element_iterator element_end() {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-                return element_iterator(elements.end());
-            }
+            element_iterator element_end() { return element_iterator(members.end(), members.end()); }
             /**
              * @brief Return an iterator to the beginning.
              * @return element_const_iterator The iterator to the beginning.
              */
-            [[nodiscard]] element_const_iterator element_begin() const {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-                return element_const_iterator(elements.cbegin());
-            }
+            [[nodiscard]] element_const_iterator element_begin() const { return element_cbegin(); }
             /**
              * @brief Return an iterator to the end.
              * @return element_const_iterator The iterator to the end.
              */
-            [[nodiscard]] element_const_iterator element_end() const {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-                return element_const_iterator(elements.cend());
-            }
+            [[nodiscard]] element_const_iterator element_end() const { return element_cend(); }
             /**
              * @brief Return a const iterator to the beginning.
              * @return element_const_iterator The const iterator to the beginning.
              */
-            [[nodiscard]] element_const_iterator element_cbegin() const {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-                return element_const_iterator(elements.cbegin());
-            }
+            [[nodiscard]] element_const_iterator element_cbegin() const { return element_const_iterator(members.cbegin(), members.cend()); }
             /**
              * @brief Return a const iterator to the end.
              * @return element_const_iterator The const iterator to the end.
              */
-            [[nodiscard]] element_const_iterator element_cend() const {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-                return element_const_iterator(elements.cend());
-            }
+            [[nodiscard]] element_const_iterator element_cend() const { return element_const_iterator(members.cend(), members.cend()); }
             /**
              * @brief Return a reverse iterator to the beginning.
              * @return element_reverse_iterator The reverse iterator to the beginning.
              */
-            [[nodiscard]] element_reverse_iterator element_rbegin() {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-
-                return element_reverse_iterator(elements.rbegin());
-            }
+            [[nodiscard]] element_reverse_iterator element_rbegin() { return element_reverse_iterator(element_end()); }
             /**
              * @brief Return a reverse iterator to the end.
              * @return element_reverse_iterator The reverse iterator to the end.
              */
-            [[nodiscard]] element_reverse_iterator element_rend() {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-
-                return element_reverse_iterator(elements.rbegin());
-            }
+            [[nodiscard]] element_reverse_iterator element_rend() { return element_reverse_iterator(element_begin()); }
             /**
              * @brief Return a const reverse iterator to the beginning.
              * @return element_const_reverse_iterator The const reverse iterator to the beginning.
              */
-            [[nodiscard]] element_const_reverse_iterator element_crbegin() const {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-
-                return element_const_reverse_iterator(elements.crbegin());
-            }
+            [[nodiscard]] element_const_reverse_iterator element_crbegin() const { return element_const_reverse_iterator(element_cend()); }
             /**
              * @brief Return a const reverse iterator to the end.
              * @return element_const_reverse_iterator The const reverse iterator to the end.
              */
-            [[nodiscard]] element_const_reverse_iterator element_crend() const {
-                elements.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Element>(it)) {
-                        elements.push_back(std::get<Element>(it));
-                    }
-                }
-
-                return element_const_reverse_iterator(elements.crend());
-            }
+            [[nodiscard]] element_const_reverse_iterator element_crend() const { return element_const_reverse_iterator(element_cbegin()); }
             /**
              * @brief Return an iterator to the beginning.
              * @return section_iterator The iterator to the beginning.
              */
-            section_iterator section_begin() {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return section_iterator(sections.begin());
-            }
+            section_iterator section_begin() { return section_iterator(members.begin(), members.end()); }
             /**
              * @brief Return an iterator to the end.
              * @return section_iterator The iterator to the end.
              */
-            section_iterator section_end() {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return section_iterator(sections.end());
-            }
+            section_iterator section_end() { return section_iterator(members.end(), members.end()); }
             /**
              * @brief Return an iterator to the beginning.
              * @return section_const_iterator The iterator to the beginning.
              */
-            [[nodiscard]] section_const_iterator section_begin() const {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return {sections.begin()};
-            }
+            [[nodiscard]] section_const_iterator section_begin() const { return section_cbegin(); }
             /**
              * @brief Return an iterator to the end.
              * @return section_const_iterator The iterator to the end.
              */
-            [[nodiscard]] section_const_iterator section_end() const {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return {sections.end()};
-            }
+            [[nodiscard]] section_const_iterator section_end() const { return section_cend(); }
             /**
              * @brief Return a const iterator to the beginning.
              * @return section_const_iterator The const iterator to the beginning.
              */
-            [[nodiscard]] section_const_iterator section_cbegin() const {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return section_const_iterator(sections.cbegin());
-            }
+            [[nodiscard]] section_const_iterator section_cbegin() const { return section_const_iterator(members.cbegin(), members.cend()); }
             /**
              * @brief Return a const iterator to the end.
              * @return section_const_iterator The const iterator to the end.
              */
-            [[nodiscard]] section_const_iterator section_cend() const {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return section_const_iterator(sections.cend());
-            }
+            [[nodiscard]] section_const_iterator section_cend() const { return section_const_iterator(members.cend(), members.cend()); }
             /**
              * @brief Return a reverse iterator to the beginning.
              * @return section_reverse_iterator The reverse iterator to the beginning.
              */
-            [[nodiscard]] section_reverse_iterator section_rbegin() {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return section_reverse_iterator(sections.rbegin());
-            }
+            [[nodiscard]] section_reverse_iterator section_rbegin() { return section_reverse_iterator(section_end()); }
             /**
              * @brief Return a reverse iterator to the end.
              * @return section_reverse_iterator The reverse iterator to the end.
              */
-            [[nodiscard]] section_reverse_iterator section_rend() {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return section_reverse_iterator(sections.rend());
-            }
+            [[nodiscard]] section_reverse_iterator section_rend() { return section_reverse_iterator(section_begin()); }
             /**
              * @brief Return a const reverse iterator to the beginning.
              * @return section_const_reverse_iterator The const reverse iterator to the beginning.
              */
-            [[nodiscard]] section_const_reverse_iterator section_crbegin() const {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return section_const_reverse_iterator(sections.crbegin());
-            }
+            [[nodiscard]] section_const_reverse_iterator section_crbegin() const { return section_const_reverse_iterator(section_cend()); }
             /**
              * @brief Return a const reverse iterator to the end.
              * @return section_const_reverse_iterator The const reverse iterator to the end.
              */
-            [[nodiscard]] section_const_reverse_iterator section_crend() const {
-                sections.clear();
-                for (const auto& it : members) {
-                    if (std::holds_alternative<Section>(it)) {
-                        sections.push_back(std::get<Section>(it));
-                    }
-                }
-                return section_const_reverse_iterator(sections.crend());
-            }
+            [[nodiscard]] section_const_reverse_iterator section_crend() const { return section_const_reverse_iterator(section_cbegin()); }
             /**
              * @brief Return an iterator to the beginning.
              * @return iterator The iterator to the beginning.
@@ -392,22 +323,22 @@ namespace bygg::HTML {
              * @brief Return an iterator to the beginning.
              * @return const_iterator The iterator to the beginning.
              */
-            [[nodiscard]] const_iterator begin() const { return get_all().cbegin(); }
+            [[nodiscard]] const_iterator begin() const { return members.cbegin(); }
             /**
              * @brief Return an iterator to the end.
              * @return const_iterator The iterator to the end.
              */
-            [[nodiscard]] const_iterator end() const { return get_all().cend(); }
+            [[nodiscard]] const_iterator end() const { return members.cend(); }
             /**
              * @brief Return a const iterator to the beginning.
              * @return const_iterator The const iterator to the beginning.
              */
-            [[nodiscard]] const_iterator cbegin() const { return get_all().cbegin(); }
+            [[nodiscard]] const_iterator cbegin() const { return members.cbegin(); }
             /**
              * @brief Return a const iterator to the end.
              * @return const_iterator The const iterator to the end.
              */
-            [[nodiscard]] const_iterator cend() const { return get_all().cend(); }
+            [[nodiscard]] const_iterator cend() const { return members.cend(); }
             /**
              * @brief Return a reverse iterator to the beginning.
              * @return reverse_iterator The reverse iterator to the beginning.
@@ -422,12 +353,12 @@ namespace bygg::HTML {
              * @brief Return a const reverse iterator to the beginning.
              * @return const_reverse_iterator The const reverse iterator to the beginning.
              */
-            [[nodiscard]] const_reverse_iterator crbegin() const { return get_all().crbegin(); }
+            [[nodiscard]] const_reverse_iterator crbegin() const { return members.crbegin(); }
             /**
              * @brief Return a const reverse iterator to the end.
              * @return const_reverse_iterator The const reverse iterator to the end.
              */
-            [[nodiscard]] const_reverse_iterator crend() const { return get_all().crend(); }
+            [[nodiscard]] const_reverse_iterator crend() const { return members.crend(); }
 
             /**
              * @brief The npos value
@@ -439,21 +370,63 @@ namespace bygg::HTML {
              * @param element The element to add
              */
             void push_front(const Element& element);
+            /**
+             * @brief Prepend an element to the section
+             * @param element The element to add
+             */
+            void push_front(Element&& element);
             /**
              * @brief Prepend a section to the section
              * @param section The section to add
              */
             void push_front(const Section& section);
+            /**
+             * @brief Prepend a section to the section
+             * @param section The section to add
+             */
+            void push_front(Section&& section);
+            /**
+             * @brief Prepend a shared section to the section. Only the handle is copied.
+             * @param section The shared section to add
+             */
+            void push_front(const SharedSection& section);
             /**
              * @brief Append an element to the section
              * @param element The element to add
              */
             void push_back(const Element& element);
+            /**
+             * @brief Append an element to the section
+             * @param element The element to add
+             */
+            void push_back(Element&& element);
             /**
              * @brief Append a section to the section
              * @param section The section to add
              */
             void push_back(const Section& section);
+            /**
+             * @brief Append a section to the section
+             * @param section The section to add
+             */
+            void push_back(Section&& section);
+            /**
+             * @brief Append a shared section to the section. Only the handle is copied.
+             * @param section The shared section to add
+             */
+            void push_back(const SharedSection& section);
+            /**
+             * @brief Construct an element or section in place at the end of the section
+             * @tparam T The type to construct, Element, Section or SharedSection
+             * @param args The arguments to construct it from
+             * @return T& The new element or section
+             */
+            template <typename T, typename... Args> T& emplace_back(Args&&... args) {
+                const variant_t* previous{members.data()};
+                T& ret{std::get<T>(members.emplace_back(std::in_place_type<T>, std::forward<Args>(args)...))};
+                this->adopt(previous, members.size() - 1);
+                return ret;
+            }
             /**
              * @brief Append a property list to the section
              * @param properties The properties of the element
@@ -469,11 +442,21 @@ namespace bygg::HTML {
              * @param elements The elements to add
              */
             void push_back(const ElementList& elements);
+            /**
+             * @brief Append an element list to the section
+             * @param elements The elements to add
+             */
+            void push_back(ElementList&& elements);
             /**
              * @brief Append a section list to the section
              * @param sections The sections to add
              */
             void push_back(const SectionList& sections);
+            /**
+             * @brief Append a section list to the section
+             * @param sections The sections to add
+             */
+            void push_back(SectionList&& sections);
             /**
              * @brief Get the element at an index. To get a section, use at_section()
              * @param index The index of the element
@@ -514,6 +497,73 @@ namespace bygg::HTML {
              * @param element The element to erase
              */
             void erase(const Element& element);
+            /**
+             * @brief Erase a range of members from the section
+             * @param first The first member to erase
+             * @param last The member after the last one to erase
+             * @return iterator The member following the erased ones
+             */
+            iterator erase(const_iterator first, const_iterator last);
+            /**
+             * @brief Erase all members for which a predicate returns true, keeping the order of the rest.
+             * @note The members are compacted in a single pass, without copying any of them.
+             * @param predicate Function called once with each member, as a const variant_t&
+             * @return size_type The number of members erased
+             */
+            template <typename Predicate> size_type remove_if(Predicate predicate) {
+                const auto it{std::remove_if(members.begin(), members.end(), [&predicate](const variant_t& member) {
+                    return static_cast<bool>(predicate(member));
+                })};
+                const auto ret{static_cast<size_type>(members.end() - it)};
+
+                if (ret != 0) {
+                    members.erase(it, members.end());
+                    this->adopt(nullptr, 0);
+                }
+
+                return ret;
+            }
+            /**
+             * @brief Erase all members for which a predicate returns false, keeping the order of the rest.
+             * @param predicate Function called once with each member, as a const variant_t&
+             * @return size_type The number of members erased
+             */
+            template <typename Predicate> size_type retain(Predicate predicate) {
+                return this->remove_if(std::not_fn(std::ref(predicate)));
+            }
+            /**
+             * @brief Erase all members anywhere in the section for which a predicate returns true, keeping the order of the rest.
+             * @note Each section is compacted before its remaining subsections are visited, so the members of erased sections are not passed to the predicate.
+             * @param predicate Function called once with each member, as a const variant_t&
+             * @return size_type The number of members erased, not counting the members of erased sections
+             */
+            template <typename Predicate> size_type remove_if_recursive(Predicate predicate) {
+                size_type ret{0};
+                std::vector<Section*> stack{this};
+
+                while (!stack.empty()) {
+                    Section* section{stack.back()};
+                    stack.pop_back();
+
+                    ret += section->remove_if(std::ref(predicate));
+
+                    for (variant_t& it : section->members) {
+                        if (auto* child = std::get_if<Section>(&it)) {
+                            stack.push_back(child);
+                        }
+                    }
+                }
+
+                return ret;
+            }
+            /**
+             * @brief Erase all members anywhere in the section for which a predicate returns false, keeping the order of the rest.
+             * @param predicate Function called once with each member, as a const variant_t&
+             * @return size_type The number of members erased, not counting the members of erased sections
+             */
+            template <typename Predicate> size_type retain_recursive(Predicate predicate) {
+                return this->remove_if_recursive(std::not_fn(std::ref(predicate)));
+            }
             /**
              * @brief Find an element in the section
              * @param element The element to find
@@ -568,12 +618,30 @@ namespace bygg::HTML {
              * @param element The element to insert
              */
             void insert(size_type index, const Element& element);
+            /**
+             * @brief Insert an element into the section
+             * @param index The index to insert the element
+             * @param element The element to insert
+             */
+            void insert(size_type index, Element&& element);
             /**
              * @brief Insert a section into the section
              * @param index The index to insert the section
              * @param section The section to insert
              */
             void insert(size_type index, const Section& section);
+            /**
+             * @brief Insert a section into the section
+             * @param index The index to insert the section
+             * @param section The section to insert
+             */
+            void insert(size_type index, Section&& section);
+            /**
+             * @brief Insert a shared section into the section. Only the handle is copied.
+             * @param index The index to insert the shared section
+             * @param section The shared section to insert
+             */
+            void insert(size_type index, const SharedSection& section);
             /**
              * @brief Get the first element of the section
              * @return Element The first element of the section
@@ -633,13 +701,13 @@ namespace bygg::HTML {
              * @param tag The tag of the section
              * @param properties The properties of the section
              */
-            explicit Section(string_type tag, const Properties& properties = {}) : tag(std::move(tag)), properties(properties) {};
+            explicit Section(string_type tag, Properties properties = {}) : tag(std::move(tag)), properties(std::move(properties)) {};
             /**
              * @brief Construct a new Section object
              * @param tag The tag of the section
              * @param properties The properties of the section
              */
-            explicit Section(const Tag tag, const Properties& properties = {}) : tag(resolve_tag(tag).first), properties(properties) {};
+            explicit Section(const Tag tag, Properties properties = {}) : tag(get_tag_info(tag).name), properties(std::move(properties)) {};
             /**
              * @brief Construct a new Section object
              * @param tag The tag of the section
@@ -655,7 +723,7 @@ namespace bygg::HTML {
              * @param properties The properties of the section
              * @param elements The elements of the section
              */
-            Section(const Tag tag, const Properties& properties, const ElementList& elements) : tag(resolve_tag(tag).first), properties(properties) {
+            Section(const Tag tag, const Properties& properties, const ElementList& elements) : tag(get_tag_info(tag).name), properties(properties) {
                 for (const auto& element : elements) this->push_back(element);
             };
             /**
@@ -664,7 +732,7 @@ namespace bygg::HTML {
              * @param args The elements and/or sections of the section
              */
             template <typename... Args>
-            explicit Section(const Tag tag, Args&&... args) : tag(resolve_tag(tag).first) {
+            explicit Section(const Tag tag, Args&&... args) : tag(get_tag_info(tag).name) {
                 (this->push_back(std::forward<Args>(args)), ...);
             }
             /**
@@ -674,7 +742,7 @@ namespace bygg::HTML {
              * @param args The elements and/or sections of the section
              */
             template <typename... Args>
-            Section(const Tag tag, const Properties& properties, Args&&... args) : tag(resolve_tag(tag).first), properties(properties) {
+            Section(const Tag tag, Properties properties, Args&&... args) : tag(get_tag_info(tag).name), properties(std::move(properties)) {
                 (this->push_back(std::forward<Args>(args)), ...);
             }
             /**
@@ -693,7 +761,7 @@ namespace bygg::HTML {
              * @param args The elements and/or sections of the section
              */
             template <typename... Args>
-            Section(string_type tag, const Properties& properties, Args&&... args) : tag(std::move(tag)), properties(properties) {
+            Section(string_type tag, Properties properties, Args&&... args) : tag(std::move(tag)), properties(std::move(properties)) {
                 (this->push_back(std::forward<Args>(args)), ...);
             }
             /**
@@ -711,7 +779,7 @@ namespace bygg::HTML {
              * @param properties The properties of the section
              * @param sections The sections of the section
              */
-            Section(const Tag tag, const Properties& properties, const SectionList& sections) : tag(resolve_tag(tag).first), properties(properties) {
+            Section(const Tag tag, const Properties& properties, const SectionList& sections) : tag(get_tag_info(tag).name), properties(properties) {
                 for (const auto& section : sections) this->push_back(section);
             };
             /**
@@ -727,7 +795,7 @@ namespace bygg::HTML {
              * @param tag The tag of the section
              * @param elements The elements of the section
              */
-            Section(const Tag tag, const ElementList& elements) : tag(resolve_tag(tag).first) {
+            Section(const Tag tag, const ElementList& elements) : tag(get_tag_info(tag).name) {
              for (const auto& element : elements) this->push_back(element);
             };
             /**
@@ -743,17 +811,22 @@ namespace bygg::HTML {
              * @param tag The tag of the section
              * @param sections The sections of the section
              */
-            Section(const Tag tag, const SectionList& sections) : tag(resolve_tag(tag).first) {
+            Section(const Tag tag, const SectionList& sections) : tag(get_tag_info(tag).name) {
              for (const auto& section : sections) this->push_back(section);
             };
             /**
              * @brief Construct a new Section object
              * @param section The section to set
              */
-            Section(const Section& section) {
-                this->tag = section.tag;
-                this->properties = section.properties;
-                this->members = section.members;
+            Section(const Section& section) : tag(section.tag), properties(section.properties), members(section.members), cache_enabled(section.cache_enabled), index_enabled(section.index_enabled), flush_point(section.flush_point) {
+                this->link(0);
+            }
+            /**
+             * @brief Construct a new Section object
+             * @param section The section to move from
+             */
+            Section(Section&& section) noexcept : tag(std::move(section.tag)), properties(std::move(section.properties)), members(std::move(section.members)), cache(std::move(section.cache)), cache_enabled(section.cache_enabled), index_enabled(section.index_enabled), flush_point(section.flush_point), dirty(section.dirty), hash(section.hash), hashed(section.hashed) {
+                this->link(0);
             }
             /**
              * @brief Construct a new Section object
@@ -768,18 +841,18 @@ namespace bygg::HTML {
              * @param tag The tag to assign to the section
              * @param properties The properties to assign to the section tag
              */
-            void set(const string_type& tag, const Properties& properties);
+            void set(string_type tag, Properties properties);
             /**
              * @brief Set the tag, id, and classes of the section
              * @param tag The tag of the section
              * @param properties The properties to assign the tag
              */
-            void set(Tag tag, const Properties& properties);
+            void set(Tag tag, Properties properties);
             /**
              * @brief Set the tag of the section
              * @param tag The tag of the section
              */
-            void set_tag(const string_type& tag);
+            void set_tag(string_type tag);
             /**
              * @brief Set the tag of the section
              * @param tag The tag of the section
@@ -789,7 +862,7 @@ namespace bygg::HTML {
              * @brief Set the properties of the section
              * @param properties The properties of the section
              */
-            void set_properties(const Properties& properties);
+            void set_properties(Properties properties);
             /**
              * @brief Swap two elements in the section
              * @param index1 The index of the first element
@@ -823,17 +896,156 @@ namespace bygg::HTML {
              * @brief Dump the entire section.
              * @return string_type The section
              */
-            [[nodiscard]] string_type get(Formatting formatting = Formatting::None, integer_type tabc = 0) const;
+            [[nodiscard]] string_type get(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
             /**
              * @brief Get the element in the form of a specific type.
              * @return T The element in the form of a specific type
              */
-            template <typename T> [[nodiscard]] T get(const Formatting formatting = Formatting::None, const integer_type tabc = 0) const {
+            template <typename T> [[nodiscard]] T get(const Formatting formatting = Formatting::None, const integer_type tabc = 0, const Escaping escaping = Escaping::None) const {
                 if (std::is_same_v<T, string_type>) {
-                    return this->get(formatting, tabc);
+                    return this->get(formatting, tabc, escaping);
                 }
-                return T(this->get(formatting, tabc));
+                return T(this->get(formatting, tabc, escaping));
             }
+            /**
+             * @brief Write the entire section to a sink, producing the same output as get() without building intermediate strings.
+             * @param sink The sink to write to
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             */
+            void write_to(Sink& sink, Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Dump the entire section, serializing large sections on several threads.
+             * @note The output is identical to that of get(formatting, tabc). The section must not be changed until the call returns.
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param options The threads or executor to use, and which sections to split
+             * @param escaping Whether to escape attribute values and element data
+             * @return string_type The section
+             */
+            [[nodiscard]] string_type get(Formatting formatting, integer_type tabc, const ParallelOptions& options, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Write the entire section to a sink, serializing large sections on several threads.
+             * @note Chunks are serialized into separate buffers, and written to the sink in order from the calling thread. The sink does not need to be thread safe.
+             * @param sink The sink to write to
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param options The threads or executor to use, and which sections to split
+             * @param escaping Whether to escape attribute values and element data
+             */
+            void write_to(Sink& sink, Formatting formatting, integer_type tabc, const ParallelOptions& options, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Compute the exact number of bytes get() would return for the section, without producing the output.
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             * @return size_type The size of the serialized output
+             */
+            [[nodiscard]] size_type serialized_size(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Enable or disable caching of the serialized section.
+             * @note A section with caching enabled keeps its output for each formatting and indentation it has been serialized with, and reuses it until the section or anything inside it is changed. Changes made through the API of the section, its elements and its subsections invalidate the cache of the section and of every section containing it.
+             * @note Changes made through references to the underlying members (get_all(), iterators over variant_t) after the section has been serialized again are not tracked. Call invalidate_cache() after such changes.
+             * @note Serializing a section with caching enabled fills its caches, which changes the section even through a const reference. Such a section must not be serialized from several threads at once, unless prepare_cache() has been called for each formatting, indentation and escaping it is serialized with, and it has not been changed since. Shared sections are never cached, and can always be serialized from several threads.
+             * @param enable Whether to cache the section
+             */
+            void enable_cache(bool enable = true);
+            /**
+             * @brief Fill the caches of the section and of the sections inside it, without producing any output
+             * @note Afterwards, serializing the section with the same formatting, indentation and escaping only reads the caches, so it can be done from several threads at once, as long as the section is not changed.
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             */
+            void prepare_cache(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None);
+            /**
+             * @brief Check if caching of the serialized section is enabled
+             * @return bool True if the section caches its output, false otherwise
+             */
+            [[nodiscard]] bool is_cache_enabled() const;
+            /**
+             * @brief Discard the cached output of the section and of every section containing it
+             */
+            void invalidate_cache() const noexcept;
+            /**
+             * @brief Enable or disable the lookup index of the section.
+             * @note The index maps ids, classes and tags to the elements and sections anywhere below the section, not including the section itself. Shared sections, and everything inside them, are not indexed. It is built on the first lookup, and built again on the first lookup after the section or anything inside it has been changed through its API. Without the index, every lookup walks the whole section.
+             * @note The pointers returned by lookups are invalidated by any change to the section. Changes made through references to the underlying members are not tracked; call invalidate_cache() after such changes.
+             * @note A lookup on an indexed section may rebuild the index, so lookups on the same section, even through const references, must not be made from several threads at once unless the index is up to date.
+             * @param enable Whether to index the section
+             */
+            void enable_index(bool enable = true);
+            /**
+             * @brief Check if the lookup index of the section is enabled
+             * @return bool True if the section is indexed, false otherwise
+             */
+            [[nodiscard]] bool is_index_enabled() const;
+            /**
+             * @brief Mark the section as a flush point, where a Renderer ends its chunk after the closing tag of the section
+             * @param flush Whether the section is a flush point
+             */
+            void set_flush_point(bool flush = true);
+            /**
+             * @brief Check if the section is a flush point
+             * @return bool True if the section is a flush point, false otherwise
+             */
+            [[nodiscard]] bool is_flush_point() const;
+            /**
+             * @brief Get the first element or section below the section with a specific id, in document order.
+             * @param id The value of the id property to look for
+             * @return variant_t* The member, or nullptr if there is none
+             */
+            [[nodiscard]] variant_t* get_by_id(const string_type& id);
+            /**
+             * @brief Get the first element or section below the section with a specific id, in document order.
+             * @param id The value of the id property to look for
+             * @return const variant_t* The member, or nullptr if there is none
+             */
+            [[nodiscard]] const variant_t* get_by_id(const string_type& id) const;
+            /**
+             * @brief Get all elements and sections below the section with a specific class, in document order.
+             * @param name The class to look for. Matches any of the whitespace separated classes in the class property.
+             * @return std::vector<variant_t*> The members
+             */
+            [[nodiscard]] std::vector<variant_t*> get_by_class(const string_type& name);
+            /**
+             * @brief Get all elements and sections below the section with a specific class, in document order.
+             * @param name The class to look for. Matches any of the whitespace separated classes in the class property.
+             * @return std::vector<const variant_t*> The members
+             */
+            [[nodiscard]] std::vector<const variant_t*> get_by_class(const string_type& name) const;
+            /**
+             * @brief Get all elements and sections below the section with a specific tag, in document order.
+             * @param tag The tag to look for
+             * @return std::vector<variant_t*> The members
+             */
+            [[nodiscard]] std::vector<variant_t*> get_by_tag(const string_type& tag);
+            /**
+             * @brief Get all elements and sections below the section with a specific tag, in document order.
+             * @param tag The tag to look for
+             * @return std::vector<const variant_t*> The members
+             */
+            [[nodiscard]] std::vector<const variant_t*> get_by_tag(const string_type& tag) const;
+            /**
+             * @brief Get all elements and sections below the section with a specific tag, in document order.
+             * @param tag The tag to look for
+             * @return std::vector<variant_t*> The members
+             */
+            [[nodiscard]] std::vector<variant_t*> get_by_tag(Tag tag);
+            /**
+             * @brief Get all elements and sections below the section with a specific tag, in document order.
+             * @param tag The tag to look for
+             * @return std::vector<const variant_t*> The members
+             */
+            [[nodiscard]] std::vector<const variant_t*> get_by_tag(Tag tag) const;
+            /**
+             * @brief Get a hash of the tag, properties and members of the section. Sections that compare equal have equal hashes.
+             * @note The hash of every section below the section is kept until it, or anything inside it, is changed through its API. Hashing the section again only visits the sections that changed. Changes made through references to the underlying members (get_all(), iterators over variant_t) after the section has been hashed are not tracked; call invalidate_cache() after such changes. Comparing sections with operator== does not use the hash.
+             * @note Like serializing with caching enabled, hashing updates state kept in the sections, so the same section must not be hashed or compared from several threads at once. Shared sections are hashed when they are created and modified, and are safe to share between threads.
+             * @return std::uint64_t The hash
+             */
+            [[nodiscard]] std::uint64_t get_hash() const;
 
             /**
              * @brief Get the tag of the section
@@ -857,8 +1069,12 @@ namespace bygg::HTML {
             [[nodiscard]] Properties get_properties() const;
 
             Section& operator=(const Section& section);
+            Section& operator=(Section&& section) noexcept;
             Section& operator+=(const Element& element);
+            Section& operator+=(Element&& element);
             Section& operator+=(const Section& section);
+            Section& operator+=(Section&& section);
+            Section& operator+=(const SharedSection& section);
             bool operator==(const Element& element) const;
             bool operator==(const Section& section) const;
             bool operator!=(const Element& element) const;
@@ -870,8 +1086,65 @@ namespace bygg::HTML {
             Properties properties{};
 
             mutable variant_list members{};
-            mutable ElementList elements{};
-            mutable SectionList sections{};
+
+            /*
+             * Serialized output for one formatting, indentation and escaping.
+             */
+            struct CacheEntry {
+                Formatting formatting{};
+                integer_type tabc{};
+                Escaping escaping{};
+                string_type data{};
+            };
+
+            mutable std::vector<CacheEntry> cache{};
+            bool cache_enabled{false};
+
+            /*
+             * Members below the section by id, class and tag. Pointers refer into the
+             * members of the section and of its subsections, and are only valid while
+             * the index is not stale.
+             */
+            struct Index {
+                std::unordered_map<string_type, variant_t*> ids{};
+                std::unordered_map<string_type, std::vector<variant_t*>> classes{};
+                std::unordered_map<string_type, std::vector<variant_t*>> tags{};
+                bool stale{true};
+            };
+
+            mutable std::unique_ptr<Index> index{};
+            bool index_enabled{false};
+            bool flush_point{false};
+            /*
+             * Set on sections that have been visited by an index, so that changes to them
+             * reach the indexing section even past sections that are already dirty.
+             */
+            mutable bool indexed{false};
+            /*
+             * Set when the section, or anything inside it, may have changed since it was
+             * last cached. If a section is dirty, so is every section containing it.
+             */
+            mutable bool dirty{true};
+            /*
+             * Hash of the section, kept while hashed is set. Hashing cleans the sections
+             * it visits, so that changes inside them walk up far enough to clear it.
+             */
+            mutable std::uint64_t hash{};
+            mutable bool hashed{false};
+            impl::ParentLink parent{};
+
+            void link(size_type first) const noexcept;
+            void adopt(const variant_t* previous, size_type first) noexcept;
+            [[nodiscard]] const string_type* find_cache(Formatting formatting, integer_type tabc, Escaping escaping) const;
+            void build_index(Index& index, bool mark) const;
+            [[nodiscard]] const Index& get_index(Index& scratch) const;
+            void serialize(Sink& sink, Formatting formatting, integer_type tabc, Escaping escaping, bool recording, bool shared, const ParallelOptions* options) const;
+            void serialize_members(Sink& sink, Formatting formatting, integer_type tabc, Escaping escaping, bool recording, bool shared, const ParallelOptions& options) const;
+
+            friend class Selector;
+            friend class SharedSection;
+            friend class Renderer;
+            friend class Tree;
     };
 
     /**
@@ -880,4 +1153,11 @@ namespace bygg::HTML {
      * @return Section The section container
      */
     template <typename... Args> Section make_section_container(Args&&... args) { return Section(bygg::HTML::Tag::Empty, make_properties(), {std::forward<Args>(args)...}); }
-} // namespace bygg
\ No newline at end of file
+} // namespace bygg
+
+/**
+ * @brief Hash a section by its contents, so that equal sections can be deduplicated in unordered containers
+ */
+template <> struct std::hash<bygg::HTML::Section> {
+    std::size_t operator()(const bygg::HTML::Section& section) const { return static_cast<std::size_t>(section.get_hash()); }
+};
\ No newline at end of file
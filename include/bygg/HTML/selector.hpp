@@ -0,0 +1,220 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <bygg/types.hpp>
+#include <bygg/HTML/element.hpp>
+#include <bygg/HTML/section.hpp>
+
+namespace bygg::HTML {
+    /**
+     * @brief A CSS selector, parsed once and matched against any number of sections.
+     * @note Supported are type and universal selectors, #id, .class, attribute selectors ([attr], =, ~=, |=, ^=, $= and *=), :first-child, :last-child, :only-child, :nth-child(), :nth-last-child(), the matching -of-type pseudo-classes, :empty and :not(), along with the descendant, >, + and ~ combinators and comma separated lists.
+     * @note Tags and attribute names are matched case-insensitively. Sections without a tag are transparent, so their members count as children of the section containing them. Text elements and closing tags are never matched. Shared sections are not searched.
+     * @note A Selector is not changed by matching, so one selector can be used from several threads at once.
+     */
+    class Selector {
+        private:
+            enum class Combinator {
+                Descendant,
+                Child,
+                Adjacent,
+                Sibling,
+            };
+            enum class Operator {
+                Exists,
+                Equals,
+                Includes,
+                Dash,
+                Prefix,
+                Suffix,
+                Substring,
+            };
+            enum class PseudoType {
+                Nth,
+                Only,
+                Empty,
+                Not,
+            };
+
+            struct Attribute {
+                string_type name{};
+                Operator op{Operator::Exists};
+                string_type value{};
+            };
+            struct Compound;
+            /*
+             * Nth matches positions a * n + b for some n >= 0, counted from the end
+             * when last is set, and among siblings with the same tag when of_type is set.
+             */
+            struct PseudoClass {
+                PseudoType type{PseudoType::Nth};
+                bool last{false};
+                bool of_type{false};
+                integer_type a{};
+                integer_type b{};
+                std::vector<Compound> compounds{};
+            };
+            struct Compound {
+                string_type tag{};
+                std::vector<string_type> ids{};
+                std::vector<string_type> classes{};
+                std::vector<Attribute> attributes{};
+                std::vector<PseudoClass> pseudo_classes{};
+            };
+            /*
+             * Compounds are stored right to left, the order they are matched in.
+             * combinators[i] joins compounds[i] to compounds[i + 1].
+             */
+            struct Complex {
+                std::vector<Compound> compounds{};
+                std::vector<Combinator> combinators{};
+            };
+            /*
+             * A position in the tree: members[index] of section, for each level
+             * below the section being searched. An empty path is that section.
+             */
+            struct Frame {
+                const Section* section{nullptr};
+                size_type index{};
+            };
+            using Path = std::vector<Frame>;
+
+            string_type selector{};
+            std::vector<Complex> complexes{};
+
+            static Compound parse_compound(std::string_view str, size_type& pos);
+            static PseudoClass parse_pseudo_class(std::string_view str, size_type& pos);
+            static const Section::variant_t& get_member(const Path& path);
+            static bool is_node(const Section::variant_t& member);
+            static bool parent(const Section& root, Path& path);
+            static bool previous(Path& path);
+            static bool next(Path& path);
+            static bool match_compound(const Compound& compound, const Section& root, const Path& path);
+            static bool match_complex(const Complex& complex, size_type index, const Section& root, const Path& path);
+            void search(const Section& section, std::vector<Section::variant_t*>& results, bool first) const;
+        public:
+            /**
+             * @brief Construct a new Selector object
+             * @param selector The selector to parse
+             * @throws bygg::invalid_argument If the selector is empty, malformed or uses something unsupported
+             */
+            explicit Selector(const string_type& selector);
+            /**
+             * @brief Construct a new Selector object
+             * @param selector The selector to copy
+             */
+            Selector(const Selector& selector) = default;
+            /**
+             * @brief Construct a new Selector object
+             * @param selector The selector to move from
+             */
+            Selector(Selector&& selector) noexcept = default;
+            /**
+             * @brief Destroy the Selector object
+             */
+            ~Selector() = default;
+
+            /**
+             * @brief Get the selector as it was written
+             * @return string_type The selector
+             */
+            [[nodiscard]] string_type get() const;
+            /**
+             * @brief Get the first element or section below a section that matches the selector, in document order.
+             * @param section The section to search. The section itself is not matched, but the sections containing a match up to it are.
+             * @return Section::variant_t* The member, or nullptr if there is none
+             */
+            [[nodiscard]] Section::variant_t* query(Section& section) const;
+            /**
+             * @brief Get the first element or section below a section that matches the selector, in document order.
+             * @param section The section to search. The section itself is not matched, but the sections containing a match up to it are.
+             * @return const Section::variant_t* The member, or nullptr if there is none
+             */
+            [[nodiscard]] const Section::variant_t* query(const Section& section) const;
+            /**
+             * @brief Get all elements and sections below a section that match the selector, in document order.
+             * @param section The section to search. The section itself is not matched, but the sections containing a match up to it are.
+             * @return std::vector<Section::variant_t*> The members
+             */
+            [[nodiscard]] std::vector<Section::variant_t*> query_all(Section& section) const;
+            /**
+             * @brief Get all elements and sections below a section that match the selector, in document order.
+             * @param section The section to search. The section itself is not matched, but the sections containing a match up to it are.
+             * @return std::vector<const Section::variant_t*> The members
+             */
+            [[nodiscard]] std::vector<const Section::variant_t*> query_all(const Section& section) const;
+
+            Selector& operator=(const Selector& selector) = default;
+            Selector& operator=(Selector&& selector) noexcept = default;
+    };
+
+    /**
+     * @brief Get the first element or section below a section that matches a selector
+     * @param section The section to search
+     * @param selector The selector to match
+     * @return Section::variant_t* The member, or nullptr if there is none
+     */
+    [[nodiscard]] Section::variant_t* query_selector(Section& section, const Selector& selector);
+    /**
+     * @brief Get the first element or section below a section that matches a selector
+     * @param section The section to search
+     * @param selector The selector to match
+     * @return const Section::variant_t* The member, or nullptr if there is none
+     */
+    [[nodiscard]] const Section::variant_t* query_selector(const Section& section, const Selector& selector);
+    /**
+     * @brief Get the first element or section below a section that matches a selector
+     * @note The selector is parsed on each call. Construct a Selector to reuse it.
+     * @param section The section to search
+     * @param selector The selector to match
+     * @return Section::variant_t* The member, or nullptr if there is none
+     */
+    [[nodiscard]] Section::variant_t* query_selector(Section& section, const string_type& selector);
+    /**
+     * @brief Get the first element or section below a section that matches a selector
+     * @note The selector is parsed on each call. Construct a Selector to reuse it.
+     * @param section The section to search
+     * @param selector The selector to match
+     * @return const Section::variant_t* The member, or nullptr if there is none
+     */
+    [[nodiscard]] const Section::variant_t* query_selector(const Section& section, const string_type& selector);
+    /**
+     * @brief Get all elements and sections below a section that match a selector
+     * @param section The section to search
+     * @param selector The selector to match
+     * @return std::vector<Section::variant_t*> The members
+     */
+    [[nodiscard]] std::vector<Section::variant_t*> query_selector_all(Section& section, const Selector& selector);
+    /**
+     * @brief Get all elements and sections below a section that match a selector
+     * @param section The section to search
+     * @param selector The selector to match
+     * @return std::vector<const Section::variant_t*> The members
+     */
+    [[nodiscard]] std::vector<const Section::variant_t*> query_selector_all(const Section& section, const Selector& selector);
+    /**
+     * @brief Get all elements and sections below a section that match a selector
+     * @note The selector is parsed on each call. Construct a Selector to reuse it.
+     * @param section The section to search
+     * @param selector The selector to match
+     * @return std::vector<Section::variant_t*> The members
+     */
+    [[nodiscard]] std::vector<Section::variant_t*> query_selector_all(Section& section, const string_type& selector);
+    /**
+     * @brief Get all elements and sections below a section that match a selector
+     * @note The selector is parsed on each call. Construct a Selector to reuse it.
+     * @param section The section to search
+     * @param selector The selector to match
+     * @return std::vector<const Section::variant_t*> The members
+     */
+    [[nodiscard]] std::vector<const Section::variant_t*> query_selector_all(const Section& section, const string_type& selector);
+} // namespace bygg::HTML
@@ -0,0 +1,140 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <bygg/types.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/formatting_enum.hpp>
+#include <bygg/HTML/escaping_enum.hpp>
+#include <bygg/HTML/properties.hpp>
+#include <bygg/HTML/element.hpp>
+
+namespace bygg::HTML {
+    class Section;
+
+    /**
+     * @brief A reference counted, immutable section that can be stored in any number of sections without being copied.
+     * @note Copying a SharedSection, or a section containing one, only copies the handle, so a header or footer stored in thousands of pages exists once in memory. The subtree is serialized in place, producing the same output as the section it was made from.
+     * @note The subtree can only be changed through modify(), as it is only handed out as a const Section, whose members can not be changed. If the subtree is shared with other handles, modify() first gives this handle its own copy, so the other handles are never affected.
+     * @note Shared subtrees are treated as opaque by lookups: get_by_id(), get_by_class(), get_by_tag() and selectors do not search them.
+     * @note Serializing never changes a shared subtree, so pages holding the same subtree can be serialized from several threads at once. To serialize the subtree only once, enable its cache, serialize it and then move it into the handle; the cached output is then reused by every page.
+     */
+    class SharedSection {
+        private:
+            std::shared_ptr<Section> section;
+            /* hash of the section, updated whenever it is modified */
+            std::uint64_t hash{};
+            impl::ParentLink parent{};
+
+            Section& detach();
+            void update();
+
+            friend class Section;
+            friend class Tree;
+        public:
+            /**
+             * @brief Construct a new SharedSection object, holding an empty section
+             */
+            SharedSection();
+            /**
+             * @brief Construct a new SharedSection object
+             * @param section The section to share. It is copied once.
+             */
+            explicit SharedSection(const Section& section);
+            /**
+             * @brief Construct a new SharedSection object
+             * @param section The section to share
+             */
+            explicit SharedSection(Section&& section);
+            /**
+             * @brief Construct a new SharedSection object, sharing the subtree of another handle
+             * @param section The handle to copy
+             */
+            SharedSection(const SharedSection& section) = default;
+            /**
+             * @brief Construct a new SharedSection object, taking over the subtree of another handle
+             * @note The handle moved from holds no section, and can only be assigned to or destroyed.
+             * @param section The handle to move from
+             */
+            SharedSection(SharedSection&& section) noexcept = default;
+            /**
+             * @brief Destroy the SharedSection object. The subtree is destroyed along with the last handle to it.
+             */
+            ~SharedSection() = default;
+
+            /**
+             * @brief Get the shared section
+             * @return const Section& The section
+             */
+            [[nodiscard]] const Section& get_section() const;
+            /**
+             * @brief Get the number of handles sharing the section, including this one
+             * @return long The number of handles
+             */
+            [[nodiscard]] long use_count() const;
+            /**
+             * @brief Get a hash of the shared section, the same as that of the section itself
+             * @return std::uint64_t The hash
+             */
+            [[nodiscard]] std::uint64_t get_hash() const;
+            /**
+             * @brief Change the section, copying it first if it is shared with other handles
+             * @note The section containing the handle, and every section containing that one, is invalidated.
+             * @param function Function called with a Section& to change
+             */
+            template <typename F> void modify(F function) {
+                function(this->detach());
+                this->update();
+            }
+
+            /**
+             * @brief Get the tag of the shared section
+             * @return string_type The tag of the section
+             */
+            [[nodiscard]] string_type get_tag() const;
+            /**
+             * @brief Get the properties of the shared section
+             * @return Properties The properties of the section
+             */
+            [[nodiscard]] Properties get_properties() const;
+            /**
+             * @brief Dump the entire shared section.
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             * @return string_type The section
+             */
+            [[nodiscard]] string_type get(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Write the entire shared section to a sink, producing the same output as get() without building intermediate strings.
+             * @param sink The sink to write to
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             */
+            void write_to(Sink& sink, Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Compute the exact number of bytes get() would return for the shared section, without producing the output.
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             * @return size_type The size of the serialized output
+             */
+            [[nodiscard]] size_type serialized_size(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+
+            const Section& operator*() const;
+            const Section* operator->() const;
+            SharedSection& operator=(const SharedSection& section);
+            SharedSection& operator=(SharedSection&& section) noexcept;
+            bool operator==(const SharedSection& section) const;
+            bool operator!=(const SharedSection& section) const;
+    };
+} // namespace bygg::HTML
@@ -7,10 +7,12 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <iterator>
 #include <unordered_map>
 
 #include <bygg/types.hpp>
-#include <bygg/HTML/tag.hpp>
+#include <bygg/except.hpp>
 #include <bygg/HTML/type_enum.hpp>
 
 namespace bygg::HTML {
@@ -172,6 +174,378 @@ namespace bygg::HTML {
         Xmp, /* <xmp></xmp> */
     };
 
+    /**
+     * @brief Compile-time information about a tag.
+     */
+    struct TagInfo {
+        Tag tag{}; /* The tag this entry describes */
+        std::string_view name{}; /* The name of the tag as written in HTML */
+        Type type{}; /* The type of element the tag produces */
+        std::string_view enum_name{}; /* The name of the enum value, as written in C++ */
+        bool container{}; /* Whether the tag is a container */
+    };
+
+    /**
+     * @brief Table of all tags, indexed by Tag.
+     */
+    inline constexpr TagInfo tag_table[]{
+        {Tag::Empty, "", Type::Text, "Tag::Empty", false},
+        {Tag::Empty_No_Formatting, "", Type::Text_No_Formatting, "Tag::Empty_No_Formatting", false},
+        {Tag::Abbreviation, "abbr", Type::Data, "Tag::Abbreviation", false},
+        {Tag::Abbr, "abbr", Type::Data, "Tag::Abbr", false},
+        {Tag::Acronym, "acronym", Type::Data, "Tag::Acronym", false},
+        {Tag::Address, "address", Type::Data, "Tag::Address", false},
+        {Tag::Anchor, "a", Type::Data, "Tag::Anchor", false},
+        {Tag::A, "a", Type::Data, "Tag::A", false},
+        {Tag::Applet, "applet", Type::Data, "Tag::Applet", false},
+        {Tag::Article, "article", Type::Data, "Tag::Article", true},
+        {Tag::Area, "area", Type::Standalone, "Tag::Area", false},
+        {Tag::Aside, "aside", Type::Data, "Tag::Aside", true},
+        {Tag::Audio, "audio", Type::Data, "Tag::Audio", false},
+        {Tag::Base, "base", Type::Standalone, "Tag::Base", false},
+        {Tag::Basefont, "basefont", Type::Standalone, "Tag::Basefont", false},
+        {Tag::Bdi, "bdi", Type::Data, "Tag::Bdi", false},
+        {Tag::Bdo, "bdo", Type::Data, "Tag::Bdo", false},
+        {Tag::Bgsound, "bgsound", Type::Data, "Tag::Bgsound", false},
+        {Tag::Big, "big", Type::Data, "Tag::Big", false},
+        {Tag::Blockquote, "blockquote", Type::Data, "Tag::Blockquote", false},
+        {Tag::Body, "body", Type::Data, "Tag::Body", true},
+        {Tag::Bold, "b", Type::Data, "Tag::Bold", false},
+        {Tag::B, "b", Type::Data, "Tag::B", false},
+        {Tag::Br, "br", Type::Standalone, "Tag::Br", false},
+        {Tag::Break, "br", Type::Standalone, "Tag::Break", false},
+        {Tag::Button, "button", Type::Data, "Tag::Button", false},
+        {Tag::Caption, "caption", Type::Data, "Tag::Caption", false},
+        {Tag::Canvas, "canvas", Type::Data, "Tag::Canvas", false},
+        {Tag::Center, "center", Type::Data, "Tag::Center", false},
+        {Tag::Cite, "cite", Type::Data, "Tag::Cite", false},
+        {Tag::Code, "code", Type::Data, "Tag::Code", false},
+        {Tag::Colgroup, "colgroup", Type::Data, "Tag::Colgroup", false},
+        {Tag::Col, "col", Type::Standalone, "Tag::Col", false},
+        {Tag::Column, "col", Type::Standalone, "Tag::Column", false},
+        {Tag::Data, "data", Type::Data, "Tag::Data", false},
+        {Tag::Datalist, "datalist", Type::Data, "Tag::Datalist", false},
+        {Tag::Dd, "dd", Type::Data, "Tag::Dd", false},
+        {Tag::Dfn, "dfn", Type::Data, "Tag::Dfn", false},
+        {Tag::Define, "dfn", Type::Data, "Tag::Define", false},
+        {Tag::Delete, "del", Type::Data, "Tag::Delete", false},
+        {Tag::Del, "del", Type::Data, "Tag::Del", false},
+        {Tag::Details, "details", Type::Data, "Tag::Details", true},
+        {Tag::Dialog, "dialog", Type::Data, "Tag::Dialog", false},
+        {Tag::Dir, "dir", Type::Data, "Tag::Dir", false},
+        {Tag::Div, "div", Type::Data, "Tag::Div", true},
+        {Tag::Dl, "dl", Type::Data, "Tag::Dl", false},
+        {Tag::Dt, "dt", Type::Data, "Tag::Dt", false},
+        {Tag::Ul, "ul", Type::Data, "Tag::Ul", true},
+        {Tag::UnorderedList, "ul", Type::Data, "Tag::UnorderedList", true},
+        {Tag::Ol, "ol", Type::Data, "Tag::Ol", true},
+        {Tag::OrderedList, "ol", Type::Data, "Tag::OrderedList", true},
+        {Tag::Embed, "embed", Type::Standalone, "Tag::Embed", false},
+        {Tag::Em, "em", Type::Data, "Tag::Em", false},
+        {Tag::Emphasis, "em", Type::Data, "Tag::Emphasis", false},
+        {Tag::Fieldset, "fieldset", Type::Data, "Tag::Fieldset", true},
+        {Tag::Figcaption, "figcaption", Type::Data, "Tag::Figcaption", false},
+        {Tag::Figure, "figure", Type::Data, "Tag::Figure", false},
+        {Tag::Font, "font", Type::Data, "Tag::Font", false},
+        {Tag::Footer, "footer", Type::Data, "Tag::Footer", true},
+        {Tag::Form, "form", Type::Data, "Tag::Form", true},
+        {Tag::Frame, "frame", Type::Standalone, "Tag::Frame", false},
+        {Tag::Frameset, "frameset", Type::Data, "Tag::Frameset", false},
+        {Tag::Head, "head", Type::Data, "Tag::Head", true},
+        {Tag::Header, "header", Type::Data, "Tag::Header", true},
+        {Tag::H1, "h1", Type::Data, "Tag::H1", false},
+        {Tag::H2, "h2", Type::Data, "Tag::H2", false},
+        {Tag::H3, "h3", Type::Data, "Tag::H3", false},
+        {Tag::H4, "h4", Type::Data, "Tag::H4", false},
+        {Tag::H5, "h5", Type::Data, "Tag::H5", false},
+        {Tag::H6, "h6", Type::Data, "Tag::H6", false},
+        {Tag::Hgroup, "hgroup", Type::Data, "Tag::Hgroup", false},
+        {Tag::Hr, "hr", Type::Standalone, "Tag::Hr", false},
+        {Tag::Html, "html", Type::Data, "Tag::Html", true},
+        {Tag::Iframe, "iframe", Type::Data, "Tag::Iframe", false},
+        {Tag::Image, "img", Type::Standalone, "Tag::Image", false},
+        {Tag::Img, "img", Type::Standalone, "Tag::Img", false},
+        {Tag::Input, "input", Type::Standalone, "Tag::Input", false},
+        {Tag::Ins, "ins", Type::Data, "Tag::Ins", false},
+        {Tag::Isindex, "isindex", Type::Standalone, "Tag::Isindex", false},
+        {Tag::Italic, "i", Type::Data, "Tag::Italic", false},
+        {Tag::I, "i", Type::Data, "Tag::I", false},
+        {Tag::Kbd, "kbd", Type::Data, "Tag::Kbd", false},
+        {Tag::Keygen, "keygen", Type::Standalone, "Tag::Keygen", false},
+        {Tag::Label, "label", Type::Data, "Tag::Label", false},
+        {Tag::Legend, "legend", Type::Data, "Tag::Legend", false},
+        {Tag::List, "li", Type::Data, "Tag::List", true},
+        {Tag::Li, "li", Type::Data, "Tag::Li", true},
+        {Tag::Link, "link", Type::Standalone, "Tag::Link", false},
+        {Tag::Main, "main", Type::Data, "Tag::Main", true},
+        {Tag::Mark, "mark", Type::Data, "Tag::Mark", false},
+        {Tag::Marquee, "marquee", Type::Data, "Tag::Marquee", false},
+        {Tag::Menuitem, "menuitem", Type::Data, "Tag::Menuitem", false},
+        {Tag::Meta, "meta", Type::Standalone, "Tag::Meta", false},
+        {Tag::Meter, "meter", Type::Data, "Tag::Meter", false},
+        {Tag::Nav, "nav", Type::Data, "Tag::Nav", true},
+        {Tag::Nobreak, "nobr", Type::Data, "Tag::Nobreak", false},
+        {Tag::Nobr, "nobr", Type::Data, "Tag::Nobr", false},
+        {Tag::Noembed, "noembed", Type::Data, "Tag::Noembed", false},
+        {Tag::Noscript, "noscript", Type::Data, "Tag::Noscript", false},
+        {Tag::Object, "object", Type::Data, "Tag::Object", false},
+        {Tag::Optgroup, "optgroup", Type::Data, "Tag::Optgroup", false},
+        {Tag::Option, "option", Type::Data, "Tag::Option", false},
+        {Tag::Output, "output", Type::Data, "Tag::Output", false},
+        {Tag::Paragraph, "p", Type::Data, "Tag::Paragraph", false},
+        {Tag::P, "p", Type::Data, "Tag::P", false},
+        {Tag::Param, "param", Type::Standalone, "Tag::Param", false},
+        {Tag::Phrase, "phrase", Type::Data, "Tag::Phrase", false},
+        {Tag::Pre, "pre", Type::Data, "Tag::Pre", false},
+        {Tag::Progress, "progress", Type::Data, "Tag::Progress", false},
+        {Tag::Quote, "q", Type::Data, "Tag::Quote", false},
+        {Tag::Q, "q", Type::Data, "Tag::Q", false},
+        {Tag::Rp, "rp", Type::Data, "Tag::Rp", false},
+        {Tag::Rt, "rt", Type::Data, "Tag::Rt", false},
+        {Tag::Ruby, "ruby", Type::Data, "Tag::Ruby", false},
+        {Tag::Outdated, "s", Type::Data, "Tag::Outdated", false},
+        {Tag::S, "s", Type::Data, "Tag::S", false},
+        {Tag::Sample, "samp", Type::Data, "Tag::Sample", false},
+        {Tag::Samp, "samp", Type::Data, "Tag::Samp", false},
+        {Tag::Script, "script", Type::Data, "Tag::Script", false},
+        {Tag::Section, "section", Type::Data, "Tag::Section", true},
+        {Tag::Small, "small", Type::Data, "Tag::Small", false},
+        {Tag::Source, "source", Type::Data, "Tag::Source", false},
+        {Tag::Spacer, "spacer", Type::Data, "Tag::Spacer", false},
+        {Tag::Span, "span", Type::Data, "Tag::Span", false},
+        {Tag::Strike, "strike", Type::Data, "Tag::Strike", false},
+        {Tag::Strong, "strong", Type::Data, "Tag::Strong", false},
+        {Tag::Style, "style", Type::Data, "Tag::Style", false},
+        {Tag::Select, "select", Type::Data, "Tag::Select", false},
+        {Tag::Sub, "sub", Type::Data, "Tag::Sub", false},
+        {Tag::Subscript, "sub", Type::Data, "Tag::Subscript", false},
+        {Tag::Sup, "sup", Type::Data, "Tag::Sup", false},
+        {Tag::Superscript, "sup", Type::Data, "Tag::Superscript", false},
+        {Tag::Summary, "summary", Type::Data, "Tag::Summary", true},
+        {Tag::Svg, "svg", Type::Standalone, "Tag::Svg", false},
+        {Tag::Table, "table", Type::Data, "Tag::Table", true},
+        {Tag::Tbody, "tbody", Type::Data, "Tag::Tbody", true},
+        {Tag::Td, "td", Type::Data, "Tag::Td", true},
+        {Tag::Template, "template", Type::Data, "Tag::Template", false},
+        {Tag::Tfoot, "tfoot", Type::Data, "Tag::Tfoot", true},
+        {Tag::Th, "th", Type::Data, "Tag::Th", true},
+        {Tag::Thead, "thead", Type::Data, "Tag::Thead", true},
+        {Tag::Time, "time", Type::Data, "Tag::Time", false},
+        {Tag::Title, "title", Type::Data, "Tag::Title", false},
+        {Tag::Tr, "tr", Type::Data, "Tag::Tr", true},
+        {Tag::Track, "track", Type::Standalone, "Tag::Track", false},
+        {Tag::Tt, "tt", Type::Data, "Tag::Tt", false},
+        {Tag::Underline, "u", Type::Data, "Tag::Underline", false},
+        {Tag::U, "u", Type::Data, "Tag::U", false},
+        {Tag::Var, "var", Type::Data, "Tag::Var", false},
+        {Tag::Video, "video", Type::Data, "Tag::Video", false},
+        {Tag::Wbr, "wbr", Type::Standalone, "Tag::Wbr", false},
+        {Tag::Xmp, "xmp", Type::Data, "Tag::Xmp", false},
+    };
+
+    /**
+     * @brief Table of tag names and the Tag each one resolves to, sorted by name.
+     */
+    inline constexpr std::pair<std::string_view, Tag> tag_name_table[]{
+        {"", Tag::Empty_No_Formatting},
+        {"a", Tag::A},
+        {"abbr", Tag::Abbr},
+        {"acronym", Tag::Acronym},
+        {"address", Tag::Address},
+        {"applet", Tag::Applet},
+        {"area", Tag::Area},
+        {"article", Tag::Article},
+        {"aside", Tag::Aside},
+        {"audio", Tag::Audio},
+        {"b", Tag::B},
+        {"base", Tag::Base},
+        {"basefont", Tag::Basefont},
+        {"bdi", Tag::Bdi},
+        {"bdo", Tag::Bdo},
+        {"bgsound", Tag::Bgsound},
+        {"big", Tag::Big},
+        {"blockquote", Tag::Blockquote},
+        {"body", Tag::Body},
+        {"br", Tag::Br},
+        {"button", Tag::Button},
+        {"canvas", Tag::Canvas},
+        {"caption", Tag::Caption},
+        {"center", Tag::Center},
+        {"cite", Tag::Cite},
+        {"code", Tag::Code},
+        {"col", Tag::Col},
+        {"colgroup", Tag::Colgroup},
+        {"data", Tag::Data},
+        {"datalist", Tag::Datalist},
+        {"dd", Tag::Dd},
+        {"del", Tag::Del},
+        {"details", Tag::Details},
+        {"dfn", Tag::Define},
+        {"dialog", Tag::Dialog},
+        {"dir", Tag::Dir},
+        {"div", Tag::Div},
+        {"dl", Tag::Dl},
+        {"dt", Tag::Dt},
+        {"em", Tag::Em},
+        {"embed", Tag::Embed},
+        {"fieldset", Tag::Fieldset},
+        {"figcaption", Tag::Figcaption},
+        {"figure", Tag::Figure},
+        {"font", Tag::Font},
+        {"footer", Tag::Footer},
+        {"form", Tag::Form},
+        {"frame", Tag::Frame},
+        {"frameset", Tag::Frameset},
+        {"h1", Tag::H1},
+        {"h2", Tag::H2},
+        {"h3", Tag::H3},
+        {"h4", Tag::H4},
+        {"h5", Tag::H5},
+        {"h6", Tag::H6},
+        {"head", Tag::Head},
+        {"header", Tag::Header},
+        {"hgroup", Tag::Hgroup},
+        {"hr", Tag::Hr},
+        {"html", Tag::Html},
+        {"i", Tag::Italic},
+        {"iframe", Tag::Iframe},
+        {"img", Tag::Image},
+        {"input", Tag::Input},
+        {"ins", Tag::Ins},
+        {"isindex", Tag::Isindex},
+        {"kbd", Tag::Kbd},
+        {"keygen", Tag::Keygen},
+        {"label", Tag::Label},
+        {"legend", Tag::Legend},
+        {"li", Tag::List},
+        {"link", Tag::Link},
+        {"main", Tag::Main},
+        {"mark", Tag::Mark},
+        {"marquee", Tag::Marquee},
+        {"menuitem", Tag::Menuitem},
+        {"meta", Tag::Meta},
+        {"meter", Tag::Meter},
+        {"nav", Tag::Nav},
+        {"nobr", Tag::Nobreak},
+        {"noembed", Tag::Noembed},
+        {"noscript", Tag::Noscript},
+        {"object", Tag::Object},
+        {"ol", Tag::OrderedList},
+        {"optgroup", Tag::Optgroup},
+        {"option", Tag::Option},
+        {"output", Tag::Output},
+        {"p", Tag::Paragraph},
+        {"param", Tag::Param},
+        {"phrase", Tag::Phrase},
+        {"pre", Tag::Pre},
+        {"progress", Tag::Progress},
+        {"q", Tag::Quote},
+        {"rp", Tag::Rp},
+        {"rt", Tag::Rt},
+        {"ruby", Tag::Ruby},
+        {"s", Tag::Outdated},
+        {"samp", Tag::Sample},
+        {"script", Tag::Script},
+        {"section", Tag::Section},
+        {"select", Tag::Select},
+        {"small", Tag::Small},
+        {"source", Tag::Source},
+        {"spacer", Tag::Spacer},
+        {"span", Tag::Span},
+        {"strike", Tag::Strike},
+        {"strong", Tag::Strong},
+        {"style", Tag::Style},
+        {"sub", Tag::Subscript},
+        {"summary", Tag::Summary},
+        {"sup", Tag::Superscript},
+        {"svg", Tag::Svg},
+        {"table", Tag::Table},
+        {"tbody", Tag::Tbody},
+        {"td", Tag::Td},
+        {"template", Tag::Template},
+        {"tfoot", Tag::Tfoot},
+        {"th", Tag::Th},
+        {"thead", Tag::Thead},
+        {"time", Tag::Time},
+        {"title", Tag::Title},
+        {"tr", Tag::Tr},
+        {"track", Tag::Track},
+        {"tt", Tag::Tt},
+        {"u", Tag::U},
+        {"ul", Tag::UnorderedList},
+        {"var", Tag::Var},
+        {"video", Tag::Video},
+        {"wbr", Tag::Wbr},
+        {"xmp", Tag::Xmp},
+    };
+
+    /**
+     * @brief Table of container tag names, sorted by name.
+     */
+    inline constexpr std::string_view container_table[]{
+        "article", "aside", "body", "details", "div", "fieldset", "foot", "footer", "form", "head", "header", "html", "li",
+        "main", "nav", "ol", "section", "summary", "table", "tbody", "td", "tfoot", "th", "thead", "tr", "ul",
+    };
+
+    namespace impl {
+        template <typename T, size_type N, typename Key>
+        constexpr const T* find_sorted(const T (&table)[N], const std::string_view key, Key key_of) {
+            size_type first{0};
+            size_type last{N};
+
+            while (first < last) {
+                const size_type middle{first + (last - first) / 2};
+                const std::string_view current{key_of(table[middle])};
+
+                if (current == key) {
+                    return &table[middle];
+                } else if (current < key) {
+                    first = middle + 1;
+                } else {
+                    last = middle;
+                }
+            }
+
+            return nullptr;
+        }
+
+        constexpr bool validate_tag_tables() {
+            for (size_type i{0}; i < std::size(tag_table); ++i) {
+                if (static_cast<size_type>(tag_table[i].tag) != i) {
+                    return false;
+                }
+            }
+            for (size_type i{1}; i < std::size(tag_name_table); ++i) {
+                if (!(tag_name_table[i - 1].first < tag_name_table[i].first)) {
+                    return false;
+                }
+            }
+            for (size_type i{1}; i < std::size(container_table); ++i) {
+                if (!(container_table[i - 1] < container_table[i])) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        static_assert(validate_tag_tables(), "tag_table must be in enum order, and tag_name_table and container_table sorted");
+    } // namespace impl
+
+    /**
+     * @brief Get the compile-time information about a tag.
+     * @param tag The tag to look up
+     * @return const TagInfo& The information about the tag
+     */
+    constexpr const TagInfo& get_tag_info(const Tag tag) {
+        const auto index{static_cast<size_type>(tag)};
+
+        if (index >= std::size(tag_table)) {
+            throw invalid_argument{"Invalid tag"};
+        }
+
+        return tag_table[index];
+    }
     /**
      * @brief Get a map of tags to strings and types.
      * @return std::unordered_map<bygg::HTML::Tag, std::pair<string_type, bygg::HTML::Type>> The map of tags to strings and types.
@@ -182,24 +556,41 @@ namespace bygg::HTML {
      * @param tag The tag to resolve
      * @return std::pair<string_type, Type> The resolved tag
      */
-    std::pair<string_type, Type> resolve_tag(Tag tag);
+    inline std::pair<string_type, Type> resolve_tag(const Tag tag) {
+        const TagInfo& info{get_tag_info(tag)};
+        return {string_type{info.name}, info.type};
+    }
     /**
      * @brief Resolve a string tag to a Tag enum.
      * @param tag The tag to resolve
      * @return Tag The resolved tag
      */
-    Tag resolve_tag(const string_type& tag);
+    constexpr Tag resolve_tag(const std::string_view tag) {
+        const auto* it = impl::find_sorted(tag_name_table, tag, [](const std::pair<std::string_view, Tag>& entry) { return entry.first; });
+
+        if (it == nullptr) {
+            throw invalid_argument{"Invalid tag"};
+        }
+
+        return it->second;
+    }
 
     /**
      * @brief Get the name of the enum for a tag.
      * @param tag The tag to get the enum name for
      */
-    string_type resolve_tag_enum_name(Tag tag);
+    inline string_type resolve_tag_enum_name(const Tag tag) {
+        return string_type{get_tag_info(tag).enum_name};
+    }
     /**
      * @brief Check if a tag is a container.
      * @param tag The tag to check
      * @return bool True if the tag is a container, false otherwise
      */
-    bool is_container(const string_type& tag);
-    bool is_container(Tag tag);
+    constexpr bool is_container(const std::string_view tag) {
+        return impl::find_sorted(container_table, tag, [](const std::string_view entry) { return entry; }) != nullptr;
+    }
+    constexpr bool is_container(const Tag tag) {
+        return get_tag_info(tag).container;
+    }
 } // namespace bygg
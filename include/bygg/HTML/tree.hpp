@@ -0,0 +1,275 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+#include <bygg/types.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/tag.hpp>
+#include <bygg/HTML/type_enum.hpp>
+#include <bygg/HTML/element_enum.hpp>
+#include <bygg/HTML/formatting_enum.hpp>
+#include <bygg/HTML/escaping_enum.hpp>
+#include <bygg/HTML/properties.hpp>
+#include <bygg/HTML/section.hpp>
+
+namespace bygg::HTML {
+    /**
+     * @brief A compact, flat representation of a Section tree.
+     * @note Nodes are stored in a single contiguous array and linked through parent, first child and next sibling indices. Tag names are interned, and all text (element data, property keys and values) lives in one shared buffer, so traversal and serialization touch a few contiguous arrays rather than one heap allocation per node.
+     * @note Node 0 is always the root section. The output of get() and write_to() is identical to that of the equivalent Section.
+     * @note All storage is taken from a std::pmr::memory_resource. Pass a std::pmr::monotonic_buffer_resource to build a document, serialize it and release every allocation at once when the resource is destroyed.
+     */
+    class Tree {
+        public:
+            /**
+             * @brief Type used to refer to a node in the tree
+             */
+            using index_type = std::uint32_t;
+            /**
+             * @brief The npos value, used for missing parent, child and sibling links
+             */
+            static constexpr index_type npos = static_cast<index_type>(-1);
+
+            /**
+             * @brief A range of bytes in the text buffer of the tree
+             */
+            struct Span {
+                size_type offset{};
+                size_type size{};
+            };
+            /**
+             * @brief A property of a node, stored as two spans in the text buffer
+             */
+            struct Attribute {
+                Span key{};
+                Span value{};
+            };
+            /**
+             * @brief A single node in the tree, either a section or an element
+             */
+            struct Node {
+                index_type parent{npos};
+                index_type first_child{npos};
+                index_type last_child{npos};
+                index_type next_sibling{npos};
+                index_type tag{};
+                index_type attribute_begin{};
+                index_type attribute_count{};
+                Span data{};
+                Type type{Type::Data};
+                ElementParameters params{_default_element_parameters};
+                bool section{false};
+                bool transform{false};
+            };
+        private:
+            std::pmr::vector<Node> nodes;
+            std::pmr::vector<Attribute> attributes;
+            std::pmr::vector<std::pmr::string> tags;
+            /*
+             * Interned tag ids by the hash of the tag name, so that a lookup
+             * does not have to build a string key.
+             */
+            std::pmr::unordered_multimap<std::size_t, index_type> tag_ids;
+            std::pmr::string text;
+
+            index_type intern_tag(std::string_view tag);
+            Span store_text(std::string_view str);
+            std::string_view get_text(Span span) const;
+            index_type store_attributes(const Properties& properties);
+            index_type append_node(index_type parent, Node node);
+            void append_section(index_type parent, const Section& section);
+            void write_attributes(Sink& sink, const Node& node, Escaping escaping) const;
+            void write_element(Sink& sink, const Node& node, Formatting formatting, integer_type tabc, Escaping escaping) const;
+            void write_open(Sink& sink, const Node& node, Formatting formatting, integer_type tabc, Escaping escaping) const;
+            void write_close(Sink& sink, const Node& node, Formatting formatting, integer_type tabc) const;
+        public:
+            /**
+             * @brief Construct a new Tree object, containing only an empty root section
+             * @param resource The memory resource to allocate from
+             */
+            explicit Tree(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+            /**
+             * @brief Construct a new Tree object from a section
+             * @param section The section to convert. It becomes the root of the tree.
+             * @param resource The memory resource to allocate from
+             */
+            explicit Tree(const Section& section, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+            /**
+             * @brief Construct a new Tree object
+             * @note The copy allocates from the default memory resource, not from the resource of the tree it is copied from.
+             * @param tree The tree to copy
+             */
+            Tree(const Tree& tree) = default;
+            /**
+             * @brief Construct a new Tree object
+             * @param tree The tree to move from. The new tree takes over its memory resource.
+             */
+            Tree(Tree&& tree) noexcept = default;
+            /**
+             * @brief Destroy the Tree object
+             */
+            ~Tree() = default;
+
+            /**
+             * @brief Replace the contents of the tree with a section
+             * @param section The section to convert. It becomes the root of the tree.
+             */
+            void set(const Section& section);
+            /**
+             * @brief Convert the tree back to a section
+             * @return Section The root section, with all of its members
+             */
+            [[nodiscard]] Section to_section() const;
+            /**
+             * @brief Append a section to a node
+             * @param parent The section to append to
+             * @param tag The tag of the new section
+             * @param properties The properties of the new section
+             * @return index_type The index of the new section
+             */
+            index_type add_section(index_type parent, std::string_view tag, const Properties& properties = {});
+            /**
+             * @brief Append a section to a node
+             * @param parent The section to append to
+             * @param tag The tag of the new section
+             * @param properties The properties of the new section
+             * @return index_type The index of the new section
+             */
+            index_type add_section(index_type parent, Tag tag, const Properties& properties = {});
+            /**
+             * @brief Append an element to a node
+             * @param parent The section to append to
+             * @param tag The tag of the new element
+             * @param properties The properties of the new element
+             * @param data The data of the new element
+             * @param type The type of the new element
+             * @param params The parameters of the new element
+             * @return index_type The index of the new element
+             */
+            index_type add_element(index_type parent, std::string_view tag, const Properties& properties, std::string_view data = {}, Type type = Type::Data, ElementParameters params = _default_element_parameters);
+            /**
+             * @brief Append an element to a node
+             * @param parent The section to append to
+             * @param tag The tag of the new element
+             * @param data The data of the new element
+             * @param params The parameters of the new element
+             * @return index_type The index of the new element
+             */
+            index_type add_element(index_type parent, Tag tag, std::string_view data = {}, ElementParameters params = _default_element_parameters);
+            /**
+             * @brief Append an element to a node
+             * @param parent The section to append to
+             * @param tag The tag of the new element
+             * @param properties The properties of the new element
+             * @param data The data of the new element
+             * @param params The parameters of the new element
+             * @return index_type The index of the new element
+             */
+            index_type add_element(index_type parent, Tag tag, const Properties& properties, std::string_view data = {}, ElementParameters params = _default_element_parameters);
+
+            /**
+             * @brief Get the index of the root section
+             * @return index_type The index of the root section
+             */
+            [[nodiscard]] static constexpr index_type root() { return 0; }
+            /**
+             * @brief Get a node
+             * @param index The index of the node
+             * @return const Node& The node
+             */
+            [[nodiscard]] const Node& at(index_type index) const;
+            /**
+             * @brief Get the tag of a node
+             * @param index The index of the node
+             * @return std::string_view The tag of the node
+             */
+            [[nodiscard]] std::string_view get_tag(index_type index) const;
+            /**
+             * @brief Get the data of an element node
+             * @param index The index of the node
+             * @return std::string_view The data of the node
+             */
+            [[nodiscard]] std::string_view get_data(index_type index) const;
+            /**
+             * @brief Get the properties of a node
+             * @param index The index of the node
+             * @return Properties The properties of the node
+             */
+            [[nodiscard]] Properties get_properties(index_type index) const;
+            /**
+             * @brief Get the number of nodes in the tree, including the root
+             * @return size_type The number of nodes
+             */
+            [[nodiscard]] size_type size() const;
+            /**
+             * @brief Check if the root section has no members
+             * @return bool True if the tree is empty, false otherwise
+             */
+            [[nodiscard]] bool empty() const;
+            /**
+             * @brief Remove all nodes, leaving an empty root section
+             */
+            void clear();
+            /**
+             * @brief Reserve space for nodes and text
+             * @param nodes The number of nodes to reserve space for
+             * @param text The number of bytes of text to reserve space for
+             */
+            void reserve(size_type nodes, size_type text = 0);
+            /**
+             * @brief Get the memory resource the tree allocates from
+             * @return std::pmr::memory_resource* The memory resource
+             */
+            [[nodiscard]] std::pmr::memory_resource* get_resource() const;
+
+            /**
+             * @brief Get the tree as a string
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             * @return string_type The serialized tree
+             */
+            [[nodiscard]] string_type get(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Get the tree in the form of a specific type.
+             * @return T The tree in the form of a specific type
+             */
+            template <typename T> [[nodiscard]] T get(const Formatting formatting = Formatting::None, const integer_type tabc = 0, const Escaping escaping = Escaping::None) const {
+                if (std::is_same_v<T, string_type>) {
+                    return this->get(formatting, tabc, escaping);
+                }
+                return T(this->get(formatting, tabc, escaping));
+            }
+            /**
+             * @brief Write the tree to a sink, producing the same output as get() without building intermediate strings.
+             * @param sink The sink to write to
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             */
+            void write_to(Sink& sink, Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+            /**
+             * @brief Compute the exact number of bytes get() would return for the tree, without producing the output.
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             * @return size_type The size of the serialized output
+             */
+            [[nodiscard]] size_type serialized_size(Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None) const;
+
+            Tree& operator=(const Tree& tree);
+            Tree& operator=(Tree&& tree);
+            Tree& operator=(const Section& section);
+    };
+} // namespace bygg::HTML
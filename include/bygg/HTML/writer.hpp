@@ -0,0 +1,150 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <bygg/types.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/formatting_enum.hpp>
+#include <bygg/HTML/escaping_enum.hpp>
+#include <bygg/HTML/type_enum.hpp>
+#include <bygg/HTML/element_enum.hpp>
+#include <bygg/HTML/tag.hpp>
+#include <bygg/HTML/properties.hpp>
+#include <bygg/HTML/element.hpp>
+
+namespace bygg::HTML {
+    /**
+     * @brief Writes HTML straight into a sink as sections are opened and closed, without building a tree.
+     * @note The output is identical to that of get() on the section the same calls would build: open() and close() stand for a section, and element() and text() for an element in it. Sections with an empty tag write no markup, and their members are not indented.
+     * @note Nothing is allocated per node. The tags of the open sections are kept to check that sections are closed in order, and the last newline is held back so that it can be dropped, as get() drops it.
+     */
+    class Writer {
+        private:
+            Sink& output;
+            TrimmingSink sink;
+            Formatting formatting{Formatting::None};
+            Escaping escaping{Escaping::None};
+            /* indentation of the members of the innermost open section */
+            integer_type tabc{};
+            /* tags of the open sections end to end, and where each of them starts */
+            string_type tags{};
+            std::vector<size_type> offsets{};
+
+            [[nodiscard]] std::string_view get_open_tag() const;
+        public:
+            /**
+             * @brief Construct a new Writer object
+             * @param sink The sink to write to. It must outlive the writer.
+             * @param formatting The formatting type to use
+             * @param tabc Number of tab indents to start with, when using Formatting::Pretty
+             * @param escaping Whether to escape attribute values and element data
+             */
+            explicit Writer(Sink& sink, Formatting formatting = Formatting::None, integer_type tabc = 0, Escaping escaping = Escaping::None);
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+            /**
+             * @brief Destroy the Writer object
+             */
+            ~Writer() = default;
+
+            /**
+             * @brief Open a section
+             * @param tag The tag of the section
+             * @param properties The properties of the section
+             * @return Writer& The writer, for chaining
+             */
+            Writer& open(Tag tag, const Properties& properties = {});
+            /**
+             * @brief Open a section
+             * @param tag The tag of the section
+             * @param properties The properties of the section
+             * @return Writer& The writer, for chaining
+             */
+            Writer& open(std::string_view tag, const Properties& properties = {});
+            /**
+             * @brief Close the innermost open section
+             * @return Writer& The writer, for chaining
+             */
+            Writer& close();
+            /**
+             * @brief Close the innermost open section, checking its tag
+             * @param tag The tag the section was opened with
+             * @return Writer& The writer, for chaining
+             */
+            Writer& close(Tag tag);
+            /**
+             * @brief Close the innermost open section, checking its tag
+             * @param tag The tag the section was opened with
+             * @return Writer& The writer, for chaining
+             */
+            Writer& close(std::string_view tag);
+
+            /**
+             * @brief Write an element
+             * @param tag The tag of the element
+             * @param properties The properties of the element
+             * @param data The data of the element
+             * @param params The parameters of the element
+             * @return Writer& The writer, for chaining
+             */
+            Writer& element(Tag tag, const Properties& properties, std::string_view data = {}, ElementParameters params = _default_element_parameters);
+            /**
+             * @brief Write an element
+             * @param tag The tag of the element
+             * @param data The data of the element
+             * @param params The parameters of the element
+             * @return Writer& The writer, for chaining
+             */
+            Writer& element(Tag tag, std::string_view data = {}, ElementParameters params = _default_element_parameters);
+            /**
+             * @brief Write an element
+             * @param tag The tag of the element
+             * @param properties The properties of the element
+             * @param data The data of the element
+             * @param type The type of the element
+             * @param params The parameters of the element
+             * @return Writer& The writer, for chaining
+             */
+            Writer& element(std::string_view tag, const Properties& properties, std::string_view data = {}, Type type = Type::Data, ElementParameters params = _default_element_parameters);
+            /**
+             * @brief Write an element
+             * @param tag The tag of the element
+             * @param data The data of the element
+             * @param type The type of the element
+             * @param params The parameters of the element
+             * @return Writer& The writer, for chaining
+             */
+            Writer& element(std::string_view tag, std::string_view data = {}, Type type = Type::Data, ElementParameters params = _default_element_parameters);
+            /**
+             * @brief Write an element
+             * @param element The element to write
+             * @return Writer& The writer, for chaining
+             */
+            Writer& element(const Element& element);
+            /**
+             * @brief Write text, as an element of Type::Text would be written
+             * @param data The text to write
+             * @param params The parameters of the text
+             * @return Writer& The writer, for chaining
+             */
+            Writer& text(std::string_view data, ElementParameters params = _default_element_parameters);
+
+            /**
+             * @brief Get the number of open sections
+             * @return size_type The number of open sections
+             */
+            [[nodiscard]] size_type depth() const;
+            /**
+             * @brief Check that every section has been closed, and flush the sink
+             */
+            void finish();
+    };
+} // namespace bygg::HTML
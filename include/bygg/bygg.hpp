@@ -8,6 +8,7 @@
 
 #include <bygg/types.hpp>
 #include <bygg/except.hpp>
+#include <bygg/sink.hpp>
 #include <bygg/version.hpp>
 #include <bygg/HTML/HTML.hpp>
 #include <bygg/CSS/CSS.hpp>
\ No newline at end of file
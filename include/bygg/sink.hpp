@@ -0,0 +1,172 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+#pragma once
+
+#include <memory>
+#include <ostream>
+#include <functional>
+#include <bygg/types.hpp>
+
+namespace bygg {
+    /**
+     * @brief Abstract output target for serialization. Serializers write bytes into a sink as they are produced, without building intermediate strings.
+     */
+    class Sink {
+        public:
+            /**
+             * @brief Write a sequence of bytes to the sink
+             * @param data Pointer to the bytes to write
+             * @param size The number of bytes to write
+             */
+            virtual void write(const char* data, size_type size) = 0;
+            /**
+             * @brief Flush any buffered bytes to the underlying target
+             */
+            virtual void flush() {}
+            /**
+             * @brief Write a string to the sink
+             * @param str The string to write
+             */
+            void write(const string_type& str) { this->write(str.data(), str.size()); }
+            /**
+             * @brief Write a single character to the sink
+             * @param c The character to write
+             */
+            void put(const char c) { this->write(&c, 1); }
+            /**
+             * @brief Write a character to the sink several times
+             * @param c The character to write
+             * @param count The number of times to write it
+             */
+            void fill(char c, size_type count);
+
+            Sink() = default;
+            Sink(const Sink&) = delete;
+            Sink& operator=(const Sink&) = delete;
+            /**
+             * @brief Destroy the Sink object
+             */
+            virtual ~Sink() = default;
+    };
+
+    /**
+     * @brief Sink writing to a std::ostream
+     */
+    class StreamSink : public Sink {
+            std::ostream& stream;
+        public:
+            /**
+             * @brief Construct a new StreamSink object
+             * @param stream The stream to write to
+             */
+            explicit StreamSink(std::ostream& stream) : stream(stream) {};
+            void write(const char* data, size_type size) override;
+            void flush() override;
+            using Sink::write;
+    };
+
+    /**
+     * @brief Sink appending to a caller-owned, growable string
+     */
+    class StringSink : public Sink {
+            string_type& target;
+        public:
+            /**
+             * @brief Construct a new StringSink object
+             * @param target The string to append to
+             */
+            explicit StringSink(string_type& target) : target(target) {};
+            void write(const char* data, size_type size) override;
+            using Sink::write;
+    };
+
+    /**
+     * @brief Sink writing to a fixed-size buffer. Once the buffer is full, its contents are handed to the overflow callback and the buffer is reused.
+     */
+    class FixedBufferSink : public Sink {
+        public:
+            /**
+             * @brief Callback receiving the filled part of the buffer
+             */
+            using overflow_type = std::function<void(const char*, size_type)>;
+        private:
+            char* buffer{nullptr};
+            size_type capacity{};
+            size_type used{};
+            overflow_type overflow{};
+        public:
+            /**
+             * @brief Construct a new FixedBufferSink object
+             * @param buffer The buffer to write to
+             * @param capacity The size of the buffer
+             * @param overflow Callback invoked with the buffer contents when it is full. If empty, out_of_range is thrown instead.
+             */
+            FixedBufferSink(char* buffer, const size_type capacity, overflow_type overflow = {}) : buffer(buffer), capacity(capacity), overflow(std::move(overflow)) {};
+            void write(const char* data, size_type size) override;
+            /**
+             * @brief Hand the bytes currently in the buffer to the overflow callback
+             */
+            void flush() override;
+            /**
+             * @brief Get the number of bytes currently in the buffer
+             * @return size_type The number of bytes in the buffer
+             */
+            [[nodiscard]] size_type size() const;
+            using Sink::write;
+    };
+
+    /**
+     * @brief Sink forwarding to another sink, but holding back a trailing newline until more data arrives
+     * @note Whatever is still held back once serialization finishes is dropped, which matches get() trimming the final newline off its result.
+     */
+    class TrimmingSink : public Sink {
+            Sink& sink;
+            bool pending_newline{false};
+        public:
+            /**
+             * @brief Construct a new TrimmingSink object
+             * @param sink The sink to forward to
+             */
+            explicit TrimmingSink(Sink& sink) : sink(sink) {};
+            void write(const char* data, size_type size) override;
+            using Sink::write;
+    };
+
+    /**
+     * @brief Sink writing to a file descriptor, such as a file, pipe or socket
+     * @note Output is collected in an internal buffer and written once it is full, when flush() is called and when the sink is destroyed. Errors while writing from the destructor are ignored, so call flush() to have them reported.
+     */
+    class FileDescriptorSink : public Sink {
+        public:
+            /**
+             * @brief The size of the internal buffer, in bytes
+             */
+            static constexpr size_type buffer_size{65536};
+        private:
+            int fd{-1};
+            std::unique_ptr<char[]> buffer{};
+            size_type used{};
+
+            void write_all(const char* data, size_type size) const;
+        public:
+            /**
+             * @brief Construct a new FileDescriptorSink object
+             * @param fd The file descriptor to write to. It is not closed by the sink.
+             */
+            explicit FileDescriptorSink(int fd);
+            void write(const char* data, size_type size) override;
+            /**
+             * @brief Write the buffered bytes to the file descriptor
+             */
+            void flush() override;
+            /**
+             * @brief Destroy the FileDescriptorSink object, writing any buffered bytes
+             */
+            ~FileDescriptorSink() override;
+            using Sink::write;
+    };
+} // namespace bygg
@@ -13,6 +13,8 @@ bygg::CSS::Element& bygg::CSS::Element::operator=(const bygg::CSS::Element& elem
     return *this;
 }
 
+bygg::CSS::Element& bygg::CSS::Element::operator=(bygg::CSS::Element&& element) noexcept = default;
+
 bygg::CSS::Element& bygg::CSS::Element::operator=(const std::pair<string_type, bygg::CSS::Properties>& element) {
     this->children = {element.second};
     return *this;
@@ -36,42 +38,49 @@ bygg::CSS::Property& bygg::CSS::Element::operator[](const size_type& index) {
 }
 
 bool bygg::CSS::Element::operator==(const bygg::CSS::Element& element) const {
+    // elements built alike serialize alike, which saves serializing both
+    if (this == &element || (this->selector == element.selector && this->type == element.type &&
+            this->pseudo == element.pseudo && this->children == element.children)) {
+        return true;
+    }
+
     return this->get() == element.get();
 }
 
 bool bygg::CSS::Element::operator!=(const bygg::CSS::Element& element) const {
-    return this->get() != element.get();
+    return !(*this == element);
 }
 
-void bygg::CSS::Element::set(const bygg::string_type& tag, const bygg::CSS::Properties& properties, const Type type, const PseudoClass& pseudo) {
-    this->selector = tag;
-    this->children = {properties};
+void bygg::CSS::Element::set(bygg::string_type tag, bygg::CSS::Properties properties, const Type type, PseudoClass pseudo) {
+    this->selector = std::move(tag);
+    this->set_properties(std::move(properties));
     this->type = type;
-    this->pseudo = pseudo;
+    this->pseudo = std::move(pseudo);
 }
 
-void bygg::CSS::Element::set_tag(const bygg::string_type& tag) {
-    this->selector = tag;
+void bygg::CSS::Element::set_tag(bygg::string_type tag) {
+    this->selector = std::move(tag);
 }
 
 void bygg::CSS::Element::set_tag(const HTML::Tag tag) {
-    this->selector = resolve_tag(tag).first;
+    this->selector = get_tag_info(tag).name;
 }
 
-void bygg::CSS::Element::set_properties(const bygg::CSS::Properties& properties) {
-    this->children = {properties};
+void bygg::CSS::Element::set_properties(bygg::CSS::Properties properties) {
+    this->children.clear();
+    this->children.emplace_back(std::move(properties));
 }
 
-void bygg::CSS::Element::set_pseudo(const PseudoClass &pseudo) {
-    this->pseudo = pseudo;
+void bygg::CSS::Element::set_pseudo(PseudoClass pseudo) {
+    this->pseudo = std::move(pseudo);
 }
 
 void bygg::CSS::Element::set_type(const Type type) {
     this->type = type;
 }
 
-void bygg::CSS::Element::set(HTML::Tag tag, const bygg::CSS::Properties& properties, const Type type, const PseudoClass& pseudo) {
-    this->set(resolve_tag(tag).first, properties, type, pseudo);
+void bygg::CSS::Element::set(HTML::Tag tag, bygg::CSS::Properties properties, const Type type, PseudoClass pseudo) {
+    this->set(resolve_tag(tag).first, std::move(properties), type, std::move(pseudo));
 }
 
 void bygg::CSS::Element::push_front(const Property& property) {
@@ -100,6 +109,32 @@ void bygg::CSS::Element::push_back(const Property& property) {
     throw internal_error("Failed to push property to back");
 }
 
+void bygg::CSS::Element::push_front(Property&& property) {
+    ensure_has_properties();
+
+    for (size_type i{0}; i < this->children.size(); i++) {
+        if (std::holds_alternative<Properties>(this->children.at(i))) {
+            std::get<Properties>(this->children.at(i)).push_front(std::move(property));
+            return;
+        }
+    }
+
+    throw internal_error("Failed to push property to front");
+}
+
+void bygg::CSS::Element::push_back(Property&& property) {
+    ensure_has_properties();
+
+    for (size_type i{0}; i < this->children.size(); i++) {
+        if (std::holds_alternative<Properties>(this->children.at(i))) {
+            std::get<Properties>(this->children.at(i)).push_back(std::move(property));
+            return;
+        }
+    }
+
+    throw internal_error("Failed to push property to back");
+}
+
 void bygg::CSS::Element::push_front(const Properties& properties) {
     ensure_has_properties();
 
@@ -144,6 +179,14 @@ void bygg::CSS::Element::push_back(const Element& element) {
     this->children.emplace_back(element);
 }
 
+void bygg::CSS::Element::push_front(Element&& element) {
+    this->children.insert(this->children.begin(), std::move(element));
+}
+
+void bygg::CSS::Element::push_back(Element&& element) {
+    this->children.emplace_back(std::move(element));
+}
+
 void bygg::CSS::Element::insert(const size_type index, const Property& property) {
     ensure_has_properties();
 
@@ -163,6 +206,25 @@ void bygg::CSS::Element::insert(const size_type index, const Property& property)
     throw internal_error("Failed to insert property");
 }
 
+void bygg::CSS::Element::insert(const size_type index, Property&& property) {
+    ensure_has_properties();
+
+    for (size_type i{0}; i < this->children.size(); i++) {
+        if (std::holds_alternative<Properties>(this->children.at(i))) {
+            auto& ref = std::get<Properties>(this->children.at(i));
+
+            if (index >= ref.size()) {
+                throw out_of_range("Index out of range");
+            }
+
+            ref.insert(index, std::move(property));
+            return;
+        }
+    }
+
+    throw internal_error("Failed to insert property");
+}
+
 void bygg::CSS::Element::insert(size_type index, const Element& element) {
     ensure_has_properties();
 
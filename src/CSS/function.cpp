@@ -14,6 +14,10 @@ void bygg::CSS::Function::push_back(const string_type& parameter) {
     parameters.push_back(parameter);
 }
 
+void bygg::CSS::Function::push_back(string_type&& parameter) {
+    parameters.push_back(std::move(parameter));
+}
+
 void bygg::CSS::Function::emplace_back(string_type&& parameter) {
     parameters.emplace_back(std::move(parameter));
 }
@@ -147,17 +151,17 @@ void bygg::CSS::Function::clear() {
     parameters.clear();
 }
 
-void bygg::CSS::Function::set_name(const bygg::string_type& name) {
-    this->name = name;
+void bygg::CSS::Function::set_name(bygg::string_type name) {
+    this->name = std::move(name);
 }
 
-void bygg::CSS::Function::set_parameters(const std::vector<bygg::string_type>& parameters) {
-    this->parameters = parameters;
+void bygg::CSS::Function::set_parameters(std::vector<bygg::string_type> parameters) {
+    this->parameters = std::move(parameters);
 }
 
-void bygg::CSS::Function::set(const string_type& name, const std::vector<string_type>& parameters) {
-    this->name = name;
-    this->parameters = parameters;
+void bygg::CSS::Function::set(string_type name, std::vector<string_type> parameters) {
+    this->name = std::move(name);
+    this->parameters = std::move(parameters);
 }
 
 bool bygg::CSS::Function::operator==(const Function& other) const {
@@ -174,6 +178,8 @@ bygg::CSS::Function& bygg::CSS::Function::operator=(const Function& other) {
     return *this;
 }
 
+bygg::CSS::Function& bygg::CSS::Function::operator=(Function&& other) noexcept = default;
+
 bygg::CSS::Function::operator bygg::string_type() const { // NOLINT
     return get();
 }
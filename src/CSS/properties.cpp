@@ -20,6 +20,8 @@ bygg::CSS::Properties& bygg::CSS::Properties::operator=(const bygg::CSS::Propert
     return *this;
 }
 
+bygg::CSS::Properties& bygg::CSS::Properties::operator=(bygg::CSS::Properties&& properties) noexcept = default;
+
 bygg::CSS::Properties& bygg::CSS::Properties::operator=(const bygg::CSS::PropertyList& properties) {
     this->set(properties);
     return *this;
@@ -98,8 +100,8 @@ bygg::CSS::Property bygg::CSS::Properties::at(const size_type index) const {
     return this->properties.at(index);
 }
 
-void bygg::CSS::Properties::set(const bygg::CSS::PropertyList& properties) {
-    this->properties = properties;
+void bygg::CSS::Properties::set(bygg::CSS::PropertyList properties) {
+    this->properties = std::move(properties);
 }
 
 void bygg::CSS::Properties::insert(const size_type index, const bygg::CSS::Property& property) {
@@ -110,6 +112,14 @@ void bygg::CSS::Properties::insert(const size_type index, const bygg::CSS::Prope
     this->properties.insert(this->properties.begin() + static_cast<long>(index), property);
 }
 
+void bygg::CSS::Properties::insert(const size_type index, bygg::CSS::Property&& property) {
+    if (index >= this->properties.size()) {
+        throw bygg::out_of_range("Index out of range");
+    }
+
+    this->properties.insert(this->properties.begin() + static_cast<long>(index), std::move(property));
+}
+
 void bygg::CSS::Properties::erase(const size_type index) {
     if (index >= this->properties.size()) {
         throw bygg::out_of_range("Index out of range");
@@ -122,10 +132,18 @@ void bygg::CSS::Properties::push_front(const bygg::CSS::Property& property) {
     this->properties.insert(this->properties.begin(), property);
 }
 
+void bygg::CSS::Properties::push_front(bygg::CSS::Property&& property) {
+    this->properties.insert(this->properties.begin(), std::move(property));
+}
+
 void bygg::CSS::Properties::push_back(const bygg::CSS::Property& property) {
     this->properties.push_back(property);
 }
 
+void bygg::CSS::Properties::push_back(bygg::CSS::Property&& property) {
+    this->properties.push_back(std::move(property));
+}
+
 void bygg::CSS::Properties::push_back(const bygg::CSS::Properties& properties) {
     for (const bygg::CSS::Property& it : properties) {
         this->push_back(it);
@@ -33,16 +33,17 @@ bygg::string_type bygg::CSS::Property::get(bygg::CSS::Formatting formatting, int
     return ret;
 }
 
-void bygg::CSS::Property::set_key(const bygg::string_type& key) {
-    this->property.first = key;
+void bygg::CSS::Property::set_key(bygg::string_type key) {
+    this->property.first = std::move(key);
 }
 
-void bygg::CSS::Property::set_value(const bygg::string_type& value) {
-    this->property.second = value;
+void bygg::CSS::Property::set_value(bygg::string_type value) {
+    this->property.second = std::move(value);
 }
 
-void bygg::CSS::Property::set(const bygg::string_type& key, const bygg::string_type& value) {
-    this->property = std::make_pair(key, value);
+void bygg::CSS::Property::set(bygg::string_type key, bygg::string_type value) {
+    this->property.first = std::move(key);
+    this->property.second = std::move(value);
 }
 
 bygg::CSS::Property& bygg::CSS::Property::operator=(const bygg::CSS::Property& property) {
@@ -50,6 +51,8 @@ bygg::CSS::Property& bygg::CSS::Property::operator=(const bygg::CSS::Property& p
     return *this;
 }
 
+bygg::CSS::Property& bygg::CSS::Property::operator=(bygg::CSS::Property&& property) noexcept = default;
+
 bool bygg::CSS::Property::operator==(const bygg::CSS::Property& property) const {
     return this->get_key() == property.get_key() && this->get_value() == property.get_value();
 }
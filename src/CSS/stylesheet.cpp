@@ -8,8 +8,8 @@
 #include <bygg/except.hpp>
 #include <bygg/CSS/stylesheet.hpp>
 
-void bygg::CSS::Stylesheet::set_elements(const bygg::CSS::ElementList& elements) {
-    this->elements = elements;
+void bygg::CSS::Stylesheet::set_elements(bygg::CSS::ElementList elements) {
+    this->elements = std::move(elements);
 }
 
 void bygg::CSS::Stylesheet::push_front(const Element& element) {
@@ -20,6 +20,14 @@ void bygg::CSS::Stylesheet::push_back(const Element& element) {
     this->elements.push_back(element);
 }
 
+void bygg::CSS::Stylesheet::push_front(Element&& element) {
+    this->elements.insert(this->elements.begin(), std::move(element));
+}
+
+void bygg::CSS::Stylesheet::push_back(Element&& element) {
+    this->elements.push_back(std::move(element));
+}
+
 void bygg::CSS::Stylesheet::insert(const size_type index, const Element& element) {
     if (index >= this->elements.size()) {
         throw bygg::out_of_range("Index out of range");
@@ -28,6 +36,14 @@ void bygg::CSS::Stylesheet::insert(const size_type index, const Element& element
     this->elements.insert(this->elements.begin() + static_cast<long>(index), element);
 }
 
+void bygg::CSS::Stylesheet::insert(const size_type index, Element&& element) {
+    if (index >= this->elements.size()) {
+        throw bygg::out_of_range("Index out of range");
+    }
+
+    this->elements.insert(this->elements.begin() + static_cast<long>(index), std::move(element));
+}
+
 void bygg::CSS::Stylesheet::erase(const size_type index) {
     if (index >= this->elements.size()) {
         throw bygg::out_of_range("Index out of range");
@@ -41,11 +57,18 @@ bygg::CSS::Stylesheet& bygg::CSS::Stylesheet::operator=(const bygg::CSS::Stylesh
     return *this;
 }
 
+bygg::CSS::Stylesheet& bygg::CSS::Stylesheet::operator=(bygg::CSS::Stylesheet&& stylesheet) noexcept = default;
+
 bygg::CSS::Stylesheet& bygg::CSS::Stylesheet::operator+=(const Element& element) {
     this->push_back(element);
     return *this;
 }
 
+bygg::CSS::Stylesheet& bygg::CSS::Stylesheet::operator+=(Element&& element) {
+    this->push_back(std::move(element));
+    return *this;
+}
+
 bygg::CSS::Element bygg::CSS::Stylesheet::operator[](const bygg::integer_type& index) const {
     return this->at(index);
 }
@@ -79,8 +102,24 @@ bygg::CSS::Element bygg::CSS::Stylesheet::at(const size_type index) const {
 }
 
 bygg::size_type bygg::CSS::Stylesheet::find(const Element& element) const {
+    // serialized at most once, rather than once per element in the stylesheet
+    string_type str{};
+    bool serialized{false};
+
     for (size_type i{0}; i < this->elements.size(); i++) {
-        if (this->elements.at(i).get() == element.get()) {
+        const Element& it{this->elements.at(i)};
+
+        if (it.get_tag() == element.get_tag() && it.get_type() == element.get_type() &&
+                it.get_pseudo() == element.get_pseudo() && it.get_all() == element.get_all()) {
+            return i;
+        }
+
+        if (!serialized) {
+            str = element.get();
+            serialized = true;
+        }
+
+        if (it.get() == str) {
             return i;
         }
     }
@@ -0,0 +1,295 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <algorithm>
+#include <optional>
+#include <stack>
+#include <string_view>
+
+#include <bygg/except.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/compiled_template.hpp>
+#include <bygg/HTML/impl/escape.hpp>
+#include <bygg/HTML/impl/serialization.hpp>
+
+namespace {
+    /*
+     * Markers are the name of the slot between two Unicode noncharacters, which are
+     * reserved for internal use and left alone by escaping. While compiling, each
+     * marker is replaced by the number of its occurrence between two others.
+     */
+    constexpr std::string_view marker_open{"\xEF\xB7\x90"}; /* U+FDD0 */
+    constexpr std::string_view occurrence_open{"\xEF\xB7\x92"}; /* U+FDD2 */
+    constexpr std::string_view marker_close{"\xEF\xB7\x91"}; /* U+FDD1 */
+
+    bool is_slot_char(const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-' || c == '.';
+    }
+
+    bool is_digit(const char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    /*
+     * Find the next marker starting with open at or after pos, holding at least one
+     * character accepted by is_char. On success, pos is the start of the marker, and
+     * size and name are set to the length of the marker and what it holds.
+     */
+    template <typename F> bool find_marker(std::string_view str, std::string_view open, F is_char, bygg::size_type& pos, bygg::size_type& size, std::string_view& name) {
+        for (pos = str.find(open, pos); pos != std::string_view::npos; pos = str.find(open, pos + 1)) {
+            const bygg::size_type begin{pos + open.size()};
+            bygg::size_type end{begin};
+
+            while (end < str.size() && is_char(str[end])) {
+                ++end;
+            }
+
+            if (end > begin && str.compare(end, marker_close.size(), marker_close) == 0) {
+                name = str.substr(begin, end - begin);
+                size = end + marker_close.size() - pos;
+                return true;
+            }
+        }
+
+        return false;
+    }
+} // namespace
+
+bygg::string_type bygg::HTML::make_slot(const string_type& name) {
+    if (name.empty() || !std::all_of(name.begin(), name.end(), is_slot_char)) {
+        throw invalid_argument("Invalid slot name");
+    }
+
+    string_type ret{marker_open};
+    ret += name;
+    ret += marker_close;
+
+    return ret;
+}
+
+bygg::HTML::Slots& bygg::HTML::Slots::set(const string_type& name, value_type value) {
+    this->values.insert_or_assign(name, std::move(value));
+    return *this;
+}
+
+const bygg::HTML::Slots::value_type* bygg::HTML::Slots::get(const string_type& name) const {
+    const auto it{this->values.find(name)};
+    return it == this->values.end() ? nullptr : &it->second;
+}
+
+void bygg::HTML::Slots::clear() {
+    this->values.clear();
+}
+
+bygg::HTML::CompiledTemplate::CompiledTemplate(const Section& section, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) : formatting(formatting), escaping(escaping) {
+    /*
+     * Each marker is numbered in a copy of the section, so that every occurrence
+     * knows whether it is in a property value, wherever else its slot appears.
+     */
+    struct Occurrence {
+        string_type name{};
+        bool attribute{false};
+    };
+
+    std::vector<Occurrence> occurrences{};
+
+    const auto mark = [&occurrences](string_type& value, const bool attribute) {
+        if (value.find(occurrence_open) != string_type::npos) {
+            throw invalid_argument("Template contains a reserved character");
+        }
+
+        size_type previous{0};
+        size_type pos{0};
+        size_type size{};
+        std::string_view name{};
+        string_type ret{};
+
+        for (; find_marker(value, marker_open, is_slot_char, pos, size, name); previous = pos += size) {
+            ret.append(value, previous, pos - previous);
+            ret += occurrence_open;
+            ret += std::to_string(occurrences.size());
+            ret += marker_close;
+            occurrences.push_back({string_type{name}, attribute});
+        }
+
+        if (previous == 0) {
+            return false;
+        }
+
+        ret.append(value, previous, string_type::npos);
+        value.swap(ret);
+        return true;
+    };
+
+    const auto mark_properties = [&mark](Properties properties) {
+        bool changed{false};
+
+        for (Property& it : properties) {
+            string_type value{it.get_value()};
+
+            if (mark(value, true)) {
+                it.set_value(std::move(value));
+                changed = true;
+            }
+        }
+
+        return changed ? std::optional<Properties>{std::move(properties)} : std::nullopt;
+    };
+
+    Section marked{section};
+    std::stack<Section*> s_stack{};
+    s_stack.push(&marked);
+
+    while (!s_stack.empty()) {
+        Section* c_sect{s_stack.top()};
+        s_stack.pop();
+
+        if (auto properties{mark_properties(c_sect->get_properties())}) {
+            c_sect->set_properties(std::move(*properties));
+        }
+
+        for (Section::variant_t& it : c_sect->get_all()) {
+            if (auto* element = std::get_if<Element>(&it)) {
+                if (auto properties{mark_properties(element->get_properties())}) {
+                    element->set_properties(std::move(*properties));
+                }
+
+                string_type data{element->get_data()};
+
+                if (mark(data, false)) {
+                    element->set_data(std::move(data));
+                }
+            } else if (auto* child = std::get_if<Section>(&it)) {
+                s_stack.push(child);
+            } else if (auto* shared = std::get_if<SharedSection>(&it)) {
+                // the copy is only serialized, so its subtree can be marked after modify() has returned
+                shared->modify([&s_stack](Section& subtree) {
+                    s_stack.push(&subtree);
+                });
+            }
+        }
+    }
+
+    const string_type output{marked.get(formatting, tabc, escaping)};
+    this->data.reserve(output.size());
+
+    size_type previous{0};
+    size_type pos{0};
+    size_type size{};
+    std::string_view number{};
+
+    for (; find_marker(output, occurrence_open, is_digit, pos, size, number); previous = pos += size) {
+        const size_type index{static_cast<size_type>(std::stoull(string_type{number}))};
+        const Occurrence& occurrence{occurrences.at(index)};
+
+        Slot slot{};
+        this->data.append(output, previous, pos - previous);
+
+        // a marker that starts a line takes over its indentation
+        if (formatting != Formatting::None) {
+            size_type start{pos};
+
+            while (start > previous && output[start - 1] == '\t') {
+                --start;
+            }
+
+            if (start == 0 || output[start - 1] == '\n') {
+                this->data.resize(this->data.size() - (pos - start));
+                slot.tabc = static_cast<integer_type>(pos - start);
+                slot.newline = pos + size == output.size() || output[pos + size] == '\n';
+            }
+        }
+
+        const auto it{std::find(this->names.begin(), this->names.end(), occurrence.name)};
+        slot.name = static_cast<size_type>(it - this->names.begin());
+        slot.offset = this->data.size();
+        slot.attribute = occurrence.attribute;
+
+        if (it == this->names.end()) {
+            this->names.push_back(occurrence.name);
+        }
+
+        this->slots.push_back(slot);
+    }
+
+    this->data.append(output, previous, string_type::npos);
+    this->data.shrink_to_fit();
+}
+
+const std::vector<bygg::string_type>& bygg::HTML::CompiledTemplate::get_slots() const {
+    return this->names;
+}
+
+bool bygg::HTML::CompiledTemplate::has_slot(const string_type& name) const {
+    return std::find(this->names.begin(), this->names.end(), name) != this->names.end();
+}
+
+void bygg::HTML::CompiledTemplate::write_value(Sink& sink, const Slot& slot, const Slots::value_type& value) const {
+    const integer_type tabc{std::max<integer_type>(slot.tabc, 0)};
+
+    if (const auto* text = std::get_if<string_type>(&value)) {
+        if (slot.tabc > 0) {
+            sink.fill('\t', static_cast<size_type>(slot.tabc));
+        }
+
+        if (this->escaping == Escaping::All || (this->escaping == Escaping::Attributes && slot.attribute)) {
+            impl::write_escaped(sink, *text);
+        } else {
+            sink.write(*text);
+        }
+
+        return;
+    }
+
+    TrimmingSink trimmed{sink};
+
+    if (const auto* element = std::get_if<Element>(&value)) {
+        element->write_to(trimmed, this->formatting, tabc, this->escaping);
+    } else if (const auto* section = std::get_if<Section>(&value)) {
+        section->write_to(trimmed, this->formatting, tabc, this->escaping);
+    } else if (const auto* shared = std::get_if<SharedSection>(&value)) {
+        shared->write_to(trimmed, this->formatting, tabc, this->escaping);
+    }
+
+    // a value on a line of its own ends the line, unless the template already does
+    if (slot.tabc >= 0 && !slot.newline) {
+        sink.put('\n');
+    }
+}
+
+bygg::string_type bygg::HTML::CompiledTemplate::get(const Slots& slots) const {
+    bygg::string_type ret{};
+    ret.reserve(this->data.size());
+    StringSink sink{ret};
+
+    this->write_to(sink, slots);
+
+    return ret;
+}
+
+void bygg::HTML::CompiledTemplate::write_to(Sink& sink, const Slots& slots) const {
+    // look each name up once, rather than once per marker
+    std::vector<const Slots::value_type*> values(this->names.size());
+    for (size_type i{0}; i < this->names.size(); ++i) {
+        values[i] = slots.get(this->names[i]);
+    }
+
+    size_type previous{0};
+
+    for (const Slot& it : this->slots) {
+        sink.write(this->data.data() + previous, it.offset - previous);
+        previous = it.offset;
+
+        if (values[it.name] != nullptr) {
+            this->write_value(sink, it, *values[it.name]);
+        } else if (it.tabc > 0) {
+            sink.fill('\t', static_cast<size_type>(it.tabc));
+        }
+    }
+
+    sink.write(this->data.data() + previous, this->data.size() - previous);
+}
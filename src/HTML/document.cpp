@@ -5,11 +5,52 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <bygg/sink.hpp>
 #include <bygg/HTML/section.hpp>
 #include <bygg/HTML/document.hpp>
 
-bygg::string_type bygg::HTML::Document::get(const Formatting formatting, const bygg::integer_type tabc) const {
-    return this->doctype + (formatting == Formatting::Pretty ? "\n" : formatting == Formatting::Newline ? "\n" : "") + this->document.get(formatting, tabc);
+bygg::size_type bygg::HTML::Document::serialized_size(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    const bool newline{formatting == Formatting::Pretty || formatting == Formatting::Newline};
+    return this->doctype.size() + (newline ? 1 : 0) + this->document.serialized_size(formatting, tabc, escaping);
+}
+
+bygg::string_type bygg::HTML::Document::get(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    bygg::string_type ret{};
+    ret.reserve(this->serialized_size(formatting, tabc, escaping));
+    StringSink sink{ret};
+
+    this->write_to(sink, formatting, tabc, escaping);
+
+    return ret;
+}
+
+void bygg::HTML::Document::write_to(Sink& sink, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    sink.write(this->doctype);
+
+    if (formatting == Formatting::Pretty || formatting == Formatting::Newline) {
+        sink.put('\n');
+    }
+
+    this->document.write_to(sink, formatting, tabc, escaping);
+}
+
+bygg::string_type bygg::HTML::Document::get(const Formatting formatting, const bygg::integer_type tabc, const ParallelOptions& options, const Escaping escaping) const {
+    bygg::string_type ret{};
+    StringSink sink{ret};
+
+    this->write_to(sink, formatting, tabc, options, escaping);
+
+    return ret;
+}
+
+void bygg::HTML::Document::write_to(Sink& sink, const Formatting formatting, const bygg::integer_type tabc, const ParallelOptions& options, const Escaping escaping) const {
+    sink.write(this->doctype);
+
+    if (formatting == Formatting::Pretty || formatting == Formatting::Newline) {
+        sink.put('\n');
+    }
+
+    this->document.write_to(sink, formatting, tabc, options, escaping);
 }
 
 bygg::HTML::Section bygg::HTML::Document::get_section() const {
@@ -20,16 +61,16 @@ bygg::HTML::Section& bygg::HTML::Document::get_section() {
     return this->document;
 }
 
-void bygg::HTML::Document::set(const bygg::HTML::Section& document) {
-    this->document = document;
+void bygg::HTML::Document::set(bygg::HTML::Section document) {
+    this->document = std::move(document);
 }
 
 bygg::size_type bygg::HTML::Document::size() const {
     return this->document.size();
 }
 
-void bygg::HTML::Document::set_doctype(const bygg::string_type& doctype) {
-    this->doctype = doctype;
+void bygg::HTML::Document::set_doctype(bygg::string_type doctype) {
+    this->doctype = std::move(doctype);
 }
 
 void bygg::HTML::Document::clear() {
@@ -47,13 +88,20 @@ bygg::HTML::Document& bygg::HTML::Document::operator=(const bygg::HTML::Document
     return *this;
 }
 
+bygg::HTML::Document& bygg::HTML::Document::operator=(bygg::HTML::Document&& document) noexcept = default;
+
 bygg::HTML::Document& bygg::HTML::Document::operator=(const bygg::HTML::Section& section) {
     this->set(section);
     return *this;
 }
 
+bygg::HTML::Document& bygg::HTML::Document::operator=(bygg::HTML::Section&& section) {
+    this->set(std::move(section));
+    return *this;
+}
+
 bool bygg::HTML::Document::operator==(const bygg::HTML::Document& document) const {
-    return this->get() == document.get();
+    return this->doctype == document.doctype && this->document == document.document;
 }
 
 bool bygg::HTML::Document::operator==(const bygg::HTML::Section& section) const {
@@ -5,19 +5,57 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <tuple>
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <string_view>
+
 #include <bygg/except.hpp>
+#include <bygg/sink.hpp>
 #include <bygg/HTML/element.hpp>
+#include <bygg/HTML/impl/serialization.hpp>
+#include <bygg/HTML/impl/escape.hpp>
+#include <bygg/HTML/impl/hash.hpp>
+#include <bygg/HTML/impl/simd.hpp>
 
 bygg::HTML::Element& bygg::HTML::Element::operator=(const bygg::HTML::Element& element) {
-    this->set(element.get_tag(), element.properties, element.get_data(), element.type);
+    this->set(element.tag, element.properties, element.data, element.type, element.params);
+    return *this;
+}
+
+bygg::HTML::Element& bygg::HTML::Element::operator=(bygg::HTML::Element&& element) noexcept {
+    this->tag = std::move(element.tag);
+    this->properties = std::move(element.properties);
+    this->data = std::move(element.data);
+    this->type = element.type;
+    this->params = element.params;
+    this->parent.invalidate();
     return *this;
 }
 
 bygg::HTML::Element& bygg::HTML::Element::operator+=(const bygg::string_type& data) {
     this->data += data;
+    this->parent.invalidate();
     return *this;
 }
 
+std::uint64_t bygg::HTML::Element::hash_properties(std::uint64_t seed, const Properties& properties) noexcept {
+    for (const Property& it : properties) {
+        seed = impl::hash_combine(seed, impl::hash_string(it.property.first));
+        seed = impl::hash_combine(seed, impl::hash_string(it.property.second));
+    }
+
+    return impl::hash_combine(seed, properties.size());
+}
+
+std::uint64_t bygg::HTML::Element::get_hash() const noexcept {
+    std::uint64_t ret{impl::hash_combine(impl::element_seed, static_cast<std::uint64_t>(this->type))};
+    ret = impl::hash_combine(ret, impl::hash_string(this->tag));
+    ret = hash_properties(ret, this->properties);
+    return impl::hash_combine(ret, impl::hash_string(this->data));
+}
+
 bool bygg::HTML::Element::operator==(const bygg::HTML::Element& element) const {
     return this->tag == element.get_tag() && this->properties == element.properties && this->data == element.get_data() && this->type == element.type;
 }
@@ -26,177 +64,456 @@ bool bygg::HTML::Element::operator!=(const bygg::HTML::Element& element) const {
     return this->tag != element.get_tag() || this->properties != element.properties || this->data != element.get_data() || this->type != element.type;
 }
 
-void bygg::HTML::Element::set(const bygg::string_type& tag, const Properties& properties, const bygg::string_type& data, const Type type, ElementParameters params) {
-    this->set_tag(tag);
-    this->set_properties(properties);
-    this->set_data(data);
+void bygg::HTML::Element::set(bygg::string_type tag, Properties properties, bygg::string_type data, const Type type, ElementParameters params) {
+    this->set_tag(std::move(tag));
+    this->set_properties(std::move(properties));
+    this->set_data(std::move(data));
     this->set_type(type);
     this->set_params(params);
 }
 
-void bygg::HTML::Element::set(const Tag tag, const Properties& properties, const bygg::string_type& data, ElementParameters params) {
+void bygg::HTML::Element::set(const Tag tag, Properties properties, bygg::string_type data, ElementParameters params) {
     this->set_tag(tag);
-    this->set_properties(properties);
-    this->set_data(data);
+    this->set_properties(std::move(properties));
+    this->set_data(std::move(data));
     this->set_params(params);
 }
 
-void bygg::HTML::Element::set_tag(const bygg::string_type& tag) {
-    this->tag = tag;
+void bygg::HTML::Element::set_tag(bygg::string_type tag) {
+    this->tag = std::move(tag);
+    this->parent.invalidate();
 }
 
 void bygg::HTML::Element::set_tag(const Tag tag) {
-    std::pair<bygg::string_type, bygg::HTML::Type> resolved{resolve_tag(tag)};
-    this->tag = resolved.first;
-    this->type = resolved.second;
+    const TagInfo& info{get_tag_info(tag)};
+    this->tag = info.name;
+    this->type = info.type;
+    this->parent.invalidate();
 }
 
-void bygg::HTML::Element::set_data(const bygg::string_type& data) {
-    this->data = data;
+void bygg::HTML::Element::set_data(bygg::string_type data) {
+    this->data = std::move(data);
+    this->parent.invalidate();
 }
 
 void bygg::HTML::Element::set_type(const Type type) {
     this->type = type;
+    this->parent.invalidate();
 }
 
-void bygg::HTML::Element::set_properties(const Properties& properties) {
-    this->properties = properties;
+void bygg::HTML::Element::set_properties(Properties properties) {
+    this->properties = std::move(properties);
+    this->parent.invalidate();
 }
 
 void bygg::HTML::Element::set_params(ElementParameters params) {
     this->params = params;
+    this->parent.invalidate();
 }
 
-bygg::string_type bygg::HTML::Element::get(const Formatting formatting, const bygg::integer_type tabc) const {
-    bygg::string_type ret{};
-
-    static const std::vector<std::pair<ElementParameters, ElementParameters>> invalid_combinations{
-        std::make_pair<ElementParameters, ElementParameters>(ElementParameters::Replace_Newlines, ElementParameters::Erase_Newlines),
-        std::make_pair<ElementParameters, ElementParameters>(ElementParameters::Replace_Tabs, ElementParameters::Erase_Tabs),
-        std::make_pair<ElementParameters, ElementParameters>(ElementParameters::Replace_Spaces, ElementParameters::Erase_Spaces),
-        std::make_pair<ElementParameters, ElementParameters>(ElementParameters::Erase_Spaces, ElementParameters::Erase_Multi_Spaces),
-        std::make_pair<ElementParameters, ElementParameters>(ElementParameters::Replace_Left_Brackets, ElementParameters::Erase_Left_Brackets),
-        std::make_pair<ElementParameters, ElementParameters>(ElementParameters::Replace_Right_Brackets, ElementParameters::Erase_Right_Brackets),
-        std::make_pair<ElementParameters, ElementParameters>(ElementParameters::Replace_Single_Quotes, ElementParameters::Erase_Single_Quotes),
-        std::make_pair<ElementParameters, ElementParameters>(ElementParameters::Replace_Double_Quotes, ElementParameters::Erase_Double_Quotes)
+namespace {
+    /*
+     * Entities written by TextTransform::Replace + n, in the order the replace flags are listed.
+     */
+    constexpr std::string_view entities[]{"&#10;", "&#9;", "&nbsp;", "&lt;", "&gt;", "&apos;", "&quot;"};
+} // namespace
+
+bygg::HTML::impl::TextTransform::TextTransform(const ElementParameters params) : params(params) {
+    static constexpr std::pair<ElementParameters, ElementParameters> invalid_combinations[]{
+        {ElementParameters::Replace_Newlines, ElementParameters::Erase_Newlines},
+        {ElementParameters::Replace_Tabs, ElementParameters::Erase_Tabs},
+        {ElementParameters::Replace_Spaces, ElementParameters::Erase_Spaces},
+        {ElementParameters::Erase_Spaces, ElementParameters::Erase_Multi_Spaces},
+        {ElementParameters::Replace_Left_Brackets, ElementParameters::Erase_Left_Brackets},
+        {ElementParameters::Replace_Right_Brackets, ElementParameters::Erase_Right_Brackets},
+        {ElementParameters::Replace_Single_Quotes, ElementParameters::Erase_Single_Quotes},
+        {ElementParameters::Replace_Double_Quotes, ElementParameters::Erase_Double_Quotes}
     };
 
     for (const auto& it : invalid_combinations) {
-        if (this->params & it.first && this->params & it.second) {
+        if (params & it.first && params & it.second) {
             throw bygg::invalid_argument("You cannot both erase and replace the same character.");
         }
     }
 
-    const auto remove_necessary = [this](string_type str) -> string_type {
-        string_type string = std::move(str);
-
-        for (const auto& it :
-            {
-                std::make_pair<string_type, bool>(string_type("\t"), this->params & ElementParameters::Erase_Tabs),
-                std::make_pair<string_type, bool>(string_type(" "), this->params & ElementParameters::Erase_Spaces),
-                std::make_pair<string_type, bool>(string_type("\n"), this->params & ElementParameters::Erase_Newlines),
-                std::make_pair<string_type, bool>(string_type("<"), this->params & ElementParameters::Erase_Left_Brackets),
-                std::make_pair<string_type, bool>(string_type(">"), this->params & ElementParameters::Erase_Right_Brackets),
-                std::make_pair<string_type, bool>(string_type("'"), this->params & ElementParameters::Erase_Single_Quotes),
-                std::make_pair<string_type, bool>(string_type("\""), this->params & ElementParameters::Erase_Double_Quotes)
-            })
-        {
-            if (it.second) {
-                size_type pos{};
-                while ((pos = string.find(it.first, pos)) != string_type::npos) {
-                    string.erase(pos, it.first.length());
-                }
-            }
+    static constexpr std::tuple<char, ElementParameters, ElementParameters> characters[]{
+        {'\n', ElementParameters::Erase_Newlines, ElementParameters::Replace_Newlines},
+        {'\t', ElementParameters::Erase_Tabs, ElementParameters::Replace_Tabs},
+        {' ', ElementParameters::Erase_Spaces, ElementParameters::Replace_Spaces},
+        {'<', ElementParameters::Erase_Left_Brackets, ElementParameters::Replace_Left_Brackets},
+        {'>', ElementParameters::Erase_Right_Brackets, ElementParameters::Replace_Right_Brackets},
+        {'\'', ElementParameters::Erase_Single_Quotes, ElementParameters::Replace_Single_Quotes},
+        {'"', ElementParameters::Erase_Double_Quotes, ElementParameters::Replace_Double_Quotes},
+    };
+
+    for (size_type i{0}; i < std::size(characters); ++i) {
+        const auto& [c, erase, replace] = characters[i];
+        unsigned char& action{this->actions[static_cast<unsigned char>(c)]};
+
+        if (params & erase) {
+            action = Erase;
+        } else if (params & replace) {
+            action = static_cast<unsigned char>(Replace + i);
         }
+    }
 
-        if (this->params & ElementParameters::Erase_Multi_Spaces) {
-            for (size_type i{0}; i < string.length(); i++) {
-                if (string[i] == ' ') {
-                    size_type j{i + 1};
-                    while (j < string.length() && string[j] == ' ') {
-                        string.erase(j, 1);
-                    }
-                }
-            }
+    // spaces are collapsed before they are replaced, so a collapsed space may still become &nbsp;
+    if (params & ElementParameters::Erase_Multi_Spaces) {
+        this->actions[' '] = Collapse;
 
-            if (string.front() == ' ') {
-                string.erase(0, 1);
-            }
-            if (string.back() == ' ') {
-                string.pop_back();
-            }
+        if (params & ElementParameters::Replace_Spaces) {
+            this->space = entities[2];
         }
 
-        for (const auto& it : {
-                std::make_tuple(string_type("\n"), string_type("&#10;"), this->params & ElementParameters::Replace_Newlines),
-                std::make_tuple(string_type("\t"), string_type("&#9;"), this->params & ElementParameters::Replace_Tabs),
-                std::make_tuple(string_type("<"), string_type("&lt;"), this->params & ElementParameters::Replace_Left_Brackets),
-                std::make_tuple(string_type(">"), string_type("&gt;"), this->params & ElementParameters::Replace_Right_Brackets),
-                std::make_tuple(string_type("'"), string_type("&apos;"), this->params & ElementParameters::Replace_Single_Quotes),
-                std::make_tuple(string_type("\""), string_type("&quot;"), this->params & ElementParameters::Replace_Double_Quotes),
-                std::make_tuple(string_type(" "), string_type("&nbsp;"), this->params & ElementParameters::Replace_Spaces),
-            })
-        {
-            size_type pos{};
-            if (std::get<2>(it)) {
-                while ((pos = string.find(std::get<0>(it), pos)) != string_type::npos) {
-                    string.replace(pos, std::get<0>(it).length(), std::get<1>(it));
-                }
-            }
+        this->collapse_runs = this->space.size() == 1;
+    }
+
+    for (size_type i{0}; i < this->actions.size(); ++i) {
+        if (this->actions[i] != Keep) {
+            this->specials[this->special_count++] = static_cast<char>(i);
+        }
+    }
+}
+
+bygg::size_type bygg::HTML::impl::TextTransform::find(const std::string_view data, size_type pos) const {
+    if (this->special_count == 0) {
+        return string_type::npos;
+    }
+
+#ifdef BYGG_HAS_SSE2
+    // with collapse_runs, a space only matters if the byte after it does too
+    __m128i needles[std::tuple_size_v<decltype(this->specials)>];
+    size_type needle_count{0};
+
+    for (size_type i{0}; i < this->special_count; ++i) {
+        if (!this->collapse_runs || this->specials[i] != ' ') {
+            needles[needle_count++] = _mm_set1_epi8(this->specials[i]);
+        }
+    }
+
+    const __m128i spaces{_mm_set1_epi8(' ')};
+
+    const auto match = [&needles, needle_count](const __m128i block) {
+        __m128i ret{_mm_setzero_si128()};
+
+        for (size_type i{0}; i < needle_count; ++i) {
+            ret = _mm_or_si128(ret, _mm_cmpeq_epi8(block, needles[i]));
         }
 
-        return string;
+        return ret;
     };
 
-    string_type data_string = remove_necessary(this->data);
+    for (; pos + 17 <= data.size(); pos += 16) {
+        const __m128i block{_mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + pos))};
+        __m128i found{match(block)};
+
+        if (this->collapse_runs) {
+            const __m128i next{_mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + pos + 1))};
+            const __m128i next_found{_mm_or_si128(match(next), _mm_cmpeq_epi8(next, spaces))};
+            found = _mm_or_si128(found, _mm_and_si128(_mm_cmpeq_epi8(block, spaces), next_found));
+        }
+
+        if (_mm_movemask_epi8(found) != 0) {
+            break;
+        }
+    }
+#endif
+
+    for (; pos < data.size(); ++pos) {
+        const unsigned char action{this->actions[static_cast<unsigned char>(data[pos])]};
+
+        if (action == Keep) {
+            continue;
+        }
+
+        if (action != Collapse || !this->collapse_runs || pos + 1 == data.size() ||
+            this->actions[static_cast<unsigned char>(data[pos + 1])] != Keep) {
+            return pos;
+        }
+    }
+
+    return string_type::npos;
+}
+
+template <typename Output> void bygg::HTML::impl::TextTransform::run(const std::string_view data, Output&& output, const bool preceded, const bool followed) const {
+    // a collapsed space is only written once something follows it, which drops
+    // trailing spaces; nothing written yet means the space is leading and dropped
+    bool written{preceded};
+    bool space_pending{false};
+    size_type start{0};
+
+    // output is called with whether the bytes come from the data, or were written by the transform
+    const auto write_space = [&]() {
+        if (space_pending) {
+            output(this->space, false);
+            space_pending = false;
+        }
+    };
+
+    const auto flush = [&](const size_type end) {
+        if (end > start) {
+            write_space();
+            output(data.substr(start, end - start), true);
+            written = true;
+        }
+    };
+
+    // spaces and erased bytes following a collapsed space belong to the same run
+    const auto skip_run = [&]() {
+        while (start < data.size() && (space_pending || !written)) {
+            const unsigned char action{this->actions[static_cast<unsigned char>(data[start])]};
+
+            if (action != Collapse && action != Erase) {
+                break;
+            }
+
+            space_pending = action == Collapse ? written : space_pending;
+            ++start;
+        }
+    };
+
+    skip_run();
+
+    for (size_type pos{this->find(data, start)}; pos != string_type::npos; pos = this->find(data, start)) {
+        flush(pos);
+
+        const unsigned char action{this->actions[static_cast<unsigned char>(data[pos])]};
+
+        if (action == Collapse) {
+            space_pending = written;
+        } else if (action >= Replace) {
+            write_space();
+            output(entities[action - Replace], false);
+            written = true;
+        }
+
+        start = pos + 1;
+        skip_run();
+    }
+
+    flush(data.size());
 
-    if (this->type == bygg::HTML::Type::Text_No_Formatting) {
-        return data_string;
-    } else if (this->type == bygg::HTML::Type::Text) {
-        for (size_type i{0}; i < tabc; i++) {
-            ret += "\t";
+    if (followed) {
+        write_space();
+    }
+}
+
+bool bygg::HTML::impl::TextTransform::required(const std::string_view data) const {
+    if (data.empty()) {
+        return false;
+    }
+
+    if (this->collapse_runs && (data.front() == ' ' || data.back() == ' ')) {
+        return true;
+    }
+
+    return this->find(data, 0) != string_type::npos;
+}
+
+void bygg::HTML::impl::TextTransform::write(Sink& sink, const std::string_view data, const bool escape) const {
+    this->run(data, [&sink, escape](const std::string_view str, const bool raw) {
+        if (escape && raw) {
+            write_escaped(sink, str);
+        } else {
+            sink.write(str.data(), str.size());
         }
+    });
+}
+
+void bygg::HTML::impl::TextTransform::write_part(Sink& sink, const std::string_view data, const bool preceded, const bool followed) const {
+    this->run(data, [&sink](const std::string_view str, bool) {
+        sink.write(str.data(), str.size());
+    }, preceded, followed);
+}
+
+bygg::size_type bygg::HTML::impl::TextTransform::measure(const std::string_view data, char& last, const bool escape) const {
+    size_type ret{};
+
+    this->run(data, [&ret, &last, escape](const std::string_view str, const bool raw) {
+        if (escape && raw) {
+            const size_type size{escaped_size(str)};
+            // an escaped final byte ends with the ; of its entity
+            last = size != str.size() && find_escape(str, str.size() - 1) != string_type::npos ? ';' : str.back();
+            ret += size;
+        } else {
+            ret += str.size();
+            last = str.back();
+        }
+    });
+
+    return ret;
+}
+
+bygg::string_type bygg::HTML::impl::TextTransform::apply(const std::string_view data) const {
+    string_type ret{};
+    ret.reserve(data.size());
 
-        return ret + data_string;
+    this->run(data, [&ret](const std::string_view str, bool) {
+        ret.append(str.data(), str.size());
+    });
+
+    return ret;
+}
+
+const bygg::HTML::impl::TextTransform& bygg::HTML::impl::get_transform(const ElementParameters params) {
+    // almost every element uses the same parameters as the one before it
+    thread_local const TextTransform* last{nullptr};
+    thread_local std::vector<std::unique_ptr<const TextTransform>> transforms{};
+
+    if (last != nullptr && last->get_params() == params) {
+        return *last;
     }
 
-    if (formatting == bygg::HTML::Formatting::Pretty) {
-        for (size_type i{0}; i < tabc; i++) {
-            ret += "\t";
+    for (const auto& it : transforms) {
+        if (it->get_params() == params) {
+            last = it.get();
+            return *last;
+        }
+    }
+
+    transforms.push_back(std::make_unique<const TextTransform>(params));
+    last = transforms.back().get();
+
+    return *last;
+}
+
+void bygg::HTML::impl::validate_parameters(const ElementParameters params) {
+    static_cast<void>(get_transform(params));
+}
+
+bool bygg::HTML::impl::requires_transform(const std::string_view data, const ElementParameters params) {
+    return get_transform(params).required(data);
+}
+
+bygg::string_type bygg::HTML::impl::apply_parameters(const std::string_view data, const ElementParameters params) {
+    return get_transform(params).apply(data);
+}
+
+bygg::string_type bygg::HTML::Element::get(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    bygg::string_type ret{};
+    ret.reserve(this->serialized_size(formatting, tabc, escaping));
+    StringSink sink{ret};
+
+    this->write_to(sink, formatting, tabc, escaping);
+
+    return ret;
+}
+
+void bygg::HTML::Element::write_to(Sink& sink, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    write(sink, this->tag, this->properties, this->data, this->type, this->params, formatting, tabc, escaping);
+}
+
+void bygg::HTML::Element::write(Sink& sink, const std::string_view tag, const Properties& properties, const std::string_view data, const Type type, const ElementParameters params, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) {
+    const impl::TextTransform& transform{impl::get_transform(params)};
+    const bool escape_data{escaping == Escaping::All};
+
+    if (type == bygg::HTML::Type::Text_No_Formatting) {
+        transform.write(sink, data, escape_data);
+        return;
+    } else if (type == bygg::HTML::Type::Text) {
+        if (tabc > 0) {
+            sink.fill('\t', static_cast<size_type>(tabc));
         }
+
+        transform.write(sink, data, escape_data);
+        return;
+    }
+
+    if (formatting == bygg::HTML::Formatting::Pretty && tabc > 0) {
+        sink.fill('\t', static_cast<size_type>(tabc));
     }
 
-    if (this->type == bygg::HTML::Type::Closing && !this->tag.empty()) {
-        ret += "</" + this->tag;
-    } else if (!this->tag.empty()) {
-        ret += "<" + this->tag;
+    if (type == bygg::HTML::Type::Closing && !tag.empty()) {
+        sink.write("</", 2);
+        sink.write(tag.data(), tag.size());
+    } else if (!tag.empty()) {
+        sink.put('<');
+        sink.write(tag.data(), tag.size());
     }
 
-    for (const Property& it : this->properties.get_properties()) {
-        if (it.get_key().empty() || it.get_value().empty() || this->tag.empty()) {
+    for (const Property& it : properties) {
+        if (it.get_key().empty() || it.get_value().empty() || tag.empty()) {
             continue;
         }
 
-        ret += " " + it.get();
+        sink.put(' ');
+        it.write_to(sink, escaping);
     }
 
-    if (this->type != bygg::HTML::Type::Standalone && this->type != bygg::HTML::Type::Closing && !this->tag.empty()) {
-        ret += ">";
+    if (type != bygg::HTML::Type::Standalone && type != bygg::HTML::Type::Closing && !tag.empty()) {
+        sink.put('>');
     }
 
-    if (this->type == bygg::HTML::Type::Data && !this->tag.empty()) {
-        ret += data_string + "</" + this->tag + ">";
-    } else if (this->type == bygg::HTML::Type::Standalone && !this->tag.empty()) {
-        ret += data_string + "/>";
-    } else if (this->type == bygg::HTML::Type::Closing && !this->tag.empty()) {
-        ret += ">";
+    if (type == bygg::HTML::Type::Data && !tag.empty()) {
+        transform.write(sink, data, escape_data);
+        sink.write("</", 2);
+        sink.write(tag.data(), tag.size());
+        sink.put('>');
+    } else if (type == bygg::HTML::Type::Standalone && !tag.empty()) {
+        transform.write(sink, data, escape_data);
+        sink.write("/>", 2);
+    } else if (type == bygg::HTML::Type::Closing && !tag.empty()) {
+        sink.put('>');
     }
 
     if (formatting == bygg::HTML::Formatting::Pretty || formatting == bygg::HTML::Formatting::Newline) {
-        ret += "\n";
+        sink.put('\n');
     }
+}
 
-    return ret;
+bygg::size_type bygg::HTML::Element::serialized_size(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    char last{};
+    return this->measure(formatting, tabc, escaping, last);
+}
+
+bygg::size_type bygg::HTML::Element::measure(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping, char& last) const {
+    const size_type indent{tabc > 0 ? static_cast<size_type>(tabc) : 0};
+
+    char data_last{};
+    const size_type data_size{impl::get_transform(this->params).measure(this->data, data_last, escaping == Escaping::All)};
+
+    if (this->type == bygg::HTML::Type::Text_No_Formatting || this->type == bygg::HTML::Type::Text) {
+        const size_type size{(this->type == bygg::HTML::Type::Text ? indent : 0) + data_size};
+
+        if (data_size > 0) {
+            last = data_last;
+        } else if (size > 0) {
+            last = '\t';
+        }
+
+        return size;
+    }
+
+    size_type size{formatting == bygg::HTML::Formatting::Pretty ? indent : 0};
+
+    if (!this->tag.empty()) {
+        size += (this->type == bygg::HTML::Type::Closing ? 2 : 1) + this->tag.size();
+
+        for (const Property& it : this->properties) {
+            if (!it.get_key().empty() && !it.get_value().empty()) {
+                size += it.serialized_size(escaping) + 1;
+            }
+        }
+
+        if (this->type == bygg::HTML::Type::Data) {
+            size += 1 + data_size + 2 + this->tag.size() + 1;
+        } else if (this->type == bygg::HTML::Type::Standalone) {
+            size += data_size + 2;
+        } else {
+            size += 1;
+        }
+
+        last = '>';
+    } else if (size > 0) {
+        last = '\t';
+    }
+
+    if (formatting == bygg::HTML::Formatting::Pretty || formatting == bygg::HTML::Formatting::Newline) {
+        size += 1;
+        last = '\n';
+    }
+
+    return size;
 }
 
 bygg::string_type bygg::HTML::Element::get_tag() const {
@@ -229,4 +546,5 @@ void bygg::HTML::Element::clear() {
     this->data.clear();
     this->properties.clear();
     this->params = _default_element_parameters;
+    this->parent.invalidate();
 }
\ No newline at end of file
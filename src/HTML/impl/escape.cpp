@@ -0,0 +1,137 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <array>
+#include <string_view>
+
+#include <bygg/HTML/impl/escape.hpp>
+#include <bygg/HTML/impl/simd.hpp>
+
+namespace {
+    /*
+     * Entity for each byte that is escaped, and nothing for every other byte.
+     */
+    constexpr std::array<std::string_view, 256> escape_table{[]() {
+        std::array<std::string_view, 256> ret{};
+        ret['&'] = "&amp;";
+        ret['<'] = "&lt;";
+        ret['>'] = "&gt;";
+        ret['"'] = "&quot;";
+        ret['\''] = "&apos;";
+        return ret;
+    }()};
+
+    bygg::size_type find_escape_scalar(const std::string_view data, bygg::size_type pos) {
+        for (; pos < data.size(); ++pos) {
+            if (!escape_table[static_cast<unsigned char>(data[pos])].empty()) {
+                return pos;
+            }
+        }
+
+        return std::string_view::npos;
+    }
+
+#ifdef BYGG_HAS_SSE2
+    bygg::size_type find_escape_sse2(const std::string_view data, bygg::size_type pos) {
+        const __m128i amp{_mm_set1_epi8('&')};
+        const __m128i lt{_mm_set1_epi8('<')};
+        const __m128i gt{_mm_set1_epi8('>')};
+        const __m128i quot{_mm_set1_epi8('"')};
+        const __m128i apos{_mm_set1_epi8('\'')};
+
+        for (; pos + 16 <= data.size(); pos += 16) {
+            const __m128i block{_mm_loadu_si128(reinterpret_cast<const __m128i*>(data.data() + pos))};
+            const __m128i match{_mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(block, amp), _mm_cmpeq_epi8(block, lt)),
+                _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, gt), _mm_cmpeq_epi8(block, quot)), _mm_cmpeq_epi8(block, apos))
+            )};
+
+            if (_mm_movemask_epi8(match) != 0) {
+                break;
+            }
+        }
+
+        return find_escape_scalar(data, pos);
+    }
+#endif
+
+#ifdef BYGG_HAS_AVX2_DISPATCH
+    __attribute__((target("avx2"))) bygg::size_type find_escape_avx2(const std::string_view data, bygg::size_type pos) {
+        const __m256i amp{_mm256_set1_epi8('&')};
+        const __m256i lt{_mm256_set1_epi8('<')};
+        const __m256i gt{_mm256_set1_epi8('>')};
+        const __m256i quot{_mm256_set1_epi8('"')};
+        const __m256i apos{_mm256_set1_epi8('\'')};
+
+        for (; pos + 32 <= data.size(); pos += 32) {
+            const __m256i block{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data.data() + pos))};
+            const __m256i match{_mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(block, amp), _mm256_cmpeq_epi8(block, lt)),
+                _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, gt), _mm256_cmpeq_epi8(block, quot)), _mm256_cmpeq_epi8(block, apos))
+            )};
+
+            const unsigned mask{static_cast<unsigned>(_mm256_movemask_epi8(match))};
+
+            if (mask != 0) {
+                return pos + static_cast<bygg::size_type>(__builtin_ctz(mask));
+            }
+        }
+
+        return find_escape_sse2(data, pos);
+    }
+#endif
+
+    using find_function = bygg::size_type (*)(std::string_view, bygg::size_type);
+
+    find_function select_find_escape() {
+#ifdef BYGG_HAS_AVX2_DISPATCH
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2")) {
+            return find_escape_avx2;
+        }
+#endif
+#ifdef BYGG_HAS_SSE2
+        return find_escape_sse2;
+#else
+        return find_escape_scalar;
+#endif
+    }
+} // namespace
+
+bygg::size_type bygg::HTML::impl::find_escape(const std::string_view data, const size_type pos) {
+    static const find_function function{select_find_escape()};
+    return function(data, pos);
+}
+
+void bygg::HTML::impl::write_escaped(Sink& sink, const std::string_view data) {
+    size_type start{0};
+
+    for (size_type pos{find_escape(data, 0)}; pos != std::string_view::npos; pos = find_escape(data, start)) {
+        if (pos > start) {
+            sink.write(data.data() + start, pos - start);
+        }
+
+        const std::string_view entity{escape_table[static_cast<unsigned char>(data[pos])]};
+        sink.write(entity.data(), entity.size());
+        start = pos + 1;
+    }
+
+    if (start < data.size()) {
+        sink.write(data.data() + start, data.size() - start);
+    }
+}
+
+bygg::size_type bygg::HTML::impl::escaped_size(const std::string_view data) {
+    size_type ret{data.size()};
+
+    for (size_type pos{find_escape(data, 0)}; pos != std::string_view::npos; pos = find_escape(data, pos + 1)) {
+        ret += escape_table[static_cast<unsigned char>(data[pos])].size() - 1;
+    }
+
+    return ret;
+}
@@ -6,85 +6,215 @@
  */
 
 #include <algorithm>
-#include <functional>
-#include <cstring>
+#include <cctype>
+#include <limits>
+#include <mutex>
+#include <utility>
 
 #include <bygg/except.hpp>
-#include <bygg/HTML/tag.hpp>
 #include <bygg/HTML/impl/libxml2.hpp>
 #include <libxml/HTMLparser.h>
-#include <libxml/xpath.h>
+#include <libxml/HTMLtree.h>
+#include <libxml/parserInternals.h>
 
-bygg::TagList bygg::parse_html_string(const string_type& html) {
-    TagList ret{};
-
-    LIBXML_TEST_VERSION
+/*
+ * SAX callbacks of the push parser. The user data of the context is the PushParser,
+ * and exceptions are kept rather than thrown through libxml2.
+ */
+struct bygg::PushParserCallbacks {
+    template <typename F> static void run(void* user_data, F&& function) {
+        auto& parser{*static_cast<PushParser*>(user_data)};
 
-    htmlDocPtr doc = htmlReadMemory(html.c_str(), static_cast<int>(html.size()), nullptr, "UTF-8", HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING);
+        if (parser.error) {
+            return;
+        }
 
-    if (doc == nullptr) {
-        throw invalid_argument("Failed to parse input string");
+        try {
+            function(parser);
+        } catch (...) {
+            parser.error = std::current_exception();
+            xmlStopParser(static_cast<htmlParserCtxtPtr>(parser.context));
+        }
     }
 
-    std::function<void(xmlNodePtr)> recursive_process_node = [&](xmlNodePtr node) {
-        for (xmlNodePtr current_node = node; current_node; current_node = current_node->next) {
-            if (current_node->type == XML_ELEMENT_NODE) {
-                string_type tag = reinterpret_cast<const char*>(current_node->name);
+    static void start_element(void* user_data, const xmlChar* name, const xmlChar** attributes) {
+        run(user_data, [name, attributes](PushParser& parser) {
+            parser.flush_text();
+            parser.attributes.clear();
 
-                HTML::Properties properties;
-                for (xmlAttrPtr attr = current_node->properties; attr; attr = attr->next) {
-                    string_type key = reinterpret_cast<const char*>(attr->name);
-                    xmlChar* value = xmlNodeGetContent(attr->children);
-                    properties.push_back(HTML::Property(key, reinterpret_cast<const char*>(value)));
-                    xmlFree(value);
-                }
+            for (size_type i{0}; attributes != nullptr && attributes[i] != nullptr; i += 2) {
+                const xmlChar* value{attributes[i + 1]};
 
-                string_type data{};
-                for (xmlNodePtr child = current_node->children; child; child = child->next) {
-                    if (child->type == XML_TEXT_NODE) {
-                        xmlChar* content = xmlNodeGetContent(child);
+                // the tree builder gives boolean attributes their own name as value
+                if (value == nullptr) {
+                    value = htmlIsBooleanAttr(attributes[i]) ? attributes[i] : reinterpret_cast<const xmlChar*>("");
+                }
 
-                        if (content && *content && !std::all_of(reinterpret_cast<const char*>(content), reinterpret_cast<const char*>(content) + std::strlen(reinterpret_cast<const char*>(content)), isspace)) {
-                            data += reinterpret_cast<const char*>(content);
-                        }
+                parser.attributes.push_back({reinterpret_cast<const char*>(attributes[i]), reinterpret_cast<const char*>(value)});
+            }
 
-                        xmlFree(content);
-                    } else if (child->type == XML_ELEMENT_NODE) {
-                        data += "<__bygg_placeholder_tag>";
-                    }
-                }
+            parser.handler.start_element(reinterpret_cast<const char*>(name), parser.attributes);
+        });
+    }
 
-                int depth{};
-                for (xmlNodePtr parent = current_node->parent; parent; parent = parent->parent) {
-                    if (parent->type == XML_ELEMENT_NODE) {
-                        ++depth;
-                    }
-                }
+    static void end_element(void* user_data, const xmlChar*) {
+        run(user_data, [](PushParser& parser) {
+            parser.flush_text();
+            parser.handler.end_element();
+        });
+    }
 
-                const auto get_type_from_tag = [&tag](bygg::HTML::Type& t) -> bool {
-                    try {
-                        const auto resolved = bygg::HTML::resolve_tag(tag);
-                        t = resolve_tag(resolved).second;
-                        return true;
-                    } catch (invalid_argument&) {
-                        return false;
-                    }
-                };
+    static void characters(void* user_data, const xmlChar* data, const int size) {
+        run(user_data, [data, size](PushParser& parser) {
+            parser.pending.append(reinterpret_cast<const char*>(data), static_cast<size_type>(size));
+        });
+    }
 
-                bygg::HTML::Type type{};
-                get_type_from_tag(type);
+    /* comments and processing instructions end the current text node */
+    static void comment(void* user_data, const xmlChar*) {
+        run(user_data, [](PushParser& parser) {
+            parser.flush_text();
+        });
+    }
 
-                ret.push_back({tag, type, data, properties, depth});
+    static void processing_instruction(void* user_data, const xmlChar*, const xmlChar*) {
+        comment(user_data, nullptr);
+    }
 
-                recursive_process_node(current_node->children);
+    /* the contents of scripts and styles, and blank text the parser considers ignorable, never become text nodes */
+    static void ignore(void*, const xmlChar*, int) {}
+
+    static const htmlSAXHandler& get_handler() {
+        static const htmlSAXHandler handler = []() {
+            htmlSAXHandler ret{};
+            ret.startElement = start_element;
+            ret.endElement = end_element;
+            ret.characters = characters;
+            ret.ignorableWhitespace = ignore;
+            ret.cdataBlock = ignore;
+            ret.comment = comment;
+            ret.processingInstruction = processing_instruction;
+            return ret;
+        }();
+
+        return handler;
+    }
+};
+
+namespace {
+    /*
+     * A context left by a finished parser, kept by each thread so that the next
+     * parser on the thread resets it instead of creating one. Contexts are never
+     * shared between threads, and libxml2's global state is never torn down.
+     */
+    struct CachedContext {
+        htmlParserCtxtPtr context{nullptr};
+
+        CachedContext() = default;
+        CachedContext(const CachedContext&) = delete;
+        CachedContext& operator=(const CachedContext&) = delete;
+        ~CachedContext() {
+            if (this->context != nullptr) {
+                htmlFreeParserCtxt(this->context);
             }
         }
     };
 
-    recursive_process_node(xmlDocGetRootElement(doc));
+    thread_local CachedContext cached_context{};
+
+    /* libxml2 is initialized once per process, before the first context is created */
+    void initialize() {
+        static std::once_flag flag{};
+        std::call_once(flag, []() {
+            LIBXML_TEST_VERSION
+        });
+    }
+} // namespace
+
+bygg::PushParser::PushParser(SAXHandler& handler) : handler(handler) {
+    htmlParserCtxtPtr ctxt{std::exchange(cached_context.context, nullptr)};
+
+    // the encoding is switched as htmlCreatePushParserCtxt() switches it, which still lets the document declare its charset
+    if (ctxt != nullptr && (xmlCtxtResetPush(ctxt, nullptr, 0, nullptr, nullptr) != 0 || xmlSwitchEncoding(ctxt, XML_CHAR_ENCODING_UTF8) != 0)) {
+        htmlFreeParserCtxt(ctxt);
+        ctxt = nullptr;
+    }
+
+    if (ctxt == nullptr) {
+        initialize();
+        ctxt = htmlCreatePushParserCtxt(const_cast<htmlSAXHandler*>(&PushParserCallbacks::get_handler()), this, nullptr, 0, nullptr, XML_CHAR_ENCODING_UTF8);
 
-    xmlFreeDoc(doc);
-    xmlCleanupParser();
+        if (ctxt == nullptr) {
+            throw internal_error("Failed to create parser");
+        }
+    }
+
+    ctxt->userData = this;
+    htmlCtxtUseOptions(ctxt, HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING);
+    this->context = ctxt;
+}
+
+bygg::PushParser::~PushParser() {
+    auto* ctxt{static_cast<htmlParserCtxtPtr>(this->context)};
+
+    // a context stopped by an exception is not reused
+    if (this->finished && !this->error && cached_context.context == nullptr) {
+        cached_context.context = ctxt;
+    } else {
+        htmlFreeParserCtxt(ctxt);
+    }
+}
+
+void bygg::PushParser::flush_text() {
+    const auto is_space = [](const char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+
+    if (!std::all_of(this->pending.begin(), this->pending.end(), is_space)) {
+        this->handler.text(this->pending);
+    }
+
+    this->pending.clear();
+}
+
+void bygg::PushParser::check() {
+    if (this->error) {
+        std::rethrow_exception(this->error);
+    }
+}
+
+void bygg::PushParser::feed(const char* data, size_type size) {
+    if (this->finished) {
+        throw invalid_argument("The parser has already finished");
+    }
+
+    // libxml2 takes the size as an int
+    constexpr size_type max{static_cast<size_type>(std::numeric_limits<int>::max())};
+
+    while (size > 0 && !this->error) {
+        const size_type count{std::min(size, max)};
+        htmlParseChunk(static_cast<htmlParserCtxtPtr>(this->context), data, static_cast<int>(count), 0);
+
+        data += count;
+        size -= count;
+    }
+
+    this->check();
+}
+
+void bygg::PushParser::finish() {
+    if (this->finished) {
+        throw invalid_argument("The parser has already finished");
+    }
+
+    this->finished = true;
+    htmlParseChunk(static_cast<htmlParserCtxtPtr>(this->context), nullptr, 0, 1);
+
+    if (!this->error) {
+        try {
+            this->flush_text();
+        } catch (...) {
+            this->error = std::current_exception();
+        }
+    }
 
-    return ret;
+    this->check();
 }
\ No newline at end of file
@@ -0,0 +1,119 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <atomic>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <system_error>
+#include <condition_variable>
+
+#include <bygg/HTML/impl/parallel.hpp>
+
+bygg::size_type bygg::HTML::impl::get_thread_count(const ParallelOptions& options) {
+    if (options.threads != 0) {
+        return options.threads;
+    }
+
+    const size_type hardware{std::thread::hardware_concurrency()};
+    return hardware == 0 ? 1 : hardware;
+}
+
+void bygg::HTML::impl::run_tasks(const size_type count, const std::function<void(size_type)>& task, const ParallelOptions& options) {
+    std::vector<std::exception_ptr> errors(count);
+
+    const auto run = [&task, &errors](const size_type index) {
+        try {
+            task(index);
+        } catch (...) {
+            errors[index] = std::current_exception();
+        }
+    };
+
+    if (count == 0) {
+        return;
+    }
+
+    if (options.executor) {
+        std::mutex mutex{};
+        std::condition_variable done{};
+        // the first task runs on the calling thread, the rest are submitted
+        size_type remaining{count - 1};
+
+        const auto finish = [&mutex, &done, &remaining](const size_type n) {
+            // notify while holding the lock, so the waiting thread cannot return
+            // and destroy the condition variable in between
+            std::lock_guard<std::mutex> lock{mutex};
+            remaining -= n;
+
+            if (remaining == 0) {
+                done.notify_all();
+            }
+        };
+
+        std::exception_ptr error{};
+
+        for (size_type i{1}; i < count; ++i) {
+            try {
+                options.executor([&run, &finish, i]() {
+                    run(i);
+                    finish(1);
+                });
+            } catch (...) {
+                // tasks that were already submitted still refer to this frame
+                error = std::current_exception();
+                finish(count - i);
+                break;
+            }
+        }
+
+        if (!error) {
+            run(0);
+        }
+
+        std::unique_lock<std::mutex> lock{mutex};
+        done.wait(lock, [&remaining]() { return remaining == 0; });
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    } else {
+        std::atomic<size_type> next{0};
+
+        const auto worker = [&run, &next, count]() {
+            for (size_type i{next++}; i < count; i = next++) {
+                run(i);
+            }
+        };
+
+        const size_type thread_count{std::min(get_thread_count(options), count)};
+        std::vector<std::thread> threads{};
+
+        // the calling thread takes part as well, so fewer threads than requested is fine
+        for (size_type i{1}; i < thread_count; ++i) {
+            try {
+                threads.emplace_back(worker);
+            } catch (const std::system_error&) {
+                break;
+            }
+        }
+
+        worker();
+
+        for (std::thread& it : threads) {
+            it.join();
+        }
+    }
+
+    for (const std::exception_ptr& it : errors) {
+        if (it) {
+            std::rethrow_exception(it);
+        }
+    }
+}
@@ -0,0 +1,861 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+
+#include <bygg/except.hpp>
+#include <bygg/HTML/tag.hpp>
+#include <bygg/HTML/impl/tokenizer.hpp>
+#include <bygg/HTML/impl/simd.hpp>
+
+namespace {
+    struct NamedReference {
+        std::string_view name{};
+        std::uint32_t value{};
+    };
+
+    /*
+     * The named character references libxml2 decodes, those of HTML 4, sorted by name.
+     */
+    constexpr NamedReference reference_table[]{
+        {"AElig", 198}, {"Aacute", 193}, {"Acirc", 194}, {"Agrave", 192}, {"Alpha", 913}, {"Aring", 197},
+        {"Atilde", 195}, {"Auml", 196}, {"Beta", 914}, {"Ccedil", 199}, {"Chi", 935}, {"Dagger", 8225}, {"Delta", 916},
+        {"ETH", 208}, {"Eacute", 201}, {"Ecirc", 202}, {"Egrave", 200}, {"Epsilon", 917}, {"Eta", 919}, {"Euml", 203},
+        {"Gamma", 915}, {"Iacute", 205}, {"Icirc", 206}, {"Igrave", 204}, {"Iota", 921}, {"Iuml", 207}, {"Kappa", 922},
+        {"Lambda", 923}, {"Mu", 924}, {"Ntilde", 209}, {"Nu", 925}, {"OElig", 338}, {"Oacute", 211}, {"Ocirc", 212},
+        {"Ograve", 210}, {"Omega", 937}, {"Omicron", 927}, {"Oslash", 216}, {"Otilde", 213}, {"Ouml", 214},
+        {"Phi", 934}, {"Pi", 928}, {"Prime", 8243}, {"Psi", 936}, {"Rho", 929}, {"Scaron", 352}, {"Sigma", 931},
+        {"THORN", 222}, {"Tau", 932}, {"Theta", 920}, {"Uacute", 218}, {"Ucirc", 219}, {"Ugrave", 217},
+        {"Upsilon", 933}, {"Uuml", 220}, {"Xi", 926}, {"Yacute", 221}, {"Yuml", 376}, {"Zeta", 918}, {"aacute", 225},
+        {"acirc", 226}, {"acute", 180}, {"aelig", 230}, {"agrave", 224}, {"alefsym", 8501}, {"alpha", 945}, {"amp", 38},
+        {"and", 8743}, {"ang", 8736}, {"apos", 39}, {"aring", 229}, {"asymp", 8776}, {"atilde", 227}, {"auml", 228},
+        {"bdquo", 8222}, {"beta", 946}, {"brvbar", 166}, {"bull", 8226}, {"cap", 8745}, {"ccedil", 231}, {"cedil", 184},
+        {"cent", 162}, {"chi", 967}, {"circ", 710}, {"clubs", 9827}, {"cong", 8773}, {"copy", 169}, {"crarr", 8629},
+        {"cup", 8746}, {"curren", 164}, {"dArr", 8659}, {"dagger", 8224}, {"darr", 8595}, {"deg", 176}, {"delta", 948},
+        {"diams", 9830}, {"divide", 247}, {"eacute", 233}, {"ecirc", 234}, {"egrave", 232}, {"empty", 8709},
+        {"emsp", 8195}, {"ensp", 8194}, {"epsilon", 949}, {"equiv", 8801}, {"eta", 951}, {"eth", 240}, {"euml", 235},
+        {"euro", 8364}, {"exist", 8707}, {"fnof", 402}, {"forall", 8704}, {"frac12", 189}, {"frac14", 188},
+        {"frac34", 190}, {"frasl", 8260}, {"gamma", 947}, {"ge", 8805}, {"gt", 62}, {"hArr", 8660}, {"harr", 8596},
+        {"hearts", 9829}, {"hellip", 8230}, {"iacute", 237}, {"icirc", 238}, {"iexcl", 161}, {"igrave", 236},
+        {"image", 8465}, {"infin", 8734}, {"int", 8747}, {"iota", 953}, {"iquest", 191}, {"isin", 8712}, {"iuml", 239},
+        {"kappa", 954}, {"lArr", 8656}, {"lambda", 955}, {"lang", 9001}, {"laquo", 171}, {"larr", 8592},
+        {"lceil", 8968}, {"ldquo", 8220}, {"le", 8804}, {"lfloor", 8970}, {"lowast", 8727}, {"loz", 9674},
+        {"lrm", 8206}, {"lsaquo", 8249}, {"lsquo", 8216}, {"lt", 60}, {"macr", 175}, {"mdash", 8212}, {"micro", 181},
+        {"middot", 183}, {"minus", 8722}, {"mu", 956}, {"nabla", 8711}, {"nbsp", 160}, {"ndash", 8211}, {"ne", 8800},
+        {"ni", 8715}, {"not", 172}, {"notin", 8713}, {"nsub", 8836}, {"ntilde", 241}, {"nu", 957}, {"oacute", 243},
+        {"ocirc", 244}, {"oelig", 339}, {"ograve", 242}, {"oline", 8254}, {"omega", 969}, {"omicron", 959},
+        {"oplus", 8853}, {"or", 8744}, {"ordf", 170}, {"ordm", 186}, {"oslash", 248}, {"otilde", 245}, {"otimes", 8855},
+        {"ouml", 246}, {"para", 182}, {"part", 8706}, {"permil", 8240}, {"perp", 8869}, {"phi", 966}, {"pi", 960},
+        {"piv", 982}, {"plusmn", 177}, {"pound", 163}, {"prime", 8242}, {"prod", 8719}, {"prop", 8733}, {"psi", 968},
+        {"quot", 34}, {"rArr", 8658}, {"radic", 8730}, {"rang", 9002}, {"raquo", 187}, {"rarr", 8594}, {"rceil", 8969},
+        {"rdquo", 8221}, {"real", 8476}, {"reg", 174}, {"rfloor", 8971}, {"rho", 961}, {"rlm", 8207}, {"rsaquo", 8250},
+        {"rsquo", 8217}, {"sbquo", 8218}, {"scaron", 353}, {"sdot", 8901}, {"sect", 167}, {"shy", 173}, {"sigma", 963},
+        {"sigmaf", 962}, {"sim", 8764}, {"spades", 9824}, {"sub", 8834}, {"sube", 8838}, {"sum", 8721}, {"sup", 8835},
+        {"sup1", 185}, {"sup2", 178}, {"sup3", 179}, {"supe", 8839}, {"szlig", 223}, {"tau", 964}, {"there4", 8756},
+        {"theta", 952}, {"thetasym", 977}, {"thinsp", 8201}, {"thorn", 254}, {"tilde", 732}, {"times", 215},
+        {"trade", 8482}, {"uArr", 8657}, {"uacute", 250}, {"uarr", 8593}, {"ucirc", 251}, {"ugrave", 249}, {"uml", 168},
+        {"upsih", 978}, {"upsilon", 965}, {"uuml", 252}, {"weierp", 8472}, {"xi", 958}, {"yacute", 253}, {"yen", 165},
+        {"yuml", 255}, {"zeta", 950}, {"zwj", 8205}, {"zwnj", 8204},
+    };
+
+    struct StartClose {
+        std::string_view tag{};
+        std::string_view closes{};
+    };
+
+    /*
+     * The open elements each opening tag closes, separated by spaces, as listed
+     * in libxml2's table. Only the innermost open element is checked, until it is
+     * one the tag does not close.
+     */
+    constexpr StartClose start_close_table[]{
+        {"a", "a head"},
+        {"abbr", "head"},
+        {"acronym", "head"},
+        {"address", "head p ul"},
+        {"b", "head"},
+        {"bdo", "head"},
+        {"big", "head"},
+        {"blockquote", "head p"},
+        {"body", "head link p style title"},
+        {"br", "head"},
+        {"caption", "p"},
+        {"center", "b font head i p"},
+        {"cite", "head"},
+        {"code", "head"},
+        {"col", "caption p"},
+        {"colgroup", "caption col colgroup p"},
+        {"dd", "address dir dt head menu p pre"},
+        {"dfn", "head"},
+        {"dir", "head p"},
+        {"div", "head p"},
+        {"dl", "address dir dt head menu p pre"},
+        {"dt", "address dd dir head menu p pre"},
+        {"em", "head"},
+        {"fieldset", "a h1 h2 h3 h4 h5 h6 head legend p pre"},
+        {"font", "head"},
+        {"form", "address dir dl form h1 h2 h3 h4 h5 h6 head hr menu ol p pre ul"},
+        {"frameset", "head link p style title"},
+        {"h1", "head p"},
+        {"h2", "head p"},
+        {"h3", "head p"},
+        {"h4", "head p"},
+        {"h5", "head p"},
+        {"h6", "head p"},
+        {"head", "p"},
+        {"hr", "head p"},
+        {"i", "head"},
+        {"iframe", "head"},
+        {"img", "head"},
+        {"kbd", "head"},
+        {"li", "address dl h1 h2 h3 h4 h5 h6 head li p pre"},
+        {"map", "head"},
+        {"menu", "head p ul"},
+        {"noscript", "script"},
+        {"ol", "head p ul"},
+        {"optgroup", "option"},
+        {"option", "option"},
+        {"p", "b big h1 h2 h3 h4 h5 h6 head i p s small strike tt u"},
+        {"pre", "head p ul"},
+        {"q", "head"},
+        {"s", "head"},
+        {"samp", "head"},
+        {"small", "head"},
+        {"span", "head"},
+        {"strike", "head"},
+        {"strong", "head"},
+        {"sub", "head"},
+        {"sup", "head"},
+        {"table", "a h1 h2 h3 h4 h5 h6 head p pre"},
+        {"tbody", "caption col colgroup p tbody td tfoot th thead tr"},
+        {"td", "a b font i p span td th u"},
+        {"tfoot", "caption col colgroup p tbody td th thead tr"},
+        {"th", "a b font i p span td th u"},
+        {"thead", "caption col colgroup"},
+        {"title", "p"},
+        {"tr", "caption col colgroup p td th tr"},
+        {"tt", "head"},
+        {"u", "head"},
+        {"ul", "address dir head menu ol p pre"},
+        {"var", "head"},
+    };
+
+    /*
+     * Attributes libxml2 gives their own name as value when they have none.
+     */
+    constexpr std::string_view boolean_attributes[]{
+        "checked", "compact", "declare", "defer", "disabled", "ismap", "multiple", "nohref", "noresize", "noshade",
+        "nowrap", "readonly", "selected",
+    };
+
+    constexpr bool validate_tables() {
+        for (bygg::size_type i{1}; i < std::size(reference_table); ++i) {
+            if (!(reference_table[i - 1].name < reference_table[i].name)) {
+                return false;
+            }
+        }
+        for (bygg::size_type i{1}; i < std::size(start_close_table); ++i) {
+            if (!(start_close_table[i - 1].tag < start_close_table[i].tag)) {
+                return false;
+            }
+        }
+        for (bygg::size_type i{1}; i < std::size(boolean_attributes); ++i) {
+            if (!(boolean_attributes[i - 1] < boolean_attributes[i])) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(validate_tables(), "reference_table, start_close_table and boolean_attributes must be sorted");
+
+    const bygg::SAXAttributes no_attributes{};
+
+    constexpr bool is_blank(const char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    constexpr bool is_letter(const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    constexpr bool is_digit(const char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    constexpr bool is_hex_digit(const char c) {
+        return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+    }
+
+    /* characters of tag, attribute and reference names */
+    constexpr bool is_name_start(const char c) {
+        return is_letter(c) || c == '_' || c == ':' || c == '.';
+    }
+
+    constexpr bool is_name(const char c) {
+        return is_name_start(c) || is_digit(c) || c == '-';
+    }
+
+    constexpr char lowercase(const char c) {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool is_all_blank(const std::string_view data) {
+        return std::all_of(data.begin(), data.end(), is_blank);
+    }
+
+    bool contains_tag(std::string_view list, const std::string_view tag) {
+        while (!list.empty()) {
+            const bygg::size_type pos{std::min(list.find(' '), list.size())};
+
+            if (list.substr(0, pos) == tag) {
+                return true;
+            }
+
+            list.remove_prefix(std::min(pos + 1, list.size()));
+        }
+
+        return false;
+    }
+
+    bool is_void(const std::string_view tag) {
+        // svg is standalone in the tag table, but its children are part of the document
+        return tag != "svg" && bygg::resolve_type(tag) == bygg::HTML::Type::Standalone;
+    }
+
+    /*
+     * Closing tags only close the elements between them and the element they close
+     * if none of those has a higher priority, as in libxml2.
+     */
+    int get_end_priority(const std::string_view tag) {
+        if (tag == "div") {
+            return 150;
+        } else if (tag == "td" || tag == "th") {
+            return 160;
+        } else if (tag == "tr") {
+            return 170;
+        } else if (tag == "thead" || tag == "tbody" || tag == "tfoot") {
+            return 180;
+        } else if (tag == "table") {
+            return 190;
+        } else if (tag == "head" || tag == "body") {
+            return 200;
+        } else if (tag == "html") {
+            return 220;
+        }
+
+        return 100;
+    }
+
+    void append_utf8(bygg::string_type& output, const std::uint32_t c) {
+        if (c < 0x80) {
+            output.push_back(static_cast<char>(c));
+        } else if (c < 0x800) {
+            output.push_back(static_cast<char>(0xC0 | (c >> 6)));
+            output.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else if (c < 0x10000) {
+            output.push_back(static_cast<char>(0xE0 | (c >> 12)));
+            output.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        } else {
+            output.push_back(static_cast<char>(0xF0 | (c >> 18)));
+            output.push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+        }
+    }
+
+    const char* find_either_scalar(const char* begin, const char* end, const char a, const char b) {
+        for (; begin < end; ++begin) {
+            if (*begin == a || *begin == b) {
+                return begin;
+            }
+        }
+
+        return end;
+    }
+
+    /*
+     * The first a or b in the range, or its end.
+     */
+    const char* find_either(const char* begin, const char* end, const char a, const char b) {
+#ifdef BYGG_HAS_SSE2
+        const __m128i first{_mm_set1_epi8(a)};
+        const __m128i second{_mm_set1_epi8(b)};
+
+        for (; end - begin >= 16; begin += 16) {
+            const __m128i block{_mm_loadu_si128(reinterpret_cast<const __m128i*>(begin))};
+            const __m128i match{_mm_or_si128(_mm_cmpeq_epi8(block, first), _mm_cmpeq_epi8(block, second))};
+
+            if (_mm_movemask_epi8(match) != 0) {
+                break;
+            }
+        }
+#endif
+
+        return find_either_scalar(begin, end, a, b);
+    }
+
+    enum class Match {
+        No,
+        Yes,
+        Partial, /* the data ends before the prefix does */
+    };
+
+    Match match_prefix(const std::string_view data, const std::string_view prefix) {
+        const bygg::size_type size{std::min(data.size(), prefix.size())};
+
+        for (bygg::size_type i{0}; i < size; ++i) {
+            if (lowercase(data[i]) != lowercase(prefix[i])) {
+                return Match::No;
+            }
+        }
+
+        return size == prefix.size() ? Match::Yes : Match::Partial;
+    }
+
+    /*
+     * Decode the reference at begin, which starts with &, into the output, and return
+     * where it ends, or nullptr if the input ends before it is known where it does.
+     * As in libxml2, numeric references need no semicolon and are dropped if they
+     * are not valid characters, and unknown names are kept as they are.
+     */
+    const char* decode_reference(const char* begin, const char* end, const bool final, bygg::string_type& output) {
+        const char* it{begin + 1};
+
+        if (it < end && *it == '#') {
+            ++it;
+
+            const bool hex{it < end && (*it == 'x' || *it == 'X')};
+            if (hex) {
+                ++it;
+            }
+
+            std::uint32_t value{0};
+            for (; it < end && (hex ? is_hex_digit(*it) : is_digit(*it)); ++it) {
+                const char c{lowercase(*it)};
+                const std::uint32_t digit{is_digit(c) ? static_cast<std::uint32_t>(c - '0') : static_cast<std::uint32_t>(c - 'a' + 10)};
+
+                value = std::min<std::uint32_t>(value * (hex ? 16 : 10) + digit, 0x110000);
+            }
+
+            if (it == end && !final) {
+                return nullptr;
+            }
+
+            if (it < end && *it == ';') {
+                ++it;
+            }
+
+            const bool valid{value == 0x9 || value == 0xA || value == 0xD || (value >= 0x20 && value <= 0xD7FF) ||
+                (value >= 0xE000 && value <= 0xFFFD) || (value >= 0x10000 && value <= 0x10FFFF)};
+
+            if (valid) {
+                append_utf8(output, value);
+            }
+
+            return it;
+        }
+
+        const char* name_end{it};
+        if (name_end < end && is_name_start(*name_end)) {
+            while (name_end < end && is_name(*name_end)) {
+                ++name_end;
+            }
+        }
+
+        if (name_end == end && !final) {
+            return nullptr;
+        }
+
+        const std::string_view name{it, static_cast<bygg::size_type>(name_end - it)};
+
+        if (!name.empty() && name_end < end && *name_end == ';') {
+            const auto* reference = bygg::HTML::impl::find_sorted(reference_table, name, [](const NamedReference& entry) { return entry.name; });
+
+            if (reference != nullptr) {
+                append_utf8(output, reference->value);
+                return name_end + 1;
+            }
+        }
+
+        output.push_back('&');
+        output.append(name);
+
+        return name_end;
+    }
+} // namespace
+
+bygg::Tokenizer::Tokenizer(SAXHandler& handler) : handler(handler) {}
+
+void bygg::Tokenizer::flush_text() {
+    if (!this->pending.empty() && !std::all_of(this->pending.begin(), this->pending.end(), [](const char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; })) {
+        this->handler.text(this->pending);
+    }
+
+    this->pending.clear();
+    this->run = 0;
+}
+
+void bygg::Tokenizer::push(const std::string_view tag, const SAXAttributes& attributes) {
+    this->flush_text();
+    this->open.emplace_back(tag);
+    this->raw = tag == "script" || tag == "style";
+
+    if (tag == "head") {
+        this->seen_head = true;
+    } else if (tag == "body") {
+        this->seen_body = true;
+    }
+
+    this->handler.start_element(tag, attributes);
+}
+
+void bygg::Tokenizer::pop() {
+    this->flush_text();
+    this->open.pop_back();
+    this->raw = !this->open.empty() && (this->open.back() == "script" || this->open.back() == "style");
+    this->handler.end_element();
+}
+
+void bygg::Tokenizer::auto_close(const std::string_view tag) {
+    const auto* entry = HTML::impl::find_sorted(start_close_table, tag, [](const StartClose& it) { return it.tag; });
+
+    if (entry == nullptr) {
+        return;
+    }
+
+    while (!this->open.empty() && contains_tag(entry->closes, this->open.back())) {
+        this->pop();
+    }
+}
+
+void bygg::Tokenizer::check_implied(const std::string_view tag) {
+    if (tag == "html") {
+        return;
+    }
+
+    if (this->open.empty()) {
+        this->push("html", no_attributes);
+    }
+
+    if (tag == "body" || tag == "head") {
+        return;
+    }
+
+    const bool head{tag == "script" || tag == "style" || tag == "meta" || tag == "link" || tag == "title" || tag == "base"};
+
+    if (head && this->open.size() <= 1) {
+        // no head is implied once a head or a body has been seen
+        if (!this->seen_head && !this->seen_body) {
+            this->push("head", no_attributes);
+        }
+    } else if (tag != "noframes" && tag != "frame" && tag != "frameset") {
+        if (this->seen_body) {
+            return;
+        }
+
+        for (const string_type& it : this->open) {
+            if (it == "body" || it == "head") {
+                return;
+            }
+        }
+
+        this->push("body", no_attributes);
+    }
+}
+
+void bygg::Tokenizer::check_paragraph() {
+    if (!this->open.empty() && this->open.back() != "html" && this->open.back() != "head") {
+        return;
+    }
+
+    // the text since the last tag is reported after the paragraph starts, and belongs to it
+    string_type text{this->pending.substr(this->run)};
+    this->pending.resize(this->run);
+
+    this->auto_close("p");
+    this->check_implied("p");
+    this->push("p", no_attributes);
+
+    this->pending = std::move(text);
+}
+
+void bygg::Tokenizer::characters(const std::string_view data) {
+    const bool implied{this->open.empty() || this->open.back() == "html" || this->open.back() == "head"};
+
+    if (implied && !is_all_blank(data)) {
+        this->check_paragraph();
+    }
+
+    this->pending.append(data);
+}
+
+void bygg::Tokenizer::start_tag(const std::string_view tag, const bool self_closing) {
+    this->auto_close(tag);
+    this->check_implied(tag);
+
+    // html inside the document, head outside html and body inside body are dropped
+    const bool misplaced{(tag == "html" && !this->open.empty()) || (tag == "head" && this->open.size() != 1) ||
+        (tag == "body" && std::find(this->open.begin(), this->open.end(), "body") != this->open.end())};
+
+    if (misplaced) {
+        ++this->misplaced;
+        return;
+    }
+
+    this->push(tag, this->attributes);
+
+    if (self_closing || is_void(tag)) {
+        this->pop();
+    }
+}
+
+void bygg::Tokenizer::end_tag(const std::string_view tag) {
+    if (this->misplaced > 0 && (tag == "html" || tag == "head" || tag == "body")) {
+        --this->misplaced;
+        return;
+    }
+
+    const auto it = std::find(this->open.rbegin(), this->open.rend(), tag);
+
+    if (it != this->open.rend()) {
+        const int priority{get_end_priority(tag)};
+        const bool closes{std::all_of(this->open.rbegin(), it, [priority](const string_type& open) { return get_end_priority(open) <= priority; })};
+
+        if (closes) {
+            const size_type depth{static_cast<size_type>(this->open.rend() - it) - 1};
+
+            while (this->open.size() > depth) {
+                this->pop();
+            }
+        }
+    }
+
+    if (this->open.empty()) {
+        this->ended = true;
+    }
+}
+
+const char* bygg::Tokenizer::parse_start_tag(const char* begin, const char* end, const bool final) {
+    const char* it{begin + 1};
+
+    this->values.clear();
+    this->ends.clear();
+
+    while (it < end && is_name(*it)) {
+        this->values.push_back(lowercase(*it++));
+    }
+
+    this->ends.push_back(this->values.size());
+
+    bool self_closing{false};
+
+    // as libxml2 does, the tag ends where the input does if it is never closed
+    while (true) {
+        while (it < end && is_blank(*it)) {
+            ++it;
+        }
+
+        if (it == end || (end - it == 1 && *it == '/')) {
+            if (!final) {
+                return nullptr;
+            }
+
+            it = end;
+            break;
+        } else if (*it == '>') {
+            ++it;
+            break;
+        } else if (*it == '/' && it[1] == '>') {
+            self_closing = true;
+            it += 2;
+            break;
+        } else if (!is_name_start(*it)) {
+            // anything that is not an attribute is skipped up to the next blank
+            while (it < end && !is_blank(*it) && *it != '>' && !(*it == '/' && end - it > 1 && it[1] == '>')) {
+                ++it;
+            }
+
+            continue;
+        }
+
+        const size_type key_begin{this->values.size()};
+
+        while (it < end && is_name(*it)) {
+            this->values.push_back(lowercase(*it++));
+        }
+
+        const size_type key_end{this->values.size()};
+
+        while (it < end && is_blank(*it)) {
+            ++it;
+        }
+
+        if (it < end && *it == '=') {
+            ++it;
+
+            while (it < end && is_blank(*it)) {
+                ++it;
+            }
+
+            if (it < end && (*it == '"' || *it == '\'')) {
+                const char quote{*it++};
+
+                for (const char* next{find_either(it, end, quote, '&')}; it < end && *it != quote; next = find_either(it, end, quote, '&')) {
+                    this->values.append(it, next);
+
+                    if (next < end && *next == '&') {
+                        next = decode_reference(next, end, final, this->values);
+
+                        if (next == nullptr) {
+                            return nullptr;
+                        }
+                    }
+
+                    it = next;
+                }
+
+                if (it < end) {
+                    ++it;
+                }
+            } else {
+                while (it < end && !is_blank(*it) && *it != '>') {
+                    if (*it == '&') {
+                        it = decode_reference(it, end, final, this->values);
+
+                        if (it == nullptr) {
+                            return nullptr;
+                        }
+                    } else {
+                        this->values.push_back(*it++);
+                    }
+                }
+            }
+        } else if (std::binary_search(std::begin(boolean_attributes), std::end(boolean_attributes), std::string_view{this->values.data() + key_begin, key_end - key_begin})) {
+            this->values.append(this->values, key_begin, key_end - key_begin);
+        }
+
+        if (it == end && !final) {
+            return nullptr;
+        }
+
+        // only the first of several attributes with the same key is kept
+        bool duplicate{false};
+        for (size_type i{1}; i + 1 < this->ends.size(); i += 2) {
+            if (std::string_view{this->values.data() + this->ends[i - 1], this->ends[i] - this->ends[i - 1]} == std::string_view{this->values.data() + key_begin, key_end - key_begin}) {
+                duplicate = true;
+                break;
+            }
+        }
+
+        if (duplicate) {
+            this->values.resize(key_begin);
+        } else {
+            this->ends.push_back(key_end);
+            this->ends.push_back(this->values.size());
+        }
+    }
+
+    // the keys and values are only pointed to once they are all written, as writing them may move them
+    this->attributes.clear();
+    for (size_type i{2}; i < this->ends.size(); i += 2) {
+        this->attributes.push_back({
+            std::string_view{this->values.data() + this->ends[i - 2], this->ends[i - 1] - this->ends[i - 2]},
+            std::string_view{this->values.data() + this->ends[i - 1], this->ends[i] - this->ends[i - 1]},
+        });
+    }
+
+    this->start_tag(std::string_view{this->values.data(), this->ends.front()}, self_closing);
+
+    return it;
+}
+
+const char* bygg::Tokenizer::parse_end_tag(const char* begin, const char* end, const bool final) {
+    const char* it{begin + 2};
+
+    if (it == end) {
+        return final ? end : nullptr;
+    }
+
+    // without a name, the </ is dropped and what follows it is text
+    if (!is_name_start(*it)) {
+        if (this->open.empty()) {
+            this->ended = true;
+        }
+
+        return it;
+    }
+
+    const char* close{static_cast<const char*>(std::memchr(it, '>', static_cast<size_type>(end - it)))};
+
+    if (close == nullptr && !final) {
+        return nullptr;
+    }
+
+    this->values.clear();
+    while (it < end && is_name(*it)) {
+        this->values.push_back(lowercase(*it++));
+    }
+
+    this->end_tag(this->values);
+
+    return close == nullptr ? end : close + 1;
+}
+
+bygg::size_type bygg::Tokenizer::parse(const char* begin, const char* end, const bool final) {
+    const char* it{begin};
+
+    while (it < end && !this->ended) {
+        if (this->comment) {
+            const std::string_view data{it, static_cast<size_type>(end - it)};
+            const size_type pos{data.find("-->")};
+
+            if (pos == std::string_view::npos) {
+                // the end of the input may be the start of -->
+                it = final ? end : end - std::min<size_type>(data.size(), 2);
+                break;
+            }
+
+            this->comment = false;
+            it += pos + 3;
+            continue;
+        }
+
+        if (this->raw) {
+            // the contents of scripts and styles run to the next </ followed by a letter, which is parsed as any
+            // closing tag; if it does not close the script, its contents go on after it
+            const char* next{it};
+
+            while ((next = static_cast<const char*>(std::memchr(next, '<', static_cast<size_type>(end - next)))) != nullptr) {
+                if (end - next < 3 && !final) {
+                    return static_cast<size_type>(next - begin);
+                } else if (end - next >= 3 && next[1] == '/' && is_letter(next[2])) {
+                    break;
+                }
+
+                ++next;
+            }
+
+            if (next == nullptr) {
+                it = end;
+                break;
+            }
+
+            it = next;
+        }
+
+        if (*it != '<' && *it != '&') {
+            const char* next{find_either(it, end, '<', '&')};
+
+            this->characters({it, static_cast<size_type>(next - it)});
+            it = next;
+            continue;
+        }
+
+        if (*it == '&') {
+            const size_type size{this->pending.size()};
+            const char* next{decode_reference(it, end, final, this->pending)};
+
+            if (next == nullptr) {
+                break;
+            }
+
+            // references are part of the text, so that they imply a paragraph even if they are blank
+            if (this->pending.size() != size) {
+                this->check_paragraph();
+            }
+
+            it = next;
+            continue;
+        }
+
+        const std::string_view data{it, static_cast<size_type>(end - it)};
+        const char* next{nullptr};
+
+        if (data.size() < 2 && !final) {
+            break;
+        } else if (data.size() >= 2 && is_letter(data[1])) {
+            next = this->parse_start_tag(it, end, final);
+        } else if (data.size() >= 2 && data[1] == '/') {
+            next = this->parse_end_tag(it, end, final);
+        } else if (const Match comment_match{match_prefix(data, "<!--")}; comment_match == Match::Yes) {
+            // comments end the current text node
+            this->flush_text();
+            this->comment = true;
+            next = it + 4;
+        } else if (const Match doctype_match{match_prefix(data, "<!doctype")}; doctype_match == Match::Yes || (data.size() >= 2 && data[1] == '?')) {
+            const char* close{static_cast<const char*>(std::memchr(it, '>', data.size()))};
+
+            if (close == nullptr && !final) {
+                break;
+            }
+
+            // as comments, processing instructions end the current text node
+            if (data[1] == '?') {
+                this->flush_text();
+            }
+
+            next = close == nullptr ? end : close + 1;
+        } else if ((comment_match == Match::Partial || doctype_match == Match::Partial) && !final) {
+            break;
+        } else {
+            // a < that starts no markup is text, but does not imply a paragraph
+            this->pending.push_back('<');
+            next = it + 1;
+        }
+
+        if (next == nullptr) {
+            break;
+        }
+
+        this->run = this->pending.size();
+        it = next;
+    }
+
+    // everything after the end of the document is ignored
+    return this->ended ? static_cast<size_type>(end - begin) : static_cast<size_type>(it - begin);
+}
+
+void bygg::Tokenizer::feed(const char* data, const size_type size) {
+    if (this->finished) {
+        throw invalid_argument("The parser has already finished");
+    }
+
+    // the input is only copied if it ends in the middle of a tag, reference or comment
+    if (this->buffer.empty()) {
+        const size_type count{this->parse(data, data + size, false)};
+        this->buffer.assign(data + count, size - count);
+    } else {
+        this->buffer.append(data, size);
+
+        const size_type count{this->parse(this->buffer.data(), this->buffer.data() + this->buffer.size(), false)};
+        this->buffer.erase(0, count);
+    }
+}
+
+void bygg::Tokenizer::finish() {
+    if (this->finished) {
+        throw invalid_argument("The parser has already finished");
+    }
+
+    this->finished = true;
+    this->parse(this->buffer.data(), this->buffer.data() + this->buffer.size(), true);
+    this->buffer.clear();
+
+    while (!this->open.empty()) {
+        this->pop();
+    }
+
+    this->flush_text();
+}
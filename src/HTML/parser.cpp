@@ -5,112 +5,525 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include <bygg/except.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/tag.hpp>
 #include <bygg/HTML/parser.hpp>
+#include <bygg/HTML/impl/sax.hpp>
+#include <bygg/HTML/impl/tokenizer.hpp>
+#include <bygg/HTML/impl/parallel.hpp>
+#include <bygg/HTML/impl/serialization.hpp>
+#ifdef BYGG_USE_LIBXML2
 #include <bygg/HTML/impl/libxml2.hpp>
-#include <stack>
+#endif
 
-bygg::HTML::Section bygg::HTML::Parser::parse_html_string(const string_type& html, const Options& options) {
-    Section container{Tag::Empty, make_properties()};
-    TagList list = bygg::parse_html_string(html);
+namespace {
+    /* the backend chosen with BYGG_PARSER_BACKEND */
+    constexpr bygg::HTML::Parser::Backend build_backend{
+#ifdef BYGG_PARSER_BACKEND_LIBXML2
+        bygg::HTML::Parser::Backend::Libxml2
+#else
+        bygg::HTML::Parser::Backend::Native
+#endif
+    };
 
-    std::stack<Section*> section_stack;
+    std::atomic<bygg::HTML::Parser::Backend> default_backend{build_backend};
 
-    section_stack.push(&container);
+    std::unique_ptr<bygg::SAXParser> make_parser(bygg::SAXHandler& handler, bygg::HTML::Parser::Backend backend) {
+        if (backend == bygg::HTML::Parser::Backend::Default) {
+            backend = default_backend.load(std::memory_order_relaxed);
+        }
 
-    for (size_t i = 0; i < list.size(); ++i) {
-        const auto& it = list[i];
-        bool is_container = bygg::HTML::is_container(it.tag);
+        if (!bygg::HTML::Parser::is_backend_available(backend)) {
+            throw bygg::invalid_argument("Backend not available");
+        }
 
-        while (section_stack.size() > it.depth + 1) {
-            section_stack.pop();
+#ifdef BYGG_USE_LIBXML2
+        if (backend == bygg::HTML::Parser::Backend::Libxml2) {
+            return std::make_unique<bygg::PushParser>(handler);
         }
+#endif
 
-        Section* current_section = section_stack.top();
-
-        if (is_container) {
-            current_section->push_back(Section(it.tag, it.properties));
-            section_stack.push(&current_section->back_section());
-        } else {
-            if (i > 0 && list[i].depth > list[i - 1].depth && list[i].data.empty() && list[i-1].data.empty() && options.consider_whitespace) {
-                Section new_sect = Section(it.tag, it.properties);
-                current_section->push_back(new_sect);
-                section_stack.push(&current_section->back_section());
-            } else {
-                // Utilize the <__bygg_placeholder_tag> marker to replace the inner tag with the actual tag
-                if (it.data.empty() == false && options.handle_inner_tags && it.data.find("<__bygg_placeholder_tag>") != string_type::npos) {
-                    string_type data = it.data;
-
-                    size_t inner = i + 1;
-                    while (inner < list.size() && list[inner].depth > it.depth) {
-                        Element inner_elem{};
-                        try {
-                            const auto tag_t = resolve_tag(resolve_tag(list[inner].tag)).second;
-                            inner_elem = Element(list[inner].tag,
-                                list[inner].properties,
-                                list[inner].data,
-                                options.assume_inner_tag_is_non_self_closing ?
-                                Type::Data : tag_t);
-                        } catch (std::exception&) {
-                            inner_elem = Element(list[inner].tag,
-                                list[inner].properties,
-                                list[inner].data,
-                                options.assume_inner_tag_is_non_self_closing ?
-                                Type::Data : list[inner].type);
-                        }
+        return std::make_unique<bygg::Tokenizer>(handler);
+    }
+} // namespace
 
-                        size_t pos = data.find("<__bygg_placeholder_tag>");
+bygg::HTML::Type bygg::resolve_type(const std::string_view tag) {
+    // looked up without resolve_tag(), as unknown tags are common and throwing is slow
+    const auto* it = HTML::impl::find_sorted(HTML::tag_name_table, tag, [](const std::pair<std::string_view, HTML::Tag>& entry) { return entry.first; });
+    return it == nullptr ? HTML::Type{} : HTML::get_tag_info(it->second).type;
+}
 
-                        if (pos == string_type::npos) {
-                            break;
-                        }
+namespace bygg::HTML::impl {
+    /*
+     * Builds sections from the elements the parser reports, in a single pass.
+     * Containers become sections as they start, and any other element becomes an
+     * element of the innermost section. Unless inner tags are handled separately,
+     * the elements inside such an element are written into its data as they are
+     * parsed, as Element::get() would write them, so each byte is copied once
+     * however deeply inline markup is nested.
+     */
+    class SectionBuilder : public SAXHandler {
+        private:
+            enum class Kind {
+                Container, /* a section, whose text is not kept */
+                Element, /* an element of a section */
+                Inner, /* an element written into the data of another */
+            };
 
-                        data.replace(pos, 24, inner_elem.get());
+            struct Entry {
+                Kind kind{Kind::Container};
+                Type type{Type::Data};
+                string_type tag{};
+                /* for inner elements, whether anything has been written before the text that follows */
+                bool preceded{false};
+                /* for elements of a section, where they were added, and their data if inner tags are handled separately */
+                Section* section{nullptr};
+                size_type index{};
+                string_type data{};
+            };
 
-                        ++inner;
-                    }
+            Parser::Options options{};
+            Section container{Tag::Empty, make_properties()};
+            /* the innermost section is chosen by depth, as with the tags of a flat list */
+            std::vector<Section*> sections{};
+            std::vector<Entry> open{};
 
-                    i = inner;
+            /* the data of the element inner elements are written into, and whether there are any */
+            string_type data{};
+            bool has_inner{false};
+            /* text of the innermost inner element, held until it is known what follows it */
+            string_type pending{};
 
-                    if (data.length() - 1 != string_type::npos && data.at(data.length() - 1) == ' ') {
-                        data.pop_back();
-                    }
+            void write_pending(Entry& entry, const bool followed) {
+                StringSink sink{this->data};
+                impl::get_transform(_default_element_parameters).write_part(sink, this->pending, entry.preceded, followed);
 
-                    if (data.find('\n') != string_type::npos && options.replace_newlines) {
-                        size_t pos = data.find('\n');
+                this->pending.clear();
+            }
+
+            void start_inner(const std::string_view tag, const SAXAttributes& attributes) {
+                Entry& parent{this->open.back()};
+
+                if (parent.kind == Kind::Inner) {
+                    this->write_pending(parent, true);
+                }
+
+                parent.preceded = true;
+                this->has_inner = true;
 
-                        while (pos != string_type::npos) {
-                            data.replace(pos, 1, " ");
-                            pos = data.find('\n');
+                const Type type{this->options.assume_inner_tag_is_non_self_closing ? Type::Data : resolve_type(tag)};
+
+                if (type != Type::Text) {
+                    StringSink sink{this->data};
+                    sink.put('<');
+                    sink.write(tag.data(), tag.size());
+
+                    // as Property::write_to() writes them, without making properties first
+                    for (const SAXAttribute& it : attributes) {
+                        if (!it.key.empty() && !it.value.empty()) {
+                            sink.put(' ');
+                            sink.write(it.key.data(), it.key.size());
+                            sink.write("=\"", 2);
+                            sink.write(it.value.data(), it.value.size());
+                            sink.put('"');
                         }
                     }
 
-                    current_section->push_back(Element(it.tag, it.properties, data, it.type));
+                    if (type == Type::Data) {
+                        sink.put('>');
+                    }
+                }
+
+                this->open.push_back({Kind::Inner, type, string_type{tag}});
+            }
+
+            void end_inner(Entry& entry) {
+                this->write_pending(entry, false);
+
+                if (entry.type == Type::Data) {
+                    this->data += "</";
+                    this->data += entry.tag;
+                    this->data += '>';
+                } else if (entry.type == Type::Standalone) {
+                    this->data += "/>";
+                }
+            }
+
+        public:
+            explicit SectionBuilder(const Parser::Options& options) : options(options) {
+                this->sections.push_back(&this->container);
+            }
+
+            Section& get_section() {
+                return this->container;
+            }
+
+            void start_element(const std::string_view tag, const SAXAttributes& attributes) override {
+                if (this->options.handle_inner_tags && !this->open.empty() && this->open.back().kind != Kind::Container) {
+                    this->start_inner(tag, attributes);
+                    return;
+                }
+
+                Properties properties{};
+                for (const SAXAttribute& it : attributes) {
+                    properties.push_back(Property(string_type{it.key}, string_type{it.value}));
+                }
+
+                while (this->sections.size() > this->open.size() + 1) {
+                    this->sections.pop_back();
+                }
+
+                Section& section{*this->sections.back()};
+
+                if (is_container(tag)) {
+                    section.push_back(Section(string_type{tag}, std::move(properties)));
+                    this->sections.push_back(&section.back_section());
+                    this->open.push_back({Kind::Container});
                 } else {
-                    string_type data = it.data;
+                    // added now, so that it comes before anything added while it is open
+                    section.push_back(Element(string_type{tag}, std::move(properties), {}, resolve_type(tag)));
+                    this->open.push_back({Kind::Element, Type::Data, {}, false, &section, section.size() - 1});
+                }
+            }
 
-                    if (data.find('\n') != string_type::npos && options.replace_newlines) {
-                        size_t pos = data.find('\n');
+            void end_element() override {
+                Entry& entry{this->open.back()};
 
-                        while (pos != string_type::npos) {
-                            data.replace(pos, 1, " ");
-                            pos = data.find('\n');
-                        }
-                    }
+                if (entry.kind == Kind::Inner) {
+                    this->end_inner(entry);
+                } else if (entry.kind == Kind::Element) {
+                    string_type& data{this->options.handle_inner_tags ? this->data : entry.data};
 
-                    if (data.find("<__bygg_placeholder_tag>") != string_type::npos) {
-                        size_t pos = data.find("<__bygg_placeholder_tag>");
+                    // a space the inner elements leave at the end is dropped
+                    if (this->has_inner && !data.empty() && data.back() == ' ') {
+                        data.pop_back();
+                    }
 
-                        while (pos != string_type::npos) {
-                            data.replace(pos, 24, "");
-                            pos = data.find("<__bygg_placeholder_tag>");
-                        }
+                    if (this->options.replace_newlines) {
+                        std::replace(data.begin(), data.end(), '\n', ' ');
                     }
 
-                    current_section->push_back(Element(it.tag, it.properties, data, it.type));
+                    std::get<Element>(entry.section->get_all()[entry.index]).set_data(std::move(data));
+
+                    data.clear();
+                    this->has_inner = false;
                 }
+
+                this->open.pop_back();
             }
+
+            void text(const std::string_view text) override {
+                // text directly inside containers is not kept
+                if (this->open.empty() || this->open.back().kind == Kind::Container) {
+                    return;
+                }
+
+                Entry& entry{this->open.back()};
+
+                if (entry.kind == Kind::Inner) {
+                    this->pending += text;
+                } else if (this->options.handle_inner_tags) {
+                    this->data += text;
+                } else {
+                    entry.data += text;
+                }
+            }
+    };
+} // namespace bygg::HTML::impl
+
+struct bygg::HTML::Parser::StreamParser::State {
+    impl::SectionBuilder builder;
+    std::unique_ptr<SAXParser> parser;
+
+    explicit State(const Options& options) : builder(options), parser(make_parser(builder, options.backend)) {}
+};
+
+bool bygg::HTML::Parser::is_backend_available(const Backend backend) {
+#ifdef BYGG_USE_LIBXML2
+    constexpr bool libxml2{true};
+#else
+    constexpr bool libxml2{false};
+#endif
+
+    return backend != Backend::Libxml2 || libxml2;
+}
+
+void bygg::HTML::Parser::set_default_backend(const Backend backend) {
+    if (!is_backend_available(backend)) {
+        throw invalid_argument("Backend not available");
+    }
+
+    default_backend.store(backend == Backend::Default ? build_backend : backend, std::memory_order_relaxed);
+}
+
+bygg::HTML::Parser::Backend bygg::HTML::Parser::get_default_backend() {
+    return default_backend.load(std::memory_order_relaxed);
+}
+
+bygg::HTML::Section bygg::HTML::Parser::parse_html_string(const string_type& html, const Options& options) {
+    if (html.empty()) {
+        throw invalid_argument("Failed to parse input string");
+    }
+
+    StreamParser parser{options};
+    parser.feed(html);
+
+    return parser.finish();
+}
+
+bygg::HTML::Section bygg::HTML::Parser::parse_html_stream(std::istream& stream, const Options& options) {
+    StreamParser parser{options};
+    std::vector<char> buffer(64 * 1024);
+
+    while (stream) {
+        stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        parser.feed(buffer.data(), static_cast<size_type>(stream.gcount()));
+    }
+
+    return parser.finish();
+}
+
+std::vector<bygg::HTML::Section> bygg::HTML::Parser::parse_many(const std::vector<string_type>& documents, const Options& options, const ParallelOptions& parallel) {
+    std::vector<Section> ret(documents.size());
+
+    impl::run_tasks(documents.size(), [&documents, &options, &ret](const size_type index) {
+        ret[index] = parse_html_string(documents[index], options);
+    }, parallel);
+
+    return ret;
+}
+
+std::vector<bygg::HTML::Section> bygg::HTML::Parser::parse_many_files(const std::vector<string_type>& paths, const Options& options, const ParallelOptions& parallel) {
+    std::vector<Section> ret(paths.size());
+
+    impl::run_tasks(paths.size(), [&paths, &options, &ret](const size_type index) {
+        std::ifstream file{paths[index], std::ios::binary};
+
+        if (!file.is_open()) {
+            throw invalid_argument("Failed to open file");
         }
+
+        ret[index] = parse_html_stream(file, options);
+    }, parallel);
+
+    return ret;
+}
+
+bygg::HTML::Parser::StreamParser::StreamParser(const Options& options) : state(std::make_unique<State>(options)) {}
+
+bygg::HTML::Parser::StreamParser::StreamParser(StreamParser&& parser) noexcept = default;
+
+bygg::HTML::Parser::StreamParser::~StreamParser() = default;
+
+bygg::HTML::Parser::StreamParser& bygg::HTML::Parser::StreamParser::operator=(StreamParser&& parser) noexcept = default;
+
+void bygg::HTML::Parser::StreamParser::feed(const char* data, const size_type size) {
+    if (!this->state) {
+        throw invalid_argument("The parser has already finished");
+    }
+
+    this->state->parser->feed(data, size);
+}
+
+void bygg::HTML::Parser::StreamParser::feed(const string_type& data) {
+    this->feed(data.data(), data.size());
+}
+
+bygg::HTML::Section bygg::HTML::Parser::StreamParser::finish() {
+    if (!this->state) {
+        throw invalid_argument("The parser has already finished");
+    }
+
+    const std::unique_ptr<State> state{std::move(this->state)};
+    state->parser->finish();
+
+    return std::move(state->builder.get_section());
+}
+
+/*
+ * Records the elements and text the parser reports into a document.
+ */
+struct bygg::HTML::Parser::ParsedDocument::Recorder : SAXHandler {
+    ParsedDocument& document;
+    /* the open elements */
+    std::vector<index_type> open{};
+
+    explicit Recorder(ParsedDocument& document) : document(document) {}
+
+    Span store(const std::string_view str) {
+        const Span span{this->document.text.size(), str.size()};
+        this->document.text.append(str);
+        return span;
+    }
+
+    index_type append(Node node) {
+        const auto index{static_cast<index_type>(this->document.nodes.size())};
+
+        node.parent = this->open.empty() ? npos : this->open.back();
+        node.end = index + 1;
+        this->document.nodes.push_back(node);
+
+        return index;
+    }
+
+    void start_element(const std::string_view tag, const SAXAttributes& attributes) override {
+        Node node{};
+        node.data = this->store(tag);
+        node.attribute_begin = static_cast<index_type>(this->document.attributes.size());
+        node.attribute_count = static_cast<index_type>(attributes.size());
+
+        for (const SAXAttribute& it : attributes) {
+            const Span key{this->store(it.key)};
+            const Span value{this->store(it.value)};
+
+            this->document.attributes.push_back({key, value});
+        }
+
+        this->open.push_back(this->append(node));
+    }
+
+    void end_element() override {
+        this->document.nodes[this->open.back()].end = static_cast<index_type>(this->document.nodes.size());
+        this->open.pop_back();
+    }
+
+    void text(const std::string_view text) override {
+        Node node{};
+        node.data = this->store(text);
+        node.text = true;
+
+        this->append(node);
+    }
+};
+
+bygg::HTML::Parser::ParsedDocument::ParsedDocument(const std::string_view html, std::pmr::memory_resource* resource, const Backend backend) : nodes(resource), attributes(resource), text(resource) {
+    // every tag starts with < and nearly every attribute has an =, and decoded text is no longer than
+    // the markup it came from, so this is close to the final size; the few elements the parser adds are not
+    this->nodes.reserve(static_cast<size_type>(std::count(html.begin(), html.end(), '<')) + 8);
+    this->attributes.reserve(static_cast<size_type>(std::count(html.begin(), html.end(), '=')) + 8);
+    this->text.reserve(html.size() + 64);
+
+    Recorder recorder{*this};
+    const std::unique_ptr<SAXParser> parser{make_parser(recorder, backend)};
+
+    parser->feed(html.data(), html.size());
+    parser->finish();
+
+    // elements left open at the end run to the end of the document
+    for (const index_type it : recorder.open) {
+        this->nodes[it].end = static_cast<index_type>(this->nodes.size());
+    }
+}
+
+bygg::HTML::Parser::ParsedDocument& bygg::HTML::Parser::ParsedDocument::operator=(const ParsedDocument& document) = default;
+
+bygg::HTML::Parser::ParsedDocument& bygg::HTML::Parser::ParsedDocument::operator=(ParsedDocument&& document) = default;
+
+const bygg::HTML::Parser::ParsedDocument::Node& bygg::HTML::Parser::ParsedDocument::at(const index_type index) const {
+    if (index >= this->nodes.size()) {
+        throw out_of_range("Index out of range");
+    }
+
+    return this->nodes[index];
+}
+
+std::string_view bygg::HTML::Parser::ParsedDocument::get_tag(const index_type index) const {
+    const Node& node{this->at(index)};
+    return node.text ? std::string_view{} : std::string_view{this->text}.substr(node.data.offset, node.data.size);
+}
+
+std::string_view bygg::HTML::Parser::ParsedDocument::get_text(const index_type index) const {
+    const Node& node{this->at(index)};
+    return node.text ? std::string_view{this->text}.substr(node.data.offset, node.data.size) : std::string_view{};
+}
+
+std::pair<std::string_view, std::string_view> bygg::HTML::Parser::ParsedDocument::get_attribute(const index_type index, const size_type attribute) const {
+    const Node& node{this->at(index)};
+
+    if (attribute >= node.attribute_count) {
+        throw out_of_range("Index out of range");
+    }
+
+    const Attribute& it{this->attributes[node.attribute_begin + attribute]};
+    const std::string_view text{this->text};
+
+    return {text.substr(it.key.offset, it.key.size), text.substr(it.value.offset, it.value.size)};
+}
+
+std::string_view bygg::HTML::Parser::ParsedDocument::find_attribute(const index_type index, const std::string_view key) const {
+    for (size_type i{0}; i < this->at(index).attribute_count; ++i) {
+        const auto [it_key, it_value] = this->get_attribute(index, i);
+
+        if (it_key == key) {
+            return it_value;
+        }
+    }
+
+    return {};
+}
+
+bygg::HTML::Properties bygg::HTML::Parser::ParsedDocument::get_properties(const index_type index) const {
+    Properties ret{};
+
+    for (size_type i{0}; i < this->at(index).attribute_count; ++i) {
+        const auto [key, value] = this->get_attribute(index, i);
+        ret.push_back(Property(string_type{key}, string_type{value}));
+    }
+
+    return ret;
+}
+
+bygg::size_type bygg::HTML::Parser::ParsedDocument::size() const {
+    return this->nodes.size();
+}
+
+bool bygg::HTML::Parser::ParsedDocument::empty() const {
+    return this->nodes.empty();
+}
+
+std::pmr::memory_resource* bygg::HTML::Parser::ParsedDocument::get_resource() const {
+    return this->nodes.get_allocator().resource();
+}
+
+bygg::HTML::Section bygg::HTML::Parser::ParsedDocument::to_section(const Options& options) const {
+    impl::SectionBuilder builder{options};
+    std::vector<index_type> open{};
+    SAXAttributes attributes{};
+
+    // the nodes are reported to the builder as the parser reported them
+    for (index_type i{0}; i < this->nodes.size(); ++i) {
+        while (!open.empty() && this->nodes[open.back()].end <= i) {
+            builder.end_element();
+            open.pop_back();
+        }
+
+        const Node& node{this->nodes[i]};
+
+        if (node.text) {
+            builder.text(this->get_text(i));
+            continue;
+        }
+
+        attributes.clear();
+        for (size_type j{0}; j < node.attribute_count; ++j) {
+            const auto [key, value] = this->get_attribute(i, j);
+            attributes.push_back({key, value});
+        }
+
+        builder.start_element(this->get_tag(i), attributes);
+        open.push_back(i);
+    }
+
+    for (; !open.empty(); open.pop_back()) {
+        builder.end_element();
     }
 
-    return container;
-}
\ No newline at end of file
+    return std::move(builder.get_section());
+}
@@ -19,6 +19,8 @@ bygg::HTML::Properties& bygg::HTML::Properties::operator=(const bygg::HTML::Prop
     return *this;
 }
 
+bygg::HTML::Properties& bygg::HTML::Properties::operator=(bygg::HTML::Properties&& properties) noexcept = default;
+
 bygg::HTML::Properties& bygg::HTML::Properties::operator=(const std::vector<bygg::HTML::Property>& properties) {
     this->set(properties);
     return *this;
@@ -86,8 +88,8 @@ bygg::HTML::Property bygg::HTML::Properties::at(const size_type index) const {
     return this->properties.at(index);
 }
 
-void bygg::HTML::Properties::set(const std::vector<bygg::HTML::Property>& properties) {
-    this->properties = properties;
+void bygg::HTML::Properties::set(std::vector<bygg::HTML::Property> properties) {
+    this->properties = std::move(properties);
 }
 
 void bygg::HTML::Properties::insert(const size_type index, const bygg::HTML::Property& property) {
@@ -98,6 +100,14 @@ void bygg::HTML::Properties::insert(const size_type index, const bygg::HTML::Pro
     this->properties.insert(this->properties.begin() + static_cast<long>(index), property);
 }
 
+void bygg::HTML::Properties::insert(const size_type index, bygg::HTML::Property&& property) {
+    if (index >= this->properties.size()) {
+        throw bygg::out_of_range("Index out of range");
+    }
+
+    this->properties.insert(this->properties.begin() + static_cast<long>(index), std::move(property));
+}
+
 void bygg::HTML::Properties::erase(const size_type index) {
     if (index >= this->properties.size()) {
         throw bygg::out_of_range("Index out of range");
@@ -110,10 +120,18 @@ void bygg::HTML::Properties::push_front(const bygg::HTML::Property& property) {
     this->properties.insert(this->properties.begin(), property);
 }
 
+void bygg::HTML::Properties::push_front(bygg::HTML::Property&& property) {
+    this->properties.insert(this->properties.begin(), std::move(property));
+}
+
 void bygg::HTML::Properties::push_back(const bygg::HTML::Property& property) {
     this->properties.push_back(property);
 }
 
+void bygg::HTML::Properties::push_back(bygg::HTML::Property&& property) {
+    this->properties.push_back(std::move(property));
+}
+
 bygg::size_type bygg::HTML::Properties::find(const bygg::HTML::Property& property, const size_type begin) const {
     for (size_type i{0}; i < this->properties.size(); i++) {
         if ((this->properties.at(i).get_value().find(property.get_value()) != bygg::string_type::npos
@@ -7,6 +7,7 @@
 
 #include <bygg/HTML/property.hpp>
 #include <bygg/HTML/properties.hpp>
+#include <bygg/HTML/impl/escape.hpp>
 
 bygg::string_type bygg::HTML::Property::get_key() const {
     return this->property.first;
@@ -16,24 +17,49 @@ bygg::string_type bygg::HTML::Property::get_value() const {
     return this->property.second;
 }
 
-bygg::string_type bygg::HTML::Property::get() const {
-    return this->get_key() + "=\"" + this->get_value() + "\"";
+bygg::string_type bygg::HTML::Property::get(const Escaping escaping) const {
+    bygg::string_type ret{};
+    ret.reserve(this->serialized_size(escaping));
+    StringSink sink{ret};
+
+    this->write_to(sink, escaping);
+
+    return ret;
 }
 
-void bygg::HTML::Property::set_key(const bygg::string_type& key) {
-    this->property.first = key;
+void bygg::HTML::Property::write_to(Sink& sink, const Escaping escaping) const {
+    sink.write(this->property.first);
+    sink.write("=\"", 2);
+
+    if (escaping == Escaping::None) {
+        sink.write(this->property.second);
+    } else {
+        impl::write_escaped(sink, this->property.second);
+    }
+
+    sink.put('"');
 }
 
-void bygg::HTML::Property::set_value(const bygg::string_type& value) {
-    this->property.second = value;
+bygg::size_type bygg::HTML::Property::serialized_size(const Escaping escaping) const {
+    const size_type value{escaping == Escaping::None ? this->property.second.size() : impl::escaped_size(this->property.second)};
+    return this->property.first.size() + 2 + value + 1;
 }
 
-void bygg::HTML::Property::set(const std::pair<bygg::string_type, bygg::string_type>& property) {
-    this->property = property;
+void bygg::HTML::Property::set_key(bygg::string_type key) {
+    this->property.first = std::move(key);
 }
 
-void bygg::HTML::Property::set(const bygg::string_type& key, const bygg::string_type& value) {
-    this->property = std::make_pair(key, value);
+void bygg::HTML::Property::set_value(bygg::string_type value) {
+    this->property.second = std::move(value);
+}
+
+void bygg::HTML::Property::set(std::pair<bygg::string_type, bygg::string_type> property) {
+    this->property = std::move(property);
+}
+
+void bygg::HTML::Property::set(bygg::string_type key, bygg::string_type value) {
+    this->property.first = std::move(key);
+    this->property.second = std::move(value);
 }
 
 bygg::HTML::Property& bygg::HTML::Property::operator=(const bygg::HTML::Property& property) {
@@ -41,6 +67,8 @@ bygg::HTML::Property& bygg::HTML::Property::operator=(const bygg::HTML::Property
     return *this;
 }
 
+bygg::HTML::Property& bygg::HTML::Property::operator=(bygg::HTML::Property&& property) noexcept = default;
+
 bool bygg::HTML::Property::operator==(const bygg::HTML::Property& property) const {
     return this->property.first == property.get_key() && this->property.second == property.get_value();
 }
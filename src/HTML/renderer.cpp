@@ -0,0 +1,166 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <bygg/sink.hpp>
+#include <bygg/HTML/renderer.hpp>
+
+bygg::HTML::Renderer::Renderer(const Section& section, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) : formatting(formatting), escaping(escaping) {
+    this->s_stack.push({&section, tabc, 0, false});
+}
+
+bygg::HTML::Renderer::Renderer(const Document& document, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) : Renderer(document.document, formatting, tabc, escaping) {
+    // the doctype is written as is, so its newline is kept even if nothing follows
+    this->buffer = document.doctype;
+
+    if (formatting == Formatting::Pretty || formatting == Formatting::Newline) {
+        this->buffer.push_back('\n');
+    }
+
+    this->data = this->buffer;
+}
+
+void bygg::HTML::Renderer::step() {
+    this->buffer.clear();
+    this->data = {};
+    this->offset = 0;
+
+    StringSink sink{this->buffer};
+
+    Entry& c_entry{this->s_stack.top()};
+    const Section* c_sect{c_entry.section};
+    const bool pretty{this->formatting == Formatting::Pretty};
+    const bool newline{pretty || this->formatting == Formatting::Newline};
+
+    if (!c_entry.opened) {
+        if (c_sect->tag.empty() && c_sect->properties.empty() && c_sect->members.empty()) {
+            this->s_stack.pop();
+            return;
+        }
+
+        if (const string_type* cached{c_sect->find_cache(this->formatting, c_entry.tabc, this->escaping)}) {
+            this->data = *cached;
+            this->flush = c_sect->flush_point;
+            this->s_stack.pop();
+            return;
+        }
+
+        c_entry.opened = true;
+
+        if (!c_sect->tag.empty()) {
+            if (pretty && c_entry.tabc > 0) {
+                sink.fill('\t', static_cast<size_type>(c_entry.tabc));
+            }
+
+            sink.put('<');
+            sink.write(c_sect->tag);
+
+            for (const Property& it : c_sect->properties) {
+                if (!it.get_key().empty() && !it.get_value().empty()) {
+                    sink.put(' ');
+                    it.write_to(sink, this->escaping);
+                }
+            }
+
+            sink.put('>');
+
+            if (newline) {
+                sink.put('\n');
+            }
+        }
+
+        this->data = this->buffer;
+        return;
+    }
+
+    if (c_entry.index < c_sect->members.size()) {
+        const Section::variant_t& member{c_sect->members[c_entry.index++]};
+        const integer_type tabc{c_sect->tag.empty() ? c_entry.tabc : c_entry.tabc + 1};
+
+        if (const auto* element = std::get_if<Element>(&member)) {
+            element->write_to(sink, this->formatting, tabc, this->escaping);
+            this->data = this->buffer;
+        } else if (const auto* section = std::get_if<Section>(&member)) {
+            this->s_stack.push({section, tabc, 0, false});
+        } else if (const auto* shared = std::get_if<SharedSection>(&member)) {
+            this->s_stack.push({&shared->get_section(), tabc, 0, false});
+        }
+
+        return;
+    }
+
+    if (!c_sect->tag.empty()) {
+        if (pretty && c_entry.tabc > 0) {
+            sink.fill('\t', static_cast<size_type>(c_entry.tabc));
+        }
+
+        sink.write("</", 2);
+        sink.write(c_sect->tag);
+        sink.put('>');
+
+        if (newline) {
+            sink.put('\n');
+        }
+    }
+
+    this->data = this->buffer;
+    this->flush = c_sect->flush_point;
+    this->s_stack.pop();
+}
+
+bygg::size_type bygg::HTML::Renderer::next_chunk(char* buffer, const size_type capacity) {
+    size_type written{0};
+
+    while (written < capacity) {
+        if (this->lead) {
+            buffer[written++] = '\n';
+            this->lead = false;
+            continue;
+        }
+
+        if (this->offset < this->data.size()) {
+            const size_type count{std::min(capacity - written, this->data.size() - this->offset)};
+            std::memcpy(buffer + written, this->data.data() + this->offset, count);
+
+            written += count;
+            this->offset += count;
+            continue;
+        }
+
+        if (this->flush) {
+            this->flush = false;
+
+            if (written != 0) {
+                break;
+            }
+        }
+
+        if (this->s_stack.empty()) {
+            break;
+        }
+
+        this->step();
+
+        // like TrimmingSink, a trailing newline is only written once more output follows it
+        if (!this->data.empty()) {
+            this->lead = this->newline;
+            this->newline = this->data.back() == '\n';
+
+            if (this->newline) {
+                this->data.remove_suffix(1);
+            }
+        }
+    }
+
+    return written;
+}
+
+bool bygg::HTML::Renderer::done() const {
+    return this->s_stack.empty() && this->offset == this->data.size() && !this->lead;
+}
@@ -6,25 +6,66 @@
  */
 
 #include <algorithm>
-#include <sstream>
 #include <stack>
+#include <string_view>
 
 #include <bygg/except.hpp>
+#include <bygg/sink.hpp>
 #include <bygg/HTML/tag.hpp>
 #include <bygg/HTML/section.hpp>
+#include <bygg/HTML/impl/serialization.hpp>
+#include <bygg/HTML/impl/parallel.hpp>
+#include <bygg/HTML/impl/hash.hpp>
+
+bygg::HTML::Section& bygg::HTML::Section::operator=(const bygg::HTML::Section& section) {
+    this->tag = section.tag;
+    this->properties = section.properties;
+    this->members = section.members;
+    this->cache_enabled = section.cache_enabled;
+    this->index_enabled = section.index_enabled;
+    this->flush_point = section.flush_point;
+    this->link(0);
+    this->invalidate_cache();
+    return *this;
+}
 
-bygg::HTML::Section& bygg::HTML::Section::operator=(const bygg::HTML::Section& section) = default;
+bygg::HTML::Section& bygg::HTML::Section::operator=(bygg::HTML::Section&& section) noexcept {
+    this->tag = std::move(section.tag);
+    this->properties = std::move(section.properties);
+    this->members = std::move(section.members);
+    this->cache_enabled = section.cache_enabled;
+    this->index_enabled = section.index_enabled;
+    this->flush_point = section.flush_point;
+    this->link(0);
+    this->invalidate_cache();
+    return *this;
+}
 
 bygg::HTML::Section& bygg::HTML::Section::operator+=(const bygg::HTML::Element& element) {
     this->push_back(element);
     return *this;
 }
 
+bygg::HTML::Section& bygg::HTML::Section::operator+=(bygg::HTML::Element&& element) {
+    this->push_back(std::move(element));
+    return *this;
+}
+
 bygg::HTML::Section& bygg::HTML::Section::operator+=(const bygg::HTML::Section& section) {
     this->push_back(section);
     return *this;
 }
 
+bygg::HTML::Section& bygg::HTML::Section::operator+=(bygg::HTML::Section&& section) {
+    this->push_back(std::move(section));
+    return *this;
+}
+
+bygg::HTML::Section& bygg::HTML::Section::operator+=(const bygg::HTML::SharedSection& section) {
+    this->push_back(section);
+    return *this;
+}
+
 bygg::HTML::Section::variant_t bygg::HTML::Section::operator[](const bygg::integer_type& index) const {
     if (this->members.size() <= index) {
         throw out_of_range("Index out of range");
@@ -44,69 +85,120 @@ bool bygg::HTML::Section::operator==(const bygg::HTML::Section& section) const {
 }
 
 bool bygg::HTML::Section::operator==(const bygg::HTML::Element& element) const {
-    return std::any_of(this->get_elements().begin(), this->get_elements().end(),
+    return std::any_of(this->element_begin(), this->element_end(),
                    [&element](const bygg::HTML::Element& it) {
                        return it.get() == element.get();
                    });
 }
 
 bool bygg::HTML::Section::operator!=(const bygg::HTML::Section& section) const {
-    return this->tag != section.tag || this->properties != section.properties || this->members != section.members;
+    return !(*this == section);
 }
 
 bool bygg::HTML::Section::operator!=(const bygg::HTML::Element& element) const {
-    return std::any_of(this->get_elements().begin(), this->get_elements().end(), [&element](const Element& it) {
+    return std::any_of(this->element_begin(), this->element_end(), [&element](const Element& it) {
         return it.get() == element.get();
     });
 }
 
-void bygg::HTML::Section::set(const bygg::string_type& tag, const Properties& properties) {
-    this->tag = tag;
-    this->properties = properties;
+void bygg::HTML::Section::set(bygg::string_type tag, Properties properties) {
+    this->tag = std::move(tag);
+    this->properties = std::move(properties);
+    this->invalidate_cache();
 }
 
-void bygg::HTML::Section::set_tag(const bygg::string_type& tag) {
-    this->tag = tag;
+void bygg::HTML::Section::set_tag(bygg::string_type tag) {
+    this->tag = std::move(tag);
+    this->invalidate_cache();
 }
 
 void bygg::HTML::Section::set_tag(const Tag tag) {
-    std::pair<bygg::string_type, bygg::HTML::Type> resolved{resolve_tag(tag)};
-    this->tag = resolved.first;
+    this->tag = get_tag_info(tag).name;
+    this->invalidate_cache();
 }
 
-void bygg::HTML::Section::set_properties(const Properties& properties) {
-    this->properties = properties;
+void bygg::HTML::Section::set_properties(Properties properties) {
+    this->properties = std::move(properties);
+    this->invalidate_cache();
 }
 
-void bygg::HTML::Section::set(const Tag tag, const Properties& properties) {
-    this->tag = resolve_tag(tag).first;
-    this->properties = properties;
+void bygg::HTML::Section::set(const Tag tag, Properties properties) {
+    this->tag = get_tag_info(tag).name;
+    this->properties = std::move(properties);
+    this->invalidate_cache();
 }
 
 void bygg::HTML::Section::push_front(const Element& element) {
+    const variant_t* previous{this->members.data()};
     this->members.insert(this->members.begin(), element);
+    this->adopt(previous, 0);
+}
+
+void bygg::HTML::Section::push_front(Element&& element) {
+    const variant_t* previous{this->members.data()};
+    this->members.insert(this->members.begin(), std::move(element));
+    this->adopt(previous, 0);
 }
 
 void bygg::HTML::Section::push_front(const Section& section) {
+    const variant_t* previous{this->members.data()};
     this->members.insert(this->members.begin(), section);
+    this->adopt(previous, 0);
+}
+
+void bygg::HTML::Section::push_front(Section&& section) {
+    const variant_t* previous{this->members.data()};
+    this->members.insert(this->members.begin(), std::move(section));
+    this->adopt(previous, 0);
+}
+
+void bygg::HTML::Section::push_front(const SharedSection& section) {
+    const variant_t* previous{this->members.data()};
+    this->members.insert(this->members.begin(), section);
+    this->adopt(previous, 0);
 }
 
 void bygg::HTML::Section::push_back(const Element& element) {
+    const variant_t* previous{this->members.data()};
     this->members.push_back(element);
+    this->adopt(previous, this->members.size() - 1);
+}
+
+void bygg::HTML::Section::push_back(Element&& element) {
+    const variant_t* previous{this->members.data()};
+    this->members.emplace_back(std::move(element));
+    this->adopt(previous, this->members.size() - 1);
 }
 
 void bygg::HTML::Section::push_back(const Section& section) {
+    const variant_t* previous{this->members.data()};
+    this->members.push_back(section);
+    this->adopt(previous, this->members.size() - 1);
+}
+
+void bygg::HTML::Section::push_back(Section&& section) {
+    const variant_t* previous{this->members.data()};
+    this->members.emplace_back(std::move(section));
+    this->adopt(previous, this->members.size() - 1);
+}
+
+void bygg::HTML::Section::push_back(const SharedSection& section) {
+    const variant_t* previous{this->members.data()};
     this->members.push_back(section);
+    this->adopt(previous, this->members.size() - 1);
 }
 
 void bygg::HTML::Section::push_back(const Properties& properties) {
     for (const auto& it : properties) {
         this->properties.push_back(it);
     }
+
+    this->invalidate_cache();
 }
 
 void bygg::HTML::Section::push_back(const Property &property) {
     this->properties.push_back(property);
+    this->invalidate_cache();
 }
 
 void bygg::HTML::Section::push_back(const ElementList& elements) {
@@ -115,12 +207,24 @@ void bygg::HTML::Section::push_back(const ElementList& elements) {
     }
 }
 
+void bygg::HTML::Section::push_back(ElementList&& elements) {
+    for (auto& it : elements) {
+        this->push_back(std::move(it));
+    }
+}
+
 void bygg::HTML::Section::push_back(const SectionList& sections) {
     for (const auto& it : sections) {
         this->push_back(it);
     }
 }
 
+void bygg::HTML::Section::push_back(SectionList&& sections) {
+    for (auto& it : sections) {
+        this->push_back(std::move(it));
+    }
+}
+
 
 void bygg::HTML::Section::erase(const size_type index) {
     if (this->members.size() <= index) {
@@ -128,14 +232,18 @@ void bygg::HTML::Section::erase(const size_type index) {
     }
 
     this->members.erase(this->members.begin() + static_cast<long>(index));
+    this->adopt(this->members.data(), index);
 }
 
 void bygg::HTML::Section::erase(const Section& section) {
-    for (size_type i{0}; i < this->size(); i++) {
-        const Section it = this->get_sections().at(i);
-
-        if (it.get() == section.get()) {
-            this->erase(i);
+    const string_type target{section.get()};
+
+    for (auto it = this->section_begin(); it != this->section_end(); ++it) {
+        // measuring is much cheaper than serializing, and rules out most members
+        if (it->serialized_size() == target.size() && it->get() == target) {
+            const auto index{static_cast<size_type>(it.base() - this->members.begin())};
+            this->members.erase(it.base());
+            this->adopt(this->members.data(), index);
             return;
         }
     }
@@ -144,11 +252,13 @@ void bygg::HTML::Section::erase(const Section& section) {
 }
 
 void bygg::HTML::Section::erase(const Element& element) {
-    for (size_type i{0}; i < this->size(); i++) {
-        const Element it = this->get_elements().at(i);
+    const string_type target{element.get()};
 
-        if (it.get() == element.get()) {
-            this->erase(i);
+    for (auto it = this->element_begin(); it != this->element_end(); ++it) {
+        if (it->serialized_size() == target.size() && it->get() == target) {
+            const auto index{static_cast<size_type>(it.base() - this->members.begin())};
+            this->members.erase(it.base());
+            this->adopt(this->members.data(), index);
             return;
         }
     }
@@ -156,6 +266,23 @@ void bygg::HTML::Section::erase(const Element& element) {
     throw out_of_range("Element not found");
 }
 
+bygg::HTML::Section::iterator bygg::HTML::Section::erase(const const_iterator first, const const_iterator last) {
+    const auto index{static_cast<size_type>(first - this->members.cbegin())};
+
+    if (first > last || index > this->members.size() || static_cast<size_type>(last - this->members.cbegin()) > this->members.size()) {
+        throw out_of_range("Index out of range");
+    }
+
+    if (first == last) {
+        return this->members.begin() + static_cast<long>(index);
+    }
+
+    this->members.erase(first, last);
+    this->adopt(this->members.data(), index);
+
+    return this->members.begin() + static_cast<long>(index);
+}
+
 void bygg::HTML::Section::insert(const size_type index, const Element& element) {
     std::size_t i{0};
     for (const auto& it : this->members) {
@@ -165,11 +292,41 @@ void bygg::HTML::Section::insert(const size_type index, const Element& element)
         ++i;
     }
 
+    const variant_t* previous{this->members.data()};
     this->members.push_back(element);
+    this->adopt(previous, this->members.size() - 1);
+}
+
+void bygg::HTML::Section::insert(const size_type index, Element&& element) {
+    std::size_t i{0};
+    for (const auto& it : this->members) {
+        if (std::holds_alternative<Section>(it) && i == index) {
+            throw invalid_argument("Index already occupied by a section");
+        }
+        ++i;
+    }
+
+    const variant_t* previous{this->members.data()};
+    this->members.push_back(std::move(element));
+    this->adopt(previous, this->members.size() - 1);
 }
 
 void bygg::HTML::Section::insert(const size_type index, const Section& section) {
+    const variant_t* previous{this->members.data()};
     this->members.insert(this->members.begin() + static_cast<long>(index), section);
+    this->adopt(previous, index);
+}
+
+void bygg::HTML::Section::insert(const size_type index, Section&& section) {
+    const variant_t* previous{this->members.data()};
+    this->members.insert(this->members.begin() + static_cast<long>(index), std::move(section));
+    this->adopt(previous, index);
+}
+
+void bygg::HTML::Section::insert(const size_type index, const SharedSection& section) {
+    const variant_t* previous{this->members.data()};
+    this->members.insert(this->members.begin() + static_cast<long>(index), section);
+    this->adopt(previous, index);
 }
 
 bygg::HTML::Element bygg::HTML::Section::at(const size_type index) const {
@@ -282,7 +439,7 @@ bygg::size_type bygg::HTML::Section::find(const bygg::string_type& str, const si
             }
 
             if (index >= begin) {
-                const Element element = std::get<Element>(it);
+                const Element& element = std::get<Element>(it);
 
                 if (((element.get_tag() == str && (params & FindParameters::Search_Tag)) ||
                     (element.get_data() == str && (params & FindParameters::Search_Data)) ||
@@ -307,7 +464,7 @@ bygg::size_type bygg::HTML::Section::find(const bygg::string_type& str, const si
             }
 
             if (index >= begin) {
-                const Section section = std::get<Section>(it);
+                const Section& section = std::get<Section>(it);
 
                 if (((section.get_tag() == str && (params & FindParameters::Search_Tag)) ||
                     (section.get() == str && (params & FindParameters::Search_Deserialized)) ||
@@ -329,6 +486,8 @@ bygg::size_type bygg::HTML::Section::find(const bygg::HTML::Tag tag, const size_
         throw invalid_argument("Search parameters must not include both FindParameters::Only_Sections and FindParameters::Only_Elements");
     }
 
+    const std::string_view name{get_tag_info(tag).name};
+
     if (!(params & FindParameters::Only_Sections)) {
         size_type index{};
 
@@ -339,9 +498,9 @@ bygg::size_type bygg::HTML::Section::find(const bygg::HTML::Tag tag, const size_
             }
 
             if (index >= begin) {
-                const Element element = std::get<Element>(it);
+                const Element& element = std::get<Element>(it);
 
-                if (element.get_tag() == resolve_tag(tag).first) {
+                if (element.tag == name) {
                     return index;
                 }
             }
@@ -360,9 +519,9 @@ bygg::size_type bygg::HTML::Section::find(const bygg::HTML::Tag tag, const size_
             }
 
             if (index >= begin) {
-                const Section section = std::get<Section>(it);
+                const Section& section = std::get<Section>(it);
 
-                if (section.get_tag() == resolve_tag(tag).first) {
+                if (section.tag == name) {
                     return index;
                 }
             }
@@ -392,7 +551,7 @@ bygg::size_type bygg::HTML::Section::find(const bygg::HTML::Properties& properti
             }
 
             if (index >= begin) {
-                const Element element = std::get<Element>(it);
+                const Element& element = std::get<Element>(it);
 
                 if (element.get_properties() == properties) {
                     return index;
@@ -413,7 +572,7 @@ bygg::size_type bygg::HTML::Section::find(const bygg::HTML::Properties& properti
             }
 
             if (index >= begin) {
-                const Section section = std::get<Section>(it);
+                const Section& section = std::get<Section>(it);
 
                 if (section.get_properties() == properties) {
                     return index;
@@ -444,7 +603,7 @@ bygg::size_type bygg::HTML::Section::find(const bygg::HTML::Property& property,
             }
 
             if (index >= begin) {
-                const Element element = std::get<Element>(it);
+                const Element& element = std::get<Element>(it);
 
                 if (element.get_properties().find(property) != npos) {
                     return index;
@@ -456,18 +615,15 @@ bygg::size_type bygg::HTML::Section::find(const bygg::HTML::Property& property,
     }
 
     if (!(params & FindParameters::Only_Elements)) {
-        for (size_type i{0}; i < this->members.size(); i++) {
+        for (size_type i{begin}; i < this->members.size(); i++) {
             if (!std::holds_alternative<Section>(this->members.at(i))) {
-                ++i;
                 continue;
             }
 
-            if (i >= begin) {
-                const Section section = std::get<Section>(this->members.at(i));
+            const Section& section = std::get<Section>(this->members.at(i));
 
-                if (section.get_properties().find(property) != npos) {
-                    return i;
-                }
+            if (section.get_properties().find(property) != npos) {
+                return i;
             }
         }
     }
@@ -583,8 +739,7 @@ void bygg::HTML::Section::clear() {
     this->tag.clear();
     this->properties.clear();
     this->members.clear();
-    this->sections.clear();
-    this->elements.clear();
+    this->invalidate_cache();
 }
 
 bool bygg::HTML::Section::empty() const {
@@ -592,37 +747,381 @@ bool bygg::HTML::Section::empty() const {
 }
 
 bygg::HTML::ElementList bygg::HTML::Section::get_elements() const {
-    bygg::HTML::ElementList ret{};
-    for (const auto& it : this->members) {
-        if (std::holds_alternative<Element>(it)) {
-            ret.push_back(std::get<Element>(it));
+    return {this->element_cbegin(), this->element_cend()};
+}
+
+bygg::HTML::SectionList bygg::HTML::Section::get_sections() const {
+    return {this->section_cbegin(), this->section_cend()};
+}
+
+namespace {
+    /*
+     * Forwards to another sink, and appends everything written to the output
+     * of each section that is currently being cached.
+     */
+    class RecordingSink : public bygg::Sink {
+            bygg::Sink& sink;
+            std::vector<bygg::string_type*> recordings{};
+        public:
+            explicit RecordingSink(bygg::Sink& sink) : sink(sink) {}
+
+            void write(const char* data, const bygg::size_type size) override {
+                this->sink.write(data, size);
+
+                for (bygg::string_type* it : this->recordings) {
+                    it->append(data, size);
+                }
+            }
+            void begin(bygg::string_type& target) {
+                this->recordings.push_back(&target);
+            }
+            void end() {
+                this->recordings.pop_back();
+            }
+            [[nodiscard]] bool active() const {
+                return !this->recordings.empty();
+            }
+            using bygg::Sink::write;
+    };
+
+    /* discards everything written to it, for serializing only to fill caches */
+    class DiscardingSink : public bygg::Sink {
+        public:
+            void write(const char*, bygg::size_type) override {}
+            using bygg::Sink::write;
+    };
+} // namespace
+
+void bygg::HTML::impl::ParentLink::invalidate() const noexcept {
+    if (this->section != nullptr) {
+        this->section->invalidate_cache();
+    }
+}
+
+void bygg::HTML::Section::enable_cache(const bool enable) {
+    this->cache_enabled = enable;
+
+    if (!enable) {
+        this->cache.clear();
+    }
+}
+
+void bygg::HTML::Section::prepare_cache(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) {
+    DiscardingSink sink{};
+    this->serialize(sink, formatting, tabc, escaping, false, false, nullptr);
+}
+
+bool bygg::HTML::Section::is_cache_enabled() const {
+    return this->cache_enabled;
+}
+
+void bygg::HTML::Section::invalidate_cache() const noexcept {
+    for (const Section* it{this}; it != nullptr; it = it->parent.section) {
+        if (it->index) {
+            it->index->stale = true;
+        }
+
+        // sections above a dirty one are dirty too, unless an index further up still has to be told
+        if (it->dirty && !it->indexed) {
+            break;
         }
+
+        it->dirty = true;
+        it->hashed = false;
+        it->cache.clear();
     }
-    return ret;
 }
 
-bygg::HTML::SectionList bygg::HTML::Section::get_sections() const {
-    bygg::HTML::SectionList ret{};
+const bygg::string_type* bygg::HTML::Section::find_cache(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    if (this->dirty) {
+        return nullptr;
+    }
 
-    for (const auto& it : this->members) {
-        if (std::holds_alternative<Section>(it)) {
-            ret.push_back(std::get<Section>(it));
+    for (const CacheEntry& it : this->cache) {
+        if (it.formatting == formatting && it.tabc == tabc && it.escaping == escaping) {
+            return &it.data;
         }
     }
 
-    return ret;
+    return nullptr;
+}
+
+void bygg::HTML::Section::enable_index(const bool enable) {
+    this->index_enabled = enable;
+
+    if (enable || !this->index) {
+        return;
+    }
+
+    this->index.reset();
+
+    // forget the sections this index visited, so that changes to them stop at dirty sections again
+    std::stack<const Section*> s_stack{};
+    s_stack.push(this);
+
+    while (!s_stack.empty()) {
+        const Section* section{s_stack.top()};
+        s_stack.pop();
+
+        for (const variant_t& member : section->members) {
+            if (const auto* child = std::get_if<Section>(&member)) {
+                child->indexed = false;
+                s_stack.push(child);
+            }
+        }
+    }
+
+    // an index further up may have visited the same sections, so it has to mark them again
+    for (const Section* it{this->parent.section}; it != nullptr; it = it->parent.section) {
+        if (it->index) {
+            it->index->stale = true;
+        }
+    }
+}
+
+bool bygg::HTML::Section::is_index_enabled() const {
+    return this->index_enabled;
 }
 
-bygg::string_type bygg::HTML::Section::get(const Formatting formatting, const bygg::integer_type tabc) const {
-    std::ostringstream ret{};
+void bygg::HTML::Section::set_flush_point(const bool flush) {
+    this->flush_point = flush;
+}
 
+bool bygg::HTML::Section::is_flush_point() const {
+    return this->flush_point;
+}
+
+void bygg::HTML::Section::build_index(Index& index, const bool mark) const {
     struct Entry {
         const Section* section{nullptr};
-        bygg::integer_type tabc{tabc};
+        size_type index{};
+    };
+
+    index.ids.clear();
+    index.classes.clear();
+    index.tags.clear();
+
+    const auto add = [&index](variant_t& member, const string_type& tag, const Properties& properties) {
+        if (!tag.empty()) {
+            index.tags[tag].push_back(&member);
+        }
+
+        for (const Property& it : properties) {
+            const string_type& key{it.property.first};
+            const string_type& value{it.property.second};
+
+            if (key == "id" && !value.empty()) {
+                // the first member with an id wins, as in document order
+                index.ids.emplace(value, &member);
+            } else if (key == "class") {
+                constexpr std::string_view whitespace{" \t\n\f\r"};
+
+                for (size_type begin{value.find_first_not_of(whitespace)}; begin != string_type::npos;) {
+                    const size_type end{std::min(value.find_first_of(whitespace, begin), value.size())};
+                    std::vector<variant_t*>& members{index.classes[value.substr(begin, end - begin)]};
+
+                    if (members.empty() || members.back() != &member) {
+                        members.push_back(&member);
+                    }
+
+                    begin = value.find_first_not_of(whitespace, end);
+                }
+            }
+        }
+    };
+
+    std::stack<Entry> s_stack{};
+    s_stack.push({this, 0});
+
+    while (!s_stack.empty()) {
+        Entry& c_entry{s_stack.top()};
+
+        if (c_entry.index == c_entry.section->members.size()) {
+            s_stack.pop();
+            continue;
+        }
+
+        variant_t& member{c_entry.section->members[c_entry.index++]};
+
+        if (const auto* element = std::get_if<Element>(&member)) {
+            add(member, element->tag, element->properties);
+        } else if (const auto* section = std::get_if<Section>(&member)) {
+            if (mark) {
+                section->indexed = true;
+            }
+
+            add(member, section->tag, section->properties);
+            s_stack.push({section, 0});
+        }
+    }
+
+    index.stale = false;
+}
+
+const bygg::HTML::Section::Index& bygg::HTML::Section::get_index(Index& scratch) const {
+    if (!this->index_enabled) {
+        this->build_index(scratch, false);
+        return scratch;
+    }
+
+    if (!this->index) {
+        this->index = std::make_unique<Index>();
+    }
+
+    if (this->index->stale) {
+        this->build_index(*this->index, true);
+    }
+
+    return *this->index;
+}
+
+bygg::HTML::Section::variant_t* bygg::HTML::Section::get_by_id(const string_type& id) {
+    Index scratch{};
+    const Index& index{this->get_index(scratch)};
+
+    const auto it{index.ids.find(id)};
+    return it == index.ids.end() ? nullptr : it->second;
+}
+
+const bygg::HTML::Section::variant_t* bygg::HTML::Section::get_by_id(const string_type& id) const {
+    Index scratch{};
+    const Index& index{this->get_index(scratch)};
+
+    const auto it{index.ids.find(id)};
+    return it == index.ids.end() ? nullptr : it->second;
+}
+
+std::vector<bygg::HTML::Section::variant_t*> bygg::HTML::Section::get_by_class(const string_type& name) {
+    Index scratch{};
+    const Index& index{this->get_index(scratch)};
+
+    const auto it{index.classes.find(name)};
+    return it == index.classes.end() ? std::vector<variant_t*>{} : it->second;
+}
+
+std::vector<const bygg::HTML::Section::variant_t*> bygg::HTML::Section::get_by_class(const string_type& name) const {
+    Index scratch{};
+    const Index& index{this->get_index(scratch)};
+
+    const auto it{index.classes.find(name)};
+    return it == index.classes.end() ? std::vector<const variant_t*>{} : std::vector<const variant_t*>(it->second.begin(), it->second.end());
+}
+
+std::vector<bygg::HTML::Section::variant_t*> bygg::HTML::Section::get_by_tag(const string_type& tag) {
+    Index scratch{};
+    const Index& index{this->get_index(scratch)};
+
+    const auto it{index.tags.find(tag)};
+    return it == index.tags.end() ? std::vector<variant_t*>{} : it->second;
+}
+
+std::vector<const bygg::HTML::Section::variant_t*> bygg::HTML::Section::get_by_tag(const string_type& tag) const {
+    Index scratch{};
+    const Index& index{this->get_index(scratch)};
+
+    const auto it{index.tags.find(tag)};
+    return it == index.tags.end() ? std::vector<const variant_t*>{} : std::vector<const variant_t*>(it->second.begin(), it->second.end());
+}
+
+std::vector<bygg::HTML::Section::variant_t*> bygg::HTML::Section::get_by_tag(const Tag tag) {
+    return this->get_by_tag(string_type{get_tag_info(tag).name});
+}
+
+std::vector<const bygg::HTML::Section::variant_t*> bygg::HTML::Section::get_by_tag(const Tag tag) const {
+    return this->get_by_tag(string_type{get_tag_info(tag).name});
+}
+
+std::uint64_t bygg::HTML::Section::get_hash() const {
+    if (this->hashed) {
+        return this->hash;
+    }
+
+    struct Entry {
+        const Section* section{nullptr};
+        size_type index{};
+        std::uint64_t hash{};
+    };
+
+    std::stack<Entry> s_stack{};
+
+    // sections are cleaned as they are hashed, as they are when recorded into a cache
+    const auto push = [&s_stack](const Section* section) {
+        section->dirty = false;
+        section->link(0);
+
+        const std::uint64_t seed{impl::hash_combine(impl::section_seed, impl::hash_string(section->tag))};
+        s_stack.push({section, 0, Element::hash_properties(seed, section->properties)});
+    };
+
+    push(this);
+
+    while (true) {
+        Entry& c_entry{s_stack.top()};
+        const Section* c_sect{c_entry.section};
+
+        if (c_entry.index == c_sect->members.size()) {
+            c_sect->hash = impl::hash_combine(c_entry.hash, c_sect->members.size());
+            c_sect->hashed = true;
+            s_stack.pop();
+
+            if (s_stack.empty()) {
+                return c_sect->hash;
+            }
+
+            s_stack.top().hash = impl::hash_combine(s_stack.top().hash, c_sect->hash);
+            continue;
+        }
+
+        const variant_t& member{c_sect->members[c_entry.index++]};
+
+        if (const auto* element = std::get_if<Element>(&member)) {
+            c_entry.hash = impl::hash_combine(c_entry.hash, element->get_hash());
+        } else if (const auto* section = std::get_if<Section>(&member)) {
+            if (section->hashed) {
+                c_entry.hash = impl::hash_combine(c_entry.hash, section->hash);
+            } else {
+                push(section);
+            }
+        } else if (const auto* shared = std::get_if<SharedSection>(&member)) {
+            c_entry.hash = impl::hash_combine(c_entry.hash, shared->hash);
+        }
+    }
+}
+
+void bygg::HTML::Section::link(size_type first) const noexcept {
+    for (; first < this->members.size(); ++first) {
+        if (auto* element = std::get_if<Element>(&this->members[first])) {
+            element->parent.set(this);
+        } else if (auto* section = std::get_if<Section>(&this->members[first])) {
+            section->parent.set(this);
+        } else if (auto* shared = std::get_if<SharedSection>(&this->members[first])) {
+            shared->parent.set(this);
+        }
+    }
+}
+
+void bygg::HTML::Section::adopt(const variant_t* previous, const size_type first) noexcept {
+    // if the members were reallocated, every member has to be linked again
+    this->link(previous == this->members.data() ? first : 0);
+    this->invalidate_cache();
+}
+
+bygg::size_type bygg::HTML::Section::serialized_size(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    struct Entry {
+        const Section* section{nullptr};
+        bygg::integer_type tabc{};
         bool processed{false};
         size_type index{};
     };
 
+    const bool newline{formatting == bygg::HTML::Formatting::Pretty || formatting == bygg::HTML::Formatting::Newline};
+    const auto indent = [&formatting](const bygg::integer_type count) -> size_type {
+        return formatting == bygg::HTML::Formatting::Pretty && count > 0 ? static_cast<size_type>(count) : 0;
+    };
+
+    size_type ret{};
+    char last{};
+
     std::stack<Entry> s_stack{};
     s_stack.push({this, tabc, false});
 
@@ -637,25 +1136,31 @@ bygg::string_type bygg::HTML::Section::get(const Formatting formatting, const by
                 continue;
             }
 
-            if (formatting == bygg::HTML::Formatting::Pretty && !c_sect->tag.empty()) {
-                for (size_type i{0}; i < c_tabc; i++) {
-                    ret << "\t";
+            if (const string_type* cached{c_sect->find_cache(formatting, c_tabc, escaping)}) {
+                ret += cached->size();
+
+                if (!cached->empty()) {
+                    last = cached->back();
                 }
+
+                s_stack.pop();
+                continue;
             }
 
             if (!c_sect->tag.empty()) {
-                ret << "<" + c_sect->tag;
+                ret += indent(c_tabc) + 1 + c_sect->tag.size() + 1;
 
-                for (const Property& it : c_sect->properties.get_properties()) {
+                for (const Property& it : c_sect->properties) {
                     if (!it.get_key().empty() && !it.get_value().empty()) {
-                        ret << " " + it.get_key() + "=\"" + it.get_value() + "\"";
+                        ret += 1 + it.serialized_size(escaping);
                     }
                 }
 
-                ret << ">";
+                last = '>';
 
-                if (formatting == bygg::HTML::Formatting::Pretty || formatting == bygg::HTML::Formatting::Newline) {
-                    ret << "\n";
+                if (newline) {
+                    ret += 1;
+                    last = '\n';
                 }
             }
 
@@ -669,7 +1174,7 @@ bygg::string_type bygg::HTML::Section::get(const Formatting formatting, const by
 
             if (std::holds_alternative<Element>(member)) {
                 const auto& element = std::get<Element>(member);
-                ret << element.get(formatting, c_sect->tag.empty() ? c_tabc : ++c_tabc);
+                ret += element.measure(formatting, c_sect->tag.empty() ? c_tabc : ++c_tabc, escaping, last);
                 c_entry.index++;
                 processed = true;
                 break;
@@ -679,21 +1184,24 @@ bygg::string_type bygg::HTML::Section::get(const Formatting formatting, const by
                 c_entry.index++;
                 processed = true;
                 break;
+            } else if (std::holds_alternative<SharedSection>(member)) {
+                const auto& section = std::get<SharedSection>(member);
+                s_stack.push({section.section.get(), c_sect->tag.empty() ? c_tabc : ++c_tabc, false, 0});
+                c_entry.index++;
+                processed = true;
+                break;
             }
             c_entry.index++;
         }
 
         if (!processed) {
             if (!c_sect->tag.empty()) {
-                if (formatting == bygg::HTML::Formatting::Pretty) {
-                    for (size_type i{0}; i < c_tabc; i++) {
-                        ret << "\t";
-                    }
-                }
-                ret << "</" + c_sect->tag + ">";
+                ret += indent(c_tabc) + 2 + c_sect->tag.size() + 1;
+                last = '>';
 
-                if (formatting == bygg::HTML::Formatting::Pretty || formatting == bygg::HTML::Formatting::Newline) {
-                    ret << "\n";
+                if (newline) {
+                    ret += 1;
+                    last = '\n';
                 }
             }
 
@@ -701,13 +1209,219 @@ bygg::string_type bygg::HTML::Section::get(const Formatting formatting, const by
         }
     }
 
-    bygg::string_type return_string{ret.str()};
+    // get() drops the final newline
+    return last == '\n' ? ret - 1 : ret;
+}
+
+bygg::string_type bygg::HTML::Section::get(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    bygg::string_type ret{};
+    ret.reserve(this->serialized_size(formatting, tabc, escaping));
+    StringSink sink{ret};
 
-    if (return_string.back() == '\n') {
-        return_string.pop_back();
+    this->write_to(sink, formatting, tabc, escaping);
+
+    return ret;
+}
+
+bygg::string_type bygg::HTML::Section::get(const Formatting formatting, const bygg::integer_type tabc, const ParallelOptions& options, const Escaping escaping) const {
+    bygg::string_type ret{};
+    StringSink sink{ret};
+
+    this->write_to(sink, formatting, tabc, options, escaping);
+
+    return ret;
+}
+
+void bygg::HTML::Section::write_to(Sink& sink, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    TrimmingSink trimmed{sink};
+    this->serialize(trimmed, formatting, tabc, escaping, false, false, nullptr);
+}
+
+void bygg::HTML::Section::write_to(Sink& sink, const Formatting formatting, const bygg::integer_type tabc, const ParallelOptions& options, const Escaping escaping) const {
+    TrimmingSink trimmed{sink};
+    this->serialize(trimmed, formatting, tabc, escaping, false, false, &options);
+}
+
+void bygg::HTML::Section::serialize_members(Sink& sink, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping, const bool recording, const bool shared, const ParallelOptions& options) const {
+    const size_type count{this->members.size()};
+    const size_type threads{impl::get_thread_count(options)};
+    const size_type chunk_size{options.chunk_size != 0 ? options.chunk_size : std::max<size_type>((count + threads * 4 - 1) / (threads * 4), 1)};
+    const size_type chunks{(count + chunk_size - 1) / chunk_size};
+
+    const auto write_member = [&](Sink& out, const variant_t& member) {
+        if (const auto* element = std::get_if<Element>(&member)) {
+            element->write_to(out, formatting, tabc, escaping);
+        } else if (const auto* section = std::get_if<Section>(&member)) {
+            section->serialize(out, formatting, tabc, escaping, recording, shared, nullptr);
+        } else if (const auto* handle = std::get_if<SharedSection>(&member)) {
+            handle->section->serialize(out, formatting, tabc, escaping, recording, true, nullptr);
+        }
+    };
+
+    if ((threads < 2 && !options.executor) || chunks < 2) {
+        for (const variant_t& it : this->members) {
+            write_member(sink, it);
+        }
+
+        return;
     }
 
-    return return_string;
+    std::vector<string_type> buffers(chunks);
+
+    impl::run_tasks(chunks, [&](const size_type chunk) {
+        StringSink out{buffers[chunk]};
+        const size_type end{std::min(count, (chunk + 1) * chunk_size)};
+
+        for (size_type i{chunk * chunk_size}; i < end; ++i) {
+            write_member(out, this->members[i]);
+        }
+    }, options);
+
+    for (string_type& it : buffers) {
+        sink.write(it);
+        string_type{}.swap(it);
+    }
+}
+
+void bygg::HTML::Section::serialize(Sink& sink, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping, const bool recording, const bool shared, const ParallelOptions* options) const {
+    RecordingSink recorder{sink};
+
+    // output only goes through the recorder while a section is being cached
+    Sink* ret{&sink};
+
+    struct Entry {
+        const Section* section{nullptr};
+        bygg::integer_type tabc{};
+        bool processed{false};
+        size_type index{};
+        bool recording{false};
+        string_type recorded{};
+        /* set inside shared subtrees, which may be serialized from several threads and must not be changed */
+        bool shared{false};
+    };
+
+    const auto indent = [&ret](const bygg::integer_type count) {
+        if (count > 0) {
+            ret->fill('\t', static_cast<size_type>(count));
+        }
+    };
+
+    std::stack<Entry> s_stack{};
+    s_stack.push({this, tabc, false, 0, false, {}, shared});
+
+    while (!s_stack.empty()) {
+        Entry& c_entry{s_stack.top()};
+        const Section* c_sect{c_entry.section};
+        bygg::integer_type c_tabc{c_entry.tabc};
+
+        if (!c_entry.processed) {
+            if (c_sect->tag.empty() && c_sect->properties.empty() && c_sect->members.empty()) {
+                s_stack.pop();
+                continue;
+            }
+
+            if (const string_type* cached{c_sect->find_cache(formatting, c_tabc, escaping)}) {
+                ret->write(*cached);
+                s_stack.pop();
+                continue;
+            }
+
+            if (c_sect->cache_enabled && !c_entry.shared) {
+                c_entry.recording = true;
+                recorder.begin(c_entry.recorded);
+                ret = &recorder;
+            }
+
+            // everything written while recording ends up in a cache, so it is clean from now on
+            if ((recording || recorder.active()) && !c_entry.shared) {
+                c_sect->dirty = false;
+                c_sect->link(0);
+            }
+
+            if (formatting == bygg::HTML::Formatting::Pretty && !c_sect->tag.empty()) {
+                indent(c_tabc);
+            }
+
+            if (!c_sect->tag.empty()) {
+                ret->put('<');
+                ret->write(c_sect->tag);
+
+                for (const Property& it : c_sect->properties) {
+                    if (!it.get_key().empty() && !it.get_value().empty()) {
+                        ret->put(' ');
+                        it.write_to(*ret, escaping);
+                    }
+                }
+
+                ret->put('>');
+
+                if (formatting == bygg::HTML::Formatting::Pretty || formatting == bygg::HTML::Formatting::Newline) {
+                    ret->put('\n');
+                }
+            }
+
+            c_entry.processed = true;
+
+            if (options != nullptr && c_sect->members.size() >= std::max<size_type>(options->min_members, 2)) {
+                c_sect->serialize_members(*ret, formatting, c_sect->tag.empty() ? c_tabc : c_tabc + 1, escaping, recording || recorder.active(), c_entry.shared, *options);
+                c_entry.index = c_sect->members.size();
+            }
+        }
+
+        bool processed = false;
+
+        while (c_entry.index < c_sect->members.size()) {
+            const auto& member = c_sect->members[c_entry.index];
+
+            if (std::holds_alternative<Element>(member)) {
+                const auto& element = std::get<Element>(member);
+                element.write_to(*ret, formatting, c_sect->tag.empty() ? c_tabc : ++c_tabc, escaping);
+                c_entry.index++;
+                processed = true;
+                break;
+            } else if (std::holds_alternative<Section>(member)) {
+                const auto& section = std::get<Section>(member);
+                s_stack.push({&section, c_sect->tag.empty() ? c_tabc : ++c_tabc, false, 0, false, {}, c_entry.shared});
+                c_entry.index++;
+                processed = true;
+                break;
+            } else if (std::holds_alternative<SharedSection>(member)) {
+                const auto& section = std::get<SharedSection>(member);
+                s_stack.push({section.section.get(), c_sect->tag.empty() ? c_tabc : ++c_tabc, false, 0, false, {}, true});
+                c_entry.index++;
+                processed = true;
+                break;
+            }
+            c_entry.index++;
+        }
+
+        if (!processed) {
+            if (!c_sect->tag.empty()) {
+                if (formatting == bygg::HTML::Formatting::Pretty) {
+                    indent(c_tabc);
+                }
+
+                ret->write("</", 2);
+                ret->write(c_sect->tag);
+                ret->put('>');
+
+                if (formatting == bygg::HTML::Formatting::Pretty || formatting == bygg::HTML::Formatting::Newline) {
+                    ret->put('\n');
+                }
+            }
+
+            if (c_entry.recording) {
+                recorder.end();
+                c_sect->cache.push_back({formatting, c_entry.tabc, escaping, std::move(c_entry.recorded)});
+
+                if (!recorder.active()) {
+                    ret = &sink;
+                }
+            }
+
+            s_stack.pop();
+        }
+    }
 }
 
 bygg::string_type bygg::HTML::Section::get_tag() const {
@@ -724,6 +1438,7 @@ void bygg::HTML::Section::swap(const size_type index1, const size_type index2) {
     }
 
     std::swap(this->members[index1], this->members[index2]);
+    this->adopt(nullptr, 0);
 }
 
 void bygg::HTML::Section::swap(const Element& element1, const Element& element2) {
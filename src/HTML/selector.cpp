@@ -0,0 +1,690 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <bygg/except.hpp>
+#include <bygg/HTML/selector.hpp>
+
+namespace {
+    constexpr std::string_view selector_whitespace{" \t\n\f\r"};
+
+    char to_lower(const char c) {
+        return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool equals_lower(const std::string_view str, const std::string_view lower) {
+        return str.size() == lower.size() && std::equal(str.begin(), str.end(), lower.begin(), [](const char a, const char b) {
+            return to_lower(a) == b;
+        });
+    }
+
+    bool skip_whitespace(const std::string_view str, bygg::size_type& pos) {
+        const bygg::size_type begin{pos};
+
+        while (pos < str.size() && selector_whitespace.find(str[pos]) != std::string_view::npos) {
+            ++pos;
+        }
+
+        return pos != begin;
+    }
+
+    bool is_ident_char(const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_' || static_cast<unsigned char>(c) >= 0x80;
+    }
+
+    bygg::string_type parse_ident(const std::string_view str, bygg::size_type& pos) {
+        bygg::string_type ret{};
+
+        while (pos < str.size()) {
+            if (str[pos] == '\\' && pos + 1 < str.size()) {
+                ret += str[pos + 1];
+                pos += 2;
+            } else if (is_ident_char(str[pos])) {
+                ret += str[pos++];
+            } else {
+                break;
+            }
+        }
+
+        if (ret.empty()) {
+            throw bygg::invalid_argument("Expected a name in selector");
+        }
+
+        return ret;
+    }
+
+    bygg::string_type to_lower(bygg::string_type str) {
+        std::transform(str.begin(), str.end(), str.begin(), [](const char c) { return to_lower(c); });
+        return str;
+    }
+
+    bygg::integer_type parse_integer(const std::string_view str, const bygg::integer_type empty) {
+        if (str.empty() || str == "+") {
+            return empty;
+        } else if (str == "-") {
+            return -empty;
+        }
+
+        bygg::size_type pos{str[0] == '+' || str[0] == '-' ? 1U : 0U};
+        bygg::integer_type ret{};
+
+        if (pos == str.size()) {
+            throw bygg::invalid_argument("Invalid argument to pseudo-class in selector");
+        }
+
+        for (; pos < str.size(); ++pos) {
+            if (str[pos] < '0' || str[pos] > '9') {
+                throw bygg::invalid_argument("Invalid argument to pseudo-class in selector");
+            }
+
+            ret = ret * 10 + (str[pos] - '0');
+        }
+
+        return str[0] == '-' ? -ret : ret;
+    }
+
+    bool contains_word(const std::string_view value, const std::string_view word) {
+        for (bygg::size_type begin{value.find_first_not_of(selector_whitespace)}; begin != std::string_view::npos;) {
+            const bygg::size_type end{std::min(value.find_first_of(selector_whitespace, begin), value.size())};
+
+            if (value.substr(begin, end - begin) == word) {
+                return true;
+            }
+
+            begin = value.find_first_not_of(selector_whitespace, end);
+        }
+
+        return false;
+    }
+
+    bool match_nth(const bygg::integer_type a, const bygg::integer_type b, const bygg::integer_type position) {
+        if (a == 0) {
+            return position == b;
+        }
+
+        const bygg::integer_type n{position - b};
+        return n / a >= 0 && n % a == 0;
+    }
+} // namespace
+
+bygg::HTML::Selector::Selector(const string_type& selector) : selector(selector) {
+    const std::string_view str{this->selector};
+    size_type pos{0};
+
+    skip_whitespace(str, pos);
+
+    while (true) {
+        std::vector<Compound> compounds{};
+        std::vector<Combinator> combinators{};
+
+        compounds.push_back(parse_compound(str, pos));
+
+        while (true) {
+            const bool whitespace{skip_whitespace(str, pos)};
+
+            if (pos == str.size() || str[pos] == ',') {
+                break;
+            }
+
+            if (str[pos] == '>' || str[pos] == '+' || str[pos] == '~') {
+                combinators.push_back(str[pos] == '>' ? Combinator::Child : str[pos] == '+' ? Combinator::Adjacent : Combinator::Sibling);
+                ++pos;
+                skip_whitespace(str, pos);
+            } else if (whitespace) {
+                combinators.push_back(Combinator::Descendant);
+            } else {
+                throw invalid_argument("Unexpected character in selector");
+            }
+
+            compounds.push_back(parse_compound(str, pos));
+        }
+
+        // matching starts from the subject of the selector, which is written last
+        std::reverse(compounds.begin(), compounds.end());
+        std::reverse(combinators.begin(), combinators.end());
+        this->complexes.push_back({std::move(compounds), std::move(combinators)});
+
+        if (pos == str.size()) {
+            break;
+        }
+
+        ++pos;
+        skip_whitespace(str, pos);
+    }
+}
+
+bygg::HTML::Selector::Compound bygg::HTML::Selector::parse_compound(const std::string_view str, size_type& pos) {
+    Compound ret{};
+    bool empty{true};
+
+    if (pos < str.size() && str[pos] == '*') {
+        ++pos;
+        empty = false;
+    } else if (pos < str.size() && (is_ident_char(str[pos]) || str[pos] == '\\')) {
+        ret.tag = to_lower(parse_ident(str, pos));
+        empty = false;
+    }
+
+    while (pos < str.size()) {
+        if (str[pos] == '#') {
+            ret.ids.push_back(parse_ident(str, ++pos));
+        } else if (str[pos] == '.') {
+            ret.classes.push_back(parse_ident(str, ++pos));
+        } else if (str[pos] == '[') {
+            Attribute attribute{};
+
+            skip_whitespace(str, ++pos);
+            attribute.name = to_lower(parse_ident(str, pos));
+            skip_whitespace(str, pos);
+
+            if (pos < str.size() && str[pos] != ']') {
+                constexpr std::string_view operators{"~|^$*"};
+                const size_type op{operators.find(str[pos])};
+
+                if (str[pos] == '=') {
+                    attribute.op = Operator::Equals;
+                    ++pos;
+                } else if (op != std::string_view::npos && pos + 1 < str.size() && str[pos + 1] == '=') {
+                    constexpr Operator values[]{Operator::Includes, Operator::Dash, Operator::Prefix, Operator::Suffix, Operator::Substring};
+                    attribute.op = values[op];
+                    pos += 2;
+                } else {
+                    throw invalid_argument("Invalid attribute selector");
+                }
+
+                skip_whitespace(str, pos);
+
+                if (pos < str.size() && (str[pos] == '"' || str[pos] == '\'')) {
+                    const size_type end{str.find(str[pos], pos + 1)};
+
+                    if (end == std::string_view::npos) {
+                        throw invalid_argument("Unterminated string in selector");
+                    }
+
+                    attribute.value = str.substr(pos + 1, end - pos - 1);
+                    pos = end + 1;
+                } else {
+                    attribute.value = parse_ident(str, pos);
+                }
+
+                skip_whitespace(str, pos);
+            }
+
+            if (pos == str.size() || str[pos] != ']') {
+                throw invalid_argument("Unterminated attribute selector");
+            }
+
+            ++pos;
+            ret.attributes.push_back(std::move(attribute));
+        } else if (str[pos] == ':') {
+            ret.pseudo_classes.push_back(parse_pseudo_class(str, ++pos));
+        } else {
+            break;
+        }
+
+        empty = false;
+    }
+
+    if (empty) {
+        throw invalid_argument(pos == str.size() ? "Unexpected end of selector" : "Unexpected character in selector");
+    }
+
+    return ret;
+}
+
+bygg::HTML::Selector::PseudoClass bygg::HTML::Selector::parse_pseudo_class(const std::string_view str, size_type& pos) {
+    if (pos < str.size() && str[pos] == ':') {
+        throw invalid_argument("Pseudo-elements are not supported in selectors");
+    }
+
+    const string_type name{to_lower(parse_ident(str, pos))};
+    PseudoClass ret{};
+
+    if (name == "first-child" || name == "last-child" || name == "first-of-type" || name == "last-of-type") {
+        ret.last = name.compare(0, 4, "last") == 0;
+        ret.of_type = name.size() > 8 && name.compare(name.size() - 7, 7, "of-type") == 0;
+        ret.b = 1;
+        return ret;
+    } else if (name == "only-child" || name == "only-of-type") {
+        ret.type = PseudoType::Only;
+        ret.of_type = name == "only-of-type";
+        return ret;
+    } else if (name == "empty") {
+        ret.type = PseudoType::Empty;
+        return ret;
+    } else if (name != "nth-child" && name != "nth-last-child" && name != "nth-of-type" && name != "nth-last-of-type" && name != "not") {
+        throw invalid_argument("Unsupported pseudo-class in selector");
+    }
+
+    if (pos == str.size() || str[pos] != '(') {
+        throw invalid_argument("Expected an argument to pseudo-class in selector");
+    }
+
+    skip_whitespace(str, ++pos);
+
+    if (name == "not") {
+        ret.type = PseudoType::Not;
+
+        while (true) {
+            ret.compounds.push_back(parse_compound(str, pos));
+            skip_whitespace(str, pos);
+
+            if (pos < str.size() && str[pos] == ',') {
+                skip_whitespace(str, ++pos);
+                continue;
+            }
+
+            break;
+        }
+    } else {
+        const size_type end{str.find(')', pos)};
+
+        if (end == std::string_view::npos) {
+            throw invalid_argument("Unterminated argument to pseudo-class in selector");
+        }
+
+        string_type argument{};
+
+        for (size_type i{pos}; i < end; ++i) {
+            if (selector_whitespace.find(str[i]) == std::string_view::npos) {
+                argument += to_lower(str[i]);
+            }
+        }
+
+        if (argument == "odd") {
+            ret.a = 2;
+            ret.b = 1;
+        } else if (argument == "even") {
+            ret.a = 2;
+            ret.b = 0;
+        } else if (const size_type n{argument.find('n')}; n != string_type::npos) {
+            ret.a = parse_integer(std::string_view{argument}.substr(0, n), 1);
+            ret.b = parse_integer(std::string_view{argument}.substr(n + 1), 0);
+
+            // the offset has to be signed, as in 2n+1
+            if (n + 1 < argument.size() && argument[n + 1] != '+' && argument[n + 1] != '-') {
+                throw invalid_argument("Invalid argument to pseudo-class in selector");
+            }
+        } else {
+            ret.b = parse_integer(argument, 0);
+        }
+
+        ret.last = name.find("last") != string_type::npos;
+        ret.of_type = name.find("of-type") != string_type::npos;
+        pos = end;
+    }
+
+    if (pos == str.size() || str[pos] != ')') {
+        throw invalid_argument("Unterminated argument to pseudo-class in selector");
+    }
+
+    ++pos;
+    return ret;
+}
+
+const bygg::HTML::Section::variant_t& bygg::HTML::Selector::get_member(const Path& path) {
+    return path.back().section->members[path.back().index];
+}
+
+bool bygg::HTML::Selector::is_node(const Section::variant_t& member) {
+    if (const auto* element = std::get_if<Element>(&member)) {
+        return !element->tag.empty() && element->type != Type::Text && element->type != Type::Text_No_Formatting && element->type != Type::Closing;
+    }
+
+    if (const auto* section = std::get_if<Section>(&member)) {
+        return !section->tag.empty();
+    }
+
+    // shared sections are opaque
+    return false;
+}
+
+bool bygg::HTML::Selector::parent(const Section& root, Path& path) {
+    while (!path.empty()) {
+        path.pop_back();
+
+        if (path.empty()) {
+            return !root.tag.empty();
+        }
+
+        // only sections have members, and those without a tag are skipped
+        if (!std::get<Section>(get_member(path)).tag.empty()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool bygg::HTML::Selector::previous(Path& path) {
+    while (!path.empty()) {
+        Frame& frame{path.back()};
+
+        if (frame.index == 0) {
+            path.pop_back();
+
+            // leaving a section without a tag continues with the members before it
+            if (path.empty() || !std::get<Section>(get_member(path)).tag.empty()) {
+                return false;
+            }
+
+            continue;
+        }
+
+        --frame.index;
+
+        const Section::variant_t& member{get_member(path)};
+
+        if (is_node(member)) {
+            return true;
+        } else if (const auto* section = std::get_if<Section>(&member)) {
+            path.push_back({section, section->members.size()});
+        }
+    }
+
+    return false;
+}
+
+bool bygg::HTML::Selector::next(Path& path) {
+    while (!path.empty()) {
+        Frame& frame{path.back()};
+
+        // npos + 1 wraps around to the first member of a section that was just entered
+        if (frame.index + 1 >= frame.section->members.size()) {
+            path.pop_back();
+
+            if (path.empty() || !std::get<Section>(get_member(path)).tag.empty()) {
+                return false;
+            }
+
+            continue;
+        }
+
+        ++frame.index;
+
+        const Section::variant_t& member{get_member(path)};
+
+        if (is_node(member)) {
+            return true;
+        } else if (const auto* section = std::get_if<Section>(&member)) {
+            path.push_back({section, Section::npos});
+        }
+    }
+
+    return false;
+}
+
+bool bygg::HTML::Selector::match_compound(const Compound& compound, const Section& root, const Path& path) {
+    const Element* element{nullptr};
+    const Section* section{&root};
+
+    if (!path.empty()) {
+        element = std::get_if<Element>(&get_member(path));
+        section = std::get_if<Section>(&get_member(path));
+    }
+
+    const string_type& tag{element != nullptr ? element->tag : section->tag};
+    const Properties& properties{element != nullptr ? element->properties : section->properties};
+
+    if (!compound.tag.empty() && !equals_lower(tag, compound.tag)) {
+        return false;
+    }
+
+    const auto find_attribute = [&properties](const std::string_view name) -> const string_type* {
+        for (const Property& it : properties) {
+            if (equals_lower(it.property.first, name)) {
+                return &it.property.second;
+            }
+        }
+
+        return nullptr;
+    };
+
+    for (const string_type& it : compound.ids) {
+        const string_type* id{find_attribute("id")};
+
+        if (id == nullptr || *id != it) {
+            return false;
+        }
+    }
+
+    if (!compound.classes.empty()) {
+        const string_type* classes{find_attribute("class")};
+
+        for (const string_type& it : compound.classes) {
+            if (classes == nullptr || !contains_word(*classes, it)) {
+                return false;
+            }
+        }
+    }
+
+    for (const Attribute& it : compound.attributes) {
+        const string_type* value{find_attribute(it.name)};
+
+        if (value == nullptr) {
+            return false;
+        }
+
+        const std::string_view str{*value};
+        bool matched{true};
+
+        switch (it.op) {
+            case Operator::Exists:
+                break;
+            case Operator::Equals:
+                matched = str == it.value;
+                break;
+            case Operator::Includes:
+                matched = contains_word(str, it.value);
+                break;
+            case Operator::Dash:
+                matched = str == it.value || (str.size() > it.value.size() && str.compare(0, it.value.size(), it.value) == 0 && str[it.value.size()] == '-');
+                break;
+            case Operator::Prefix:
+                matched = !it.value.empty() && str.compare(0, it.value.size(), it.value) == 0;
+                break;
+            case Operator::Suffix:
+                matched = !it.value.empty() && str.size() >= it.value.size() && str.compare(str.size() - it.value.size(), it.value.size(), it.value) == 0;
+                break;
+            case Operator::Substring:
+                matched = !it.value.empty() && str.find(it.value) != std::string_view::npos;
+                break;
+        }
+
+        if (!matched) {
+            return false;
+        }
+    }
+
+    const auto count_siblings = [&path, &tag](const bool forward, const bool of_type) {
+        Path sibling{path};
+        integer_type ret{};
+
+        while (forward ? next(sibling) : previous(sibling)) {
+            if (!of_type) {
+                ++ret;
+                continue;
+            }
+
+            const Section::variant_t& member{get_member(sibling)};
+            const string_type& sibling_tag{std::holds_alternative<Element>(member) ? std::get<Element>(member).tag : std::get<Section>(member).tag};
+
+            if (sibling_tag.size() == tag.size() && std::equal(tag.begin(), tag.end(), sibling_tag.begin(), [](const char a, const char b) {
+                return to_lower(a) == to_lower(b);
+            })) {
+                ++ret;
+            }
+        }
+
+        return ret;
+    };
+
+    for (const PseudoClass& it : compound.pseudo_classes) {
+        bool matched{};
+
+        switch (it.type) {
+            case PseudoType::Nth:
+                matched = !path.empty() && match_nth(it.a, it.b, count_siblings(it.last, it.of_type) + 1);
+                break;
+            case PseudoType::Only:
+                matched = !path.empty() && count_siblings(false, it.of_type) == 0 && count_siblings(true, it.of_type) == 0;
+                break;
+            case PseudoType::Empty:
+                matched = element != nullptr ? element->data.empty() : section->members.empty();
+                break;
+            case PseudoType::Not:
+                matched = std::none_of(it.compounds.begin(), it.compounds.end(), [&root, &path](const Compound& negated) {
+                    return match_compound(negated, root, path);
+                });
+                break;
+        }
+
+        if (!matched) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool bygg::HTML::Selector::match_complex(const Complex& complex, const size_type index, const Section& root, const Path& path) {
+    if (!match_compound(complex.compounds[index], root, path)) {
+        return false;
+    }
+
+    if (index + 1 == complex.compounds.size()) {
+        return true;
+    }
+
+    Path next_path{path};
+
+    switch (complex.combinators[index]) {
+        case Combinator::Child:
+            return parent(root, next_path) && match_complex(complex, index + 1, root, next_path);
+        case Combinator::Adjacent:
+            return previous(next_path) && match_complex(complex, index + 1, root, next_path);
+        case Combinator::Descendant:
+            while (parent(root, next_path)) {
+                if (match_complex(complex, index + 1, root, next_path)) {
+                    return true;
+                }
+            }
+
+            return false;
+        case Combinator::Sibling:
+            while (previous(next_path)) {
+                if (match_complex(complex, index + 1, root, next_path)) {
+                    return true;
+                }
+            }
+
+            return false;
+    }
+
+    return false;
+}
+
+void bygg::HTML::Selector::search(const Section& section, std::vector<Section::variant_t*>& results, const bool first) const {
+    Path path{};
+    path.push_back({&section, 0});
+
+    while (!path.empty()) {
+        Frame& frame{path.back()};
+
+        if (frame.index == frame.section->members.size()) {
+            path.pop_back();
+
+            if (!path.empty()) {
+                ++path.back().index;
+            }
+
+            continue;
+        }
+
+        Section::variant_t& member{frame.section->members[frame.index]};
+
+        if (is_node(member) && std::any_of(this->complexes.begin(), this->complexes.end(), [&section, &path](const Complex& it) {
+            return match_complex(it, 0, section, path);
+        })) {
+            results.push_back(&member);
+
+            if (first) {
+                return;
+            }
+        }
+
+        if (const auto* child = std::get_if<Section>(&member)) {
+            path.push_back({child, 0});
+        } else {
+            ++frame.index;
+        }
+    }
+}
+
+bygg::string_type bygg::HTML::Selector::get() const {
+    return this->selector;
+}
+
+bygg::HTML::Section::variant_t* bygg::HTML::Selector::query(Section& section) const {
+    std::vector<Section::variant_t*> results{};
+    this->search(section, results, true);
+    return results.empty() ? nullptr : results.front();
+}
+
+const bygg::HTML::Section::variant_t* bygg::HTML::Selector::query(const Section& section) const {
+    std::vector<Section::variant_t*> results{};
+    this->search(section, results, true);
+    return results.empty() ? nullptr : results.front();
+}
+
+std::vector<bygg::HTML::Section::variant_t*> bygg::HTML::Selector::query_all(Section& section) const {
+    std::vector<Section::variant_t*> results{};
+    this->search(section, results, false);
+    return results;
+}
+
+std::vector<const bygg::HTML::Section::variant_t*> bygg::HTML::Selector::query_all(const Section& section) const {
+    std::vector<Section::variant_t*> results{};
+    this->search(section, results, false);
+    return {results.begin(), results.end()};
+}
+
+bygg::HTML::Section::variant_t* bygg::HTML::query_selector(Section& section, const Selector& selector) {
+    return selector.query(section);
+}
+
+const bygg::HTML::Section::variant_t* bygg::HTML::query_selector(const Section& section, const Selector& selector) {
+    return selector.query(section);
+}
+
+bygg::HTML::Section::variant_t* bygg::HTML::query_selector(Section& section, const string_type& selector) {
+    return Selector{selector}.query(section);
+}
+
+const bygg::HTML::Section::variant_t* bygg::HTML::query_selector(const Section& section, const string_type& selector) {
+    return Selector{selector}.query(section);
+}
+
+std::vector<bygg::HTML::Section::variant_t*> bygg::HTML::query_selector_all(Section& section, const Selector& selector) {
+    return selector.query_all(section);
+}
+
+std::vector<const bygg::HTML::Section::variant_t*> bygg::HTML::query_selector_all(const Section& section, const Selector& selector) {
+    return selector.query_all(section);
+}
+
+std::vector<bygg::HTML::Section::variant_t*> bygg::HTML::query_selector_all(Section& section, const string_type& selector) {
+    return Selector{selector}.query_all(section);
+}
+
+std::vector<const bygg::HTML::Section::variant_t*> bygg::HTML::query_selector_all(const Section& section, const string_type& selector) {
+    return Selector{selector}.query_all(section);
+}
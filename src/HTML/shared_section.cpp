@@ -0,0 +1,100 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <bygg/sink.hpp>
+#include <bygg/HTML/section.hpp>
+#include <bygg/HTML/shared_section.hpp>
+#include <bygg/HTML/impl/serialization.hpp>
+
+bygg::HTML::SharedSection::SharedSection() : section(std::make_shared<Section>()), hash(this->section->get_hash()) {}
+
+bygg::HTML::SharedSection::SharedSection(const Section& section) : section(std::make_shared<Section>(section)), hash(this->section->get_hash()) {}
+
+bygg::HTML::SharedSection::SharedSection(Section&& section) : section(std::make_shared<Section>(std::move(section))), hash(this->section->get_hash()) {}
+
+bygg::HTML::Section& bygg::HTML::SharedSection::detach() {
+    if (this->section.use_count() > 1) {
+        this->section = std::make_shared<Section>(*this->section);
+    }
+
+    return *this->section;
+}
+
+void bygg::HTML::SharedSection::update() {
+    // hashed now, while the section is not shared, so that it is never hashed while shared
+    this->hash = this->section->get_hash();
+    this->parent.invalidate();
+}
+
+const bygg::HTML::Section& bygg::HTML::SharedSection::get_section() const {
+    return *this->section;
+}
+
+long bygg::HTML::SharedSection::use_count() const {
+    return this->section.use_count();
+}
+
+std::uint64_t bygg::HTML::SharedSection::get_hash() const {
+    return this->hash;
+}
+
+bygg::string_type bygg::HTML::SharedSection::get_tag() const {
+    return this->section->tag;
+}
+
+bygg::HTML::Properties bygg::HTML::SharedSection::get_properties() const {
+    return this->section->properties;
+}
+
+bygg::string_type bygg::HTML::SharedSection::get(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    bygg::string_type ret{};
+    ret.reserve(this->serialized_size(formatting, tabc, escaping));
+    StringSink sink{ret};
+
+    this->write_to(sink, formatting, tabc, escaping);
+
+    return ret;
+}
+
+void bygg::HTML::SharedSection::write_to(Sink& sink, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    TrimmingSink trimmed{sink};
+    this->section->serialize(trimmed, formatting, tabc, escaping, false, true, nullptr);
+}
+
+bygg::size_type bygg::HTML::SharedSection::serialized_size(const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) const {
+    return this->section->serialized_size(formatting, tabc, escaping);
+}
+
+const bygg::HTML::Section& bygg::HTML::SharedSection::operator*() const {
+    return *this->section;
+}
+
+const bygg::HTML::Section* bygg::HTML::SharedSection::operator->() const {
+    return this->section.get();
+}
+
+bygg::HTML::SharedSection& bygg::HTML::SharedSection::operator=(const SharedSection& section) {
+    this->section = section.section;
+    this->hash = section.hash;
+    this->parent.invalidate();
+    return *this;
+}
+
+bygg::HTML::SharedSection& bygg::HTML::SharedSection::operator=(SharedSection&& section) noexcept {
+    this->section = std::move(section.section);
+    this->hash = section.hash;
+    this->parent.invalidate();
+    return *this;
+}
+
+bool bygg::HTML::SharedSection::operator==(const SharedSection& section) const {
+    return this->section == section.section || (this->hash == section.hash && *this->section == *section.section);
+}
+
+bool bygg::HTML::SharedSection::operator!=(const SharedSection& section) const {
+    return !(*this == section);
+}
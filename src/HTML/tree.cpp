@@ -0,0 +1,475 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stack>
+
+#include <bygg/except.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/tree.hpp>
+#include <bygg/HTML/impl/serialization.hpp>
+#include <bygg/HTML/impl/escape.hpp>
+
+namespace {
+    /*
+     * Discards the output and only counts it, so that serialized_size()
+     * can share the traversal with write_to().
+     */
+    class CountingSink : public bygg::Sink {
+            bygg::size_type count{};
+        public:
+            void write(const char*, const bygg::size_type size) override {
+                this->count += size;
+            }
+            [[nodiscard]] bygg::size_type size() const {
+                return this->count;
+            }
+            using bygg::Sink::write;
+    };
+} // namespace
+
+bygg::HTML::Tree::Tree(std::pmr::memory_resource* resource) : nodes(resource), attributes(resource), tags(resource), tag_ids(resource), text(resource) {
+    this->clear();
+}
+
+bygg::HTML::Tree::Tree(const Section& section, std::pmr::memory_resource* resource) : Tree(resource) {
+    this->set(section);
+}
+
+bygg::HTML::Tree& bygg::HTML::Tree::operator=(const Tree& tree) = default;
+
+bygg::HTML::Tree& bygg::HTML::Tree::operator=(Tree&& tree) = default;
+
+bygg::HTML::Tree& bygg::HTML::Tree::operator=(const Section& section) {
+    this->set(section);
+    return *this;
+}
+
+bygg::HTML::Tree::index_type bygg::HTML::Tree::intern_tag(const std::string_view tag) {
+    const std::size_t hash{std::hash<std::string_view>{}(tag)};
+    const auto [begin, end]{this->tag_ids.equal_range(hash)};
+
+    for (auto it{begin}; it != end; ++it) {
+        if (this->tags[it->second] == tag) {
+            return it->second;
+        }
+    }
+
+    const auto id{static_cast<index_type>(this->tags.size())};
+
+    this->tags.emplace_back(tag);
+    this->tag_ids.emplace(hash, id);
+
+    return id;
+}
+
+bygg::HTML::Tree::Span bygg::HTML::Tree::store_text(const std::string_view str) {
+    const Span span{this->text.size(), str.size()};
+    this->text.append(str);
+    return span;
+}
+
+bygg::HTML::Tree::index_type bygg::HTML::Tree::store_attributes(const Properties& properties) {
+    const auto begin{static_cast<index_type>(this->attributes.size())};
+
+    for (const Property& it : properties) {
+        const Span key{this->store_text(it.property.first)};
+        const Span value{this->store_text(it.property.second)};
+
+        this->attributes.push_back({key, value});
+    }
+
+    return begin;
+}
+
+bygg::HTML::Tree::index_type bygg::HTML::Tree::append_node(const index_type parent, Node node) {
+    if (parent >= this->nodes.size() || !this->nodes[parent].section) {
+        throw out_of_range("Parent is not a section in the tree");
+    }
+
+    const auto index{static_cast<index_type>(this->nodes.size())};
+    node.parent = parent;
+
+    Node& p{this->nodes[parent]};
+    if (p.last_child == npos) {
+        p.first_child = index;
+    } else {
+        this->nodes[p.last_child].next_sibling = index;
+    }
+    p.last_child = index;
+
+    this->nodes.push_back(node);
+
+    return index;
+}
+
+bygg::HTML::Tree::index_type bygg::HTML::Tree::add_section(const index_type parent, const std::string_view tag, const Properties& properties) {
+    Node node{};
+    node.section = true;
+    node.tag = this->intern_tag(tag);
+    node.attribute_begin = this->store_attributes(properties);
+    node.attribute_count = static_cast<index_type>(properties.size());
+
+    return this->append_node(parent, node);
+}
+
+bygg::HTML::Tree::index_type bygg::HTML::Tree::add_section(const index_type parent, const Tag tag, const Properties& properties) {
+    return this->add_section(parent, get_tag_info(tag).name, properties);
+}
+
+bygg::HTML::Tree::index_type bygg::HTML::Tree::add_element(const index_type parent, const std::string_view tag, const Properties& properties, const std::string_view data, const Type type, const ElementParameters params) {
+    Node node{};
+    node.tag = this->intern_tag(tag);
+    node.attribute_begin = this->store_attributes(properties);
+    node.attribute_count = static_cast<index_type>(properties.size());
+    node.data = this->store_text(data);
+    node.type = type;
+    node.params = params;
+    node.transform = impl::requires_transform(data, params);
+
+    return this->append_node(parent, node);
+}
+
+bygg::HTML::Tree::index_type bygg::HTML::Tree::add_element(const index_type parent, const Tag tag, const std::string_view data, const ElementParameters params) {
+    const TagInfo& info{get_tag_info(tag)};
+    return this->add_element(parent, info.name, {}, data, info.type, params);
+}
+
+bygg::HTML::Tree::index_type bygg::HTML::Tree::add_element(const index_type parent, const Tag tag, const Properties& properties, const std::string_view data, const ElementParameters params) {
+    const TagInfo& info{get_tag_info(tag)};
+    return this->add_element(parent, info.name, properties, data, info.type, params);
+}
+
+void bygg::HTML::Tree::append_section(const index_type parent, const Section& section) {
+    struct Entry {
+        const Section* section{nullptr};
+        index_type index{};
+        size_type member{};
+    };
+
+    std::stack<Entry> s_stack{};
+    s_stack.push({&section, parent, 0});
+
+    while (!s_stack.empty()) {
+        Entry& c_entry{s_stack.top()};
+
+        if (c_entry.member == c_entry.section->members.size()) {
+            s_stack.pop();
+            continue;
+        }
+
+        const auto& member{c_entry.section->members[c_entry.member++]};
+
+        if (std::holds_alternative<Element>(member)) {
+            const auto& element{std::get<Element>(member)};
+            this->add_element(c_entry.index, element.tag, element.properties, element.data, element.type, element.params);
+        } else {
+            // shared sections are expanded, the tree holds its own copy of them
+            const Section& child{std::holds_alternative<Section>(member) ? std::get<Section>(member) : *std::get<SharedSection>(member).section};
+            const index_type index{this->add_section(c_entry.index, child.tag, child.properties)};
+            s_stack.push({&child, index, 0});
+        }
+    }
+}
+
+void bygg::HTML::Tree::set(const Section& section) {
+    this->clear();
+
+    Node& root_node{this->nodes.front()};
+    root_node.tag = this->intern_tag(section.tag);
+    root_node.attribute_begin = this->store_attributes(section.properties);
+    root_node.attribute_count = static_cast<index_type>(section.properties.size());
+
+    this->append_section(root(), section);
+}
+
+bygg::HTML::Section bygg::HTML::Tree::to_section() const {
+    const Node& root_node{this->nodes.front()};
+    Section ret{string_type{this->get_tag(root())}, this->get_properties(root())};
+
+    std::stack<Section*> s_stack{};
+    s_stack.push(&ret);
+
+    index_type index{root_node.first_child};
+
+    while (index != npos) {
+        const Node& node{this->nodes[index]};
+
+        if (node.section) {
+            Section& section{s_stack.top()->emplace_back<Section>(string_type{this->get_tag(index)}, this->get_properties(index))};
+
+            if (node.first_child != npos) {
+                s_stack.push(&section);
+                index = node.first_child;
+                continue;
+            }
+        } else {
+            s_stack.top()->emplace_back<Element>(string_type{this->get_tag(index)}, this->get_properties(index), string_type{this->get_text(node.data)}, node.type, node.params);
+        }
+
+        while (index != root() && this->nodes[index].next_sibling == npos) {
+            index = this->nodes[index].parent;
+
+            if (index != root()) {
+                s_stack.pop();
+            }
+        }
+
+        index = index == root() ? npos : this->nodes[index].next_sibling;
+    }
+
+    return ret;
+}
+
+const bygg::HTML::Tree::Node& bygg::HTML::Tree::at(const index_type index) const {
+    if (index >= this->nodes.size()) {
+        throw out_of_range("Index out of range");
+    }
+
+    return this->nodes[index];
+}
+
+std::string_view bygg::HTML::Tree::get_tag(const index_type index) const {
+    return this->tags[this->at(index).tag];
+}
+
+std::string_view bygg::HTML::Tree::get_data(const index_type index) const {
+    return this->get_text(this->at(index).data);
+}
+
+bygg::HTML::Properties bygg::HTML::Tree::get_properties(const index_type index) const {
+    const Node& node{this->at(index)};
+    Properties ret{};
+
+    for (index_type i{0}; i < node.attribute_count; ++i) {
+        const Attribute& attribute{this->attributes[node.attribute_begin + i]};
+        ret.push_back(Property{string_type{this->get_text(attribute.key)}, string_type{this->get_text(attribute.value)}});
+    }
+
+    return ret;
+}
+
+bygg::size_type bygg::HTML::Tree::size() const {
+    return this->nodes.size();
+}
+
+bool bygg::HTML::Tree::empty() const {
+    return this->nodes.front().first_child == npos;
+}
+
+void bygg::HTML::Tree::clear() {
+    this->nodes.clear();
+    this->attributes.clear();
+    this->tags.clear();
+    this->tag_ids.clear();
+    this->text.clear();
+
+    Node root_node{};
+    root_node.section = true;
+    root_node.tag = this->intern_tag({});
+
+    this->nodes.push_back(root_node);
+}
+
+void bygg::HTML::Tree::reserve(const size_type nodes, const size_type text) {
+    this->nodes.reserve(nodes);
+    this->text.reserve(text);
+}
+
+std::string_view bygg::HTML::Tree::get_text(const Span span) const {
+    return std::string_view{this->text}.substr(span.offset, span.size);
+}
+
+std::pmr::memory_resource* bygg::HTML::Tree::get_resource() const {
+    return this->nodes.get_allocator().resource();
+}
+
+void bygg::HTML::Tree::write_attributes(Sink& sink, const Node& node, const Escaping escaping) const {
+    for (index_type i{0}; i < node.attribute_count; ++i) {
+        const Attribute& attribute{this->attributes[node.attribute_begin + i]};
+
+        if (attribute.key.size == 0 || attribute.value.size == 0) {
+            continue;
+        }
+
+        sink.put(' ');
+        sink.write(this->text.data() + attribute.key.offset, attribute.key.size);
+        sink.write("=\"", 2);
+
+        if (escaping == Escaping::None) {
+            sink.write(this->text.data() + attribute.value.offset, attribute.value.size);
+        } else {
+            impl::write_escaped(sink, this->get_text(attribute.value));
+        }
+
+        sink.put('"');
+    }
+}
+
+void bygg::HTML::Tree::write_element(Sink& sink, const Node& node, const Formatting formatting, const integer_type tabc, const Escaping escaping) const {
+    const impl::TextTransform& transform{impl::get_transform(node.params)};
+    const bool escape{escaping == Escaping::All};
+
+    const std::string_view tag{this->tags[node.tag]};
+    const std::string_view data{this->get_text(node.data)};
+
+    const auto write_data = [&]() {
+        if (node.transform || escape) {
+            transform.write(sink, data, escape);
+        } else {
+            sink.write(data.data(), data.size());
+        }
+    };
+
+    if (node.type == Type::Text_No_Formatting || node.type == Type::Text) {
+        if (node.type == Type::Text && tabc > 0) {
+            sink.fill('\t', static_cast<size_type>(tabc));
+        }
+
+        write_data();
+        return;
+    }
+
+    if (formatting == Formatting::Pretty && tabc > 0) {
+        sink.fill('\t', static_cast<size_type>(tabc));
+    }
+
+    if (!tag.empty()) {
+        if (node.type == Type::Closing) {
+            sink.write("</", 2);
+        } else {
+            sink.put('<');
+        }
+        sink.write(tag.data(), tag.size());
+
+        this->write_attributes(sink, node, escaping);
+
+        if (node.type == Type::Data) {
+            sink.put('>');
+            write_data();
+            sink.write("</", 2);
+            sink.write(tag.data(), tag.size());
+            sink.put('>');
+        } else if (node.type == Type::Standalone) {
+            write_data();
+            sink.write("/>", 2);
+        } else {
+            sink.put('>');
+        }
+    }
+
+    if (formatting == Formatting::Pretty || formatting == Formatting::Newline) {
+        sink.put('\n');
+    }
+}
+
+void bygg::HTML::Tree::write_open(Sink& sink, const Node& node, const Formatting formatting, const integer_type tabc, const Escaping escaping) const {
+    const std::string_view tag{this->tags[node.tag]};
+
+    if (tag.empty()) {
+        return;
+    }
+
+    if (formatting == Formatting::Pretty && tabc > 0) {
+        sink.fill('\t', static_cast<size_type>(tabc));
+    }
+
+    sink.put('<');
+    sink.write(tag.data(), tag.size());
+
+    this->write_attributes(sink, node, escaping);
+
+    sink.put('>');
+
+    if (formatting == Formatting::Pretty || formatting == Formatting::Newline) {
+        sink.put('\n');
+    }
+}
+
+void bygg::HTML::Tree::write_close(Sink& sink, const Node& node, const Formatting formatting, const integer_type tabc) const {
+    const std::string_view tag{this->tags[node.tag]};
+
+    if (tag.empty()) {
+        return;
+    }
+
+    if (formatting == Formatting::Pretty && tabc > 0) {
+        sink.fill('\t', static_cast<size_type>(tabc));
+    }
+
+    sink.write("</", 2);
+    sink.write(tag.data(), tag.size());
+    sink.put('>');
+
+    if (formatting == Formatting::Pretty || formatting == Formatting::Newline) {
+        sink.put('\n');
+    }
+}
+
+void bygg::HTML::Tree::write_to(Sink& sink, const Formatting formatting, const integer_type tabc, const Escaping escaping) const {
+    TrimmingSink ret{sink};
+
+    /*
+     * Walk the tree through the sibling links. Members of a section are
+     * indented one level deeper than the section itself unless it has no tag,
+     * so the indentation of a parent can be recovered when climbing back up.
+     */
+    const auto child_tabc = [this](const Node& parent, const integer_type tabc) {
+        return this->tags[parent.tag].empty() ? tabc : tabc + 1;
+    };
+
+    integer_type c_tabc{tabc};
+    index_type index{root()};
+
+    while (true) {
+        const Node& node{this->nodes[index]};
+
+        if (node.section) {
+            this->write_open(ret, node, formatting, c_tabc, escaping);
+
+            if (node.first_child != npos) {
+                c_tabc = child_tabc(node, c_tabc);
+                index = node.first_child;
+                continue;
+            }
+
+            this->write_close(ret, node, formatting, c_tabc);
+        } else {
+            this->write_element(ret, node, formatting, c_tabc, escaping);
+        }
+
+        while (index != root() && this->nodes[index].next_sibling == npos) {
+            index = this->nodes[index].parent;
+
+            const Node& parent{this->nodes[index]};
+            c_tabc = this->tags[parent.tag].empty() ? c_tabc : c_tabc - 1;
+
+            this->write_close(ret, parent, formatting, c_tabc);
+        }
+
+        if (index == root()) {
+            break;
+        }
+
+        index = this->nodes[index].next_sibling;
+    }
+}
+
+bygg::size_type bygg::HTML::Tree::serialized_size(const Formatting formatting, const integer_type tabc, const Escaping escaping) const {
+    CountingSink sink{};
+    this->write_to(sink, formatting, tabc, escaping);
+    return sink.size();
+}
+
+bygg::string_type bygg::HTML::Tree::get(const Formatting formatting, const integer_type tabc, const Escaping escaping) const {
+    string_type ret{};
+    ret.reserve(this->serialized_size(formatting, tabc, escaping));
+    StringSink sink{ret};
+
+    this->write_to(sink, formatting, tabc, escaping);
+
+    return ret;
+}
@@ -0,0 +1,132 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <bygg/except.hpp>
+#include <bygg/sink.hpp>
+#include <bygg/HTML/writer.hpp>
+
+bygg::HTML::Writer::Writer(Sink& sink, const Formatting formatting, const bygg::integer_type tabc, const Escaping escaping) : output(sink), sink(sink), formatting(formatting), escaping(escaping), tabc(tabc) {}
+
+std::string_view bygg::HTML::Writer::get_open_tag() const {
+    if (this->offsets.empty()) {
+        throw out_of_range("No section is open");
+    }
+
+    return std::string_view{this->tags}.substr(this->offsets.back());
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::open(const Tag tag, const Properties& properties) {
+    return this->open(get_tag_info(tag).name, properties);
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::open(const std::string_view tag, const Properties& properties) {
+    this->offsets.push_back(this->tags.size());
+    this->tags.append(tag);
+
+    if (tag.empty()) {
+        return *this;
+    }
+
+    if (this->formatting == Formatting::Pretty && this->tabc > 0) {
+        this->sink.fill('\t', static_cast<size_type>(this->tabc));
+    }
+
+    this->sink.put('<');
+    this->sink.write(tag.data(), tag.size());
+
+    for (const Property& it : properties) {
+        if (!it.get_key().empty() && !it.get_value().empty()) {
+            this->sink.put(' ');
+            it.write_to(this->sink, this->escaping);
+        }
+    }
+
+    this->sink.put('>');
+
+    if (this->formatting == Formatting::Pretty || this->formatting == Formatting::Newline) {
+        this->sink.put('\n');
+    }
+
+    ++this->tabc;
+    return *this;
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::close() {
+    const std::string_view tag{this->get_open_tag()};
+
+    if (!tag.empty()) {
+        --this->tabc;
+
+        if (this->formatting == Formatting::Pretty && this->tabc > 0) {
+            this->sink.fill('\t', static_cast<size_type>(this->tabc));
+        }
+
+        this->sink.write("</", 2);
+        this->sink.write(tag.data(), tag.size());
+        this->sink.put('>');
+
+        if (this->formatting == Formatting::Pretty || this->formatting == Formatting::Newline) {
+            this->sink.put('\n');
+        }
+    }
+
+    this->tags.resize(this->offsets.back());
+    this->offsets.pop_back();
+    return *this;
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::close(const Tag tag) {
+    return this->close(get_tag_info(tag).name);
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::close(const std::string_view tag) {
+    if (this->get_open_tag() != tag) {
+        throw invalid_argument("Tag does not match the open section");
+    }
+
+    return this->close();
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::element(const Tag tag, const Properties& properties, const std::string_view data, const ElementParameters params) {
+    const TagInfo& info{get_tag_info(tag)};
+    Element::write(this->sink, info.name, properties, data, info.type, params, this->formatting, this->tabc, this->escaping);
+    return *this;
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::element(const Tag tag, const std::string_view data, const ElementParameters params) {
+    return this->element(tag, Properties{}, data, params);
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::element(const std::string_view tag, const Properties& properties, const std::string_view data, const Type type, const ElementParameters params) {
+    Element::write(this->sink, tag, properties, data, type, params, this->formatting, this->tabc, this->escaping);
+    return *this;
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::element(const std::string_view tag, const std::string_view data, const Type type, const ElementParameters params) {
+    return this->element(tag, Properties{}, data, type, params);
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::element(const Element& element) {
+    element.write_to(this->sink, this->formatting, this->tabc, this->escaping);
+    return *this;
+}
+
+bygg::HTML::Writer& bygg::HTML::Writer::text(const std::string_view data, const ElementParameters params) {
+    return this->element(std::string_view{}, Properties{}, data, Type::Text, params);
+}
+
+bygg::size_type bygg::HTML::Writer::depth() const {
+    return this->offsets.size();
+}
+
+void bygg::HTML::Writer::finish() {
+    if (!this->offsets.empty()) {
+        throw invalid_argument("Not every section has been closed");
+    }
+
+    this->output.flush();
+}
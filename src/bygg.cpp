@@ -7,6 +7,7 @@
 
 // NOLINTBEGIN
 #include <src/version.cpp>
+#include <src/sink.cpp>
 #include <src/CSS/properties.cpp>
 #include <src/CSS/property.cpp>
 #include <src/CSS/element.cpp>
@@ -19,11 +20,20 @@
 #include <src/HTML/properties.cpp>
 #include <src/HTML/property.cpp>
 #include <src/HTML/section.cpp>
+#include <src/HTML/selector.cpp>
+#include <src/HTML/shared_section.cpp>
+#include <src/HTML/compiled_template.cpp>
+#include <src/HTML/renderer.cpp>
+#include <src/HTML/writer.cpp>
+#include <src/HTML/tree.cpp>
 #include <src/HTML/tag.cpp>
 #include <src/HTML/pseudocode_generator.cpp>
 #include <src/HTML/content_formatter.cpp>
-#ifdef BYGG_USE_LIBXML2
+#include <src/HTML/impl/parallel.cpp>
+#include <src/HTML/impl/escape.cpp>
+#include <src/HTML/impl/tokenizer.cpp>
 #include <src/HTML/parser.cpp>
+#ifdef BYGG_USE_LIBXML2
 #include <src/HTML/impl/libxml2.cpp>
 #endif
 // NOLINTEND
\ No newline at end of file
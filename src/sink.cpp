@@ -0,0 +1,155 @@
+/*
+ * bygg - Component-based HTML/CSS builder for C++
+ *
+ * Copyright 2024-2025 - Jacob Nilsson & contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <bygg/except.hpp>
+#include <bygg/sink.hpp>
+
+void bygg::Sink::fill(const char c, size_type count) {
+    static constexpr size_type chunk_size{64};
+    char chunk[chunk_size];
+    std::memset(chunk, c, std::min(count, chunk_size));
+
+    while (count > 0) {
+        const size_type n{std::min(count, chunk_size)};
+        this->write(chunk, n);
+        count -= n;
+    }
+}
+
+void bygg::StreamSink::write(const char* data, const size_type size) {
+    this->stream.write(data, static_cast<std::streamsize>(size));
+}
+
+void bygg::StreamSink::flush() {
+    this->stream.flush();
+}
+
+void bygg::StringSink::write(const char* data, const size_type size) {
+    this->target.append(data, size);
+}
+
+void bygg::TrimmingSink::write(const char* data, size_type size) {
+    if (size == 0) {
+        return;
+    }
+
+    if (this->pending_newline) {
+        this->sink.put('\n');
+        this->pending_newline = false;
+    }
+
+    if (data[size - 1] == '\n') {
+        this->pending_newline = true;
+        --size;
+    }
+
+    this->sink.write(data, size);
+}
+
+void bygg::FixedBufferSink::write(const char* data, size_type size) {
+    if (size > 0 && this->capacity == 0) {
+        throw out_of_range("Buffer has no capacity");
+    }
+
+    while (size > 0) {
+        if (this->used == this->capacity) {
+            if (!this->overflow) {
+                throw out_of_range("Buffer is full");
+            }
+
+            this->flush();
+        }
+
+        const size_type n{std::min(size, this->capacity - this->used)};
+        std::memcpy(this->buffer + this->used, data, n);
+
+        this->used += n;
+        data += n;
+        size -= n;
+    }
+}
+
+void bygg::FixedBufferSink::flush() {
+    if (this->overflow && this->used > 0) {
+        this->overflow(this->buffer, this->used);
+        this->used = 0;
+    }
+}
+
+bygg::size_type bygg::FixedBufferSink::size() const {
+    return this->used;
+}
+
+bygg::FileDescriptorSink::FileDescriptorSink(const int fd) : fd(fd), buffer(std::make_unique<char[]>(buffer_size)) {}
+
+bygg::FileDescriptorSink::~FileDescriptorSink() {
+    try {
+        this->flush();
+    } catch (...) {
+        // destructors must not throw; callers wanting errors flush first
+    }
+}
+
+void bygg::FileDescriptorSink::write_all(const char* data, size_type size) const {
+    while (size > 0) {
+#ifdef _WIN32
+        const auto n = ::_write(this->fd, data, static_cast<unsigned int>(std::min<size_type>(size, 1U << 30U)));
+#else
+        const auto n = ::write(this->fd, data, size);
+#endif
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw internal_error("Failed to write to file descriptor");
+        }
+
+        data += n;
+        size -= static_cast<size_type>(n);
+    }
+}
+
+void bygg::FileDescriptorSink::write(const char* data, const size_type size) {
+    if (size <= buffer_size - this->used) {
+        std::memcpy(this->buffer.get() + this->used, data, size);
+        this->used += size;
+        return;
+    }
+
+    this->flush();
+
+    // anything that would not fit in the buffer anyway is written directly
+    if (size >= buffer_size) {
+        this->write_all(data, size);
+        return;
+    }
+
+    std::memcpy(this->buffer.get(), data, size);
+    this->used = size;
+}
+
+void bygg::FileDescriptorSink::flush() {
+    if (this->used == 0) {
+        return;
+    }
+
+    // drop the bytes even if writing them fails, so the destructor does not retry
+    const size_type size{this->used};
+    this->used = 0;
+    this->write_all(this->buffer.get(), size);
+}
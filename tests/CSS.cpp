@@ -718,8 +718,48 @@ void CSS::test_stylesheet() {
     test_push_front_and_back();
     test_swap();
     test_size_empty_and_clear();
+    const auto test_move_semantics = []() {
+        using namespace bygg::CSS;
+
+        static_assert(std::is_nothrow_move_constructible_v<Property>);
+        static_assert(std::is_nothrow_move_constructible_v<Properties>);
+        static_assert(std::is_nothrow_move_constructible_v<Element>);
+        static_assert(std::is_nothrow_move_constructible_v<Stylesheet>);
+        static_assert(std::is_nothrow_move_constructible_v<Function>);
+        static_assert(std::is_nothrow_move_assignable_v<Property>);
+        static_assert(std::is_nothrow_move_assignable_v<Properties>);
+        static_assert(std::is_nothrow_move_assignable_v<Element>);
+        static_assert(std::is_nothrow_move_assignable_v<Stylesheet>);
+        static_assert(std::is_nothrow_move_assignable_v<Function>);
+
+        Stylesheet stylesheet{};
+
+        Element& element = stylesheet.emplace_back("p", make_properties(Property{"color", "red"}));
+        element.push_back(Property{"margin", "0"});
+
+        Element h1{"h1", make_properties(Property{"color", "blue"})};
+        stylesheet.push_front(std::move(h1));
+
+        REQUIRE(stylesheet.size() == 2);
+        REQUIRE(stylesheet.at(0).get_tag() == "h1");
+        REQUIRE(stylesheet.at(1).get_properties().size() == 2);
+
+        const std::string expected = stylesheet.get<std::string>();
+        Stylesheet moved{std::move(stylesheet)};
+        REQUIRE(moved.get<std::string>() == expected);
+
+        Stylesheet assigned{};
+        assigned = std::move(moved);
+        REQUIRE(assigned.get<std::string>() == expected);
+
+        const Property property{"display", "none"};
+        Element copied{"div", property};
+        REQUIRE(copied.get_properties().at(0).get_key() == "display");
+    };
+
     test_insert();
     test_iterators();
+    test_move_semantics();
 }
 
 void CSS::test_color_conversions() {
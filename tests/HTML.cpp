@@ -5,9 +5,21 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/socket.h>
+#endif
 #include <bygg/bygg.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include "test.hpp"
@@ -22,6 +34,24 @@ void HTML::test_tag() {
     for (const auto& it : expected_values) {
         REQUIRE((bygg::HTML::resolve_tag(it.first).first == it.second.first && bygg::HTML::resolve_tag(it.first).second == it.second.second));
     }
+
+    static_assert(bygg::HTML::get_tag_info(bygg::HTML::Tag::P).name == "p");
+    static_assert(bygg::HTML::get_tag_info(bygg::HTML::Tag::Img).type == bygg::HTML::Type::Standalone);
+    static_assert(bygg::HTML::get_tag_info(bygg::HTML::Tag::Xmp).enum_name == "Tag::Xmp");
+    static_assert(bygg::HTML::resolve_tag("div") == bygg::HTML::Tag::Div);
+    static_assert(bygg::HTML::is_container(bygg::HTML::Tag::Body));
+    static_assert(!bygg::HTML::is_container("span"));
+
+    for (const auto& it : bygg::HTML::tag_table) {
+        REQUIRE(bygg::HTML::get_tag_info(bygg::HTML::resolve_tag(it.name)).name == it.name);
+        REQUIRE(bygg::HTML::resolve_tag_enum_name(it.tag) == it.enum_name);
+        REQUIRE(bygg::HTML::is_container(it.tag) == bygg::HTML::is_container(it.name));
+    }
+
+    REQUIRE(bygg::HTML::resolve_tag(std::string{"html"}) == bygg::HTML::Tag::Html);
+    REQUIRE(bygg::HTML::is_container("foot"));
+    REQUIRE_THROWS_AS(bygg::HTML::resolve_tag("not-a-tag"), bygg::invalid_argument);
+    REQUIRE_THROWS_AS(bygg::HTML::resolve_tag(static_cast<bygg::HTML::Tag>(-1)), bygg::invalid_argument);
 }
 
 void HTML::test_property() {
@@ -525,12 +555,70 @@ void HTML::test_element() {
         REQUIRE(element2.get() == "<h1>This header contains an extra string</h1>");
     };
 
+    const auto test_parameters = []() {
+        using namespace bygg::HTML;
+
+        REQUIRE(Element{Tag::P, "  Some\ttext\n  with   spaces  "}.get() == "<p>Sometext with spaces</p>");
+        REQUIRE(Element{Tag::P, "a  b", ElementParameters::Erase_Spaces}.get() == "<p>ab</p>");
+        REQUIRE(Element{Tag::P, "<'a' \"b\">", ElementParameters::Erase_Left_Brackets | ElementParameters::Erase_Right_Brackets | ElementParameters::Erase_Single_Quotes | ElementParameters::Erase_Double_Quotes}.get() == "<p>a b</p>");
+        REQUIRE(Element{Tag::P, "a\n\tb <c> 'd' \"e\"", ElementParameters::Replace_All}.get() == "<p>a&#10;&#9;b&nbsp;&lt;c&gt;&nbsp;&apos;d&apos;&nbsp;&quot;e&quot;</p>");
+        REQUIRE(Element{Tag::P, "  a   b \n c  ", ElementParameters::Erase_Multi_Spaces | ElementParameters::Replace_Spaces | ElementParameters::Replace_Newlines}.get() == "<p>a&nbsp;b&nbsp;&#10;&nbsp;c</p>");
+        REQUIRE(Element{Tag::P, " \n ", ElementParameters::Default}.get() == "<p></p>");
+        REQUIRE(Element{Tag::P, "a b", ElementParameters::Default}.get() == "<p>a b</p>");
+
+        // long runs without anything to change are copied as they are
+        const std::string text(1000, 'x');
+        REQUIRE(Element{Tag::P, text + "<" + text, ElementParameters::Replace_Left_Brackets}.get() == "<p>" + text + "&lt;" + text + "</p>");
+        REQUIRE(Element{Tag::P, text + "     " + text + "\n"}.get() == "<p>" + text + " " + text + "</p>");
+        REQUIRE(Element{Tag::P, text + "<" + text, ElementParameters::Replace_Left_Brackets}.serialized_size() == 2 * text.size() + 11);
+
+        REQUIRE_THROWS_AS(Element(Tag::P, "text", ElementParameters::Erase_Tabs | ElementParameters::Replace_Tabs).get(), bygg::invalid_argument);
+        REQUIRE_THROWS_AS(Element(Tag::P, "text", ElementParameters::Erase_Spaces | ElementParameters::Erase_Multi_Spaces).get(), bygg::invalid_argument);
+    };
+
+    const auto test_escaping = []() {
+        using namespace bygg::HTML;
+
+        const Element element{Tag::A, Properties{Property{"href", "/?a=1&b=\"2\""}}, "<b> & 'c'"};
+
+        REQUIRE(element.get() == "<a href=\"/?a=1&b=\"2\"\"><b> & 'c'</a>");
+        REQUIRE(element.get(Formatting::None, 0, Escaping::Attributes) == "<a href=\"/?a=1&amp;b=&quot;2&quot;\"><b> & 'c'</a>");
+        REQUIRE(element.get(Formatting::None, 0, Escaping::All) == "<a href=\"/?a=1&amp;b=&quot;2&quot;\">&lt;b&gt; &amp; &apos;c&apos;</a>");
+        REQUIRE(element.serialized_size(Formatting::Pretty, 1, Escaping::All) == element.get(Formatting::Pretty, 1, Escaping::All).size());
+        REQUIRE(Property{"title", "x<y"}.get(Escaping::Attributes) == "title=\"x&lt;y\"");
+
+        // entities written by the parameters are not escaped again
+        REQUIRE(Element{Tag::P, "a <b>&", ElementParameters::Replace_Left_Brackets}.get(Formatting::None, 0, Escaping::All) == "<p>a &lt;b&gt;&amp;</p>");
+
+        // long clean runs are copied as they are
+        const std::string text(100, 'x');
+        REQUIRE(Element{Tag::P, text + "&" + text + "\""}.get(Formatting::None, 0, Escaping::All) == "<p>" + text + "&amp;" + text + "&quot;</p>");
+
+        Section section{Tag::Div, Properties{Property{"class", "a&b"}}};
+        section.push_back(element);
+        section.push_back(Section{Tag::Span, Properties{Property{"title", "<>"}}});
+
+        const std::string expected{"<div class=\"a&amp;b\">\n\t<a href=\"/?a=1&amp;b=&quot;2&quot;\">&lt;b&gt; &amp; &apos;c&apos;</a>\n\t<span title=\"&lt;&gt;\">\n\t</span>\n</div>"};
+
+        REQUIRE(section.get(Formatting::Pretty, 0, Escaping::All) == expected);
+        REQUIRE(section.serialized_size(Formatting::Pretty, 0, Escaping::All) == expected.size());
+        REQUIRE(Tree{section}.get(Formatting::Pretty, 0, Escaping::All) == expected);
+        REQUIRE(Document{section}.get(Formatting::None, 0, Escaping::Attributes).find("class=\"a&amp;b\"") != std::string::npos);
+
+        // cached output is kept apart for each kind of escaping
+        section.enable_cache();
+        REQUIRE(section.get(Formatting::Pretty) != expected);
+        REQUIRE(section.get(Formatting::Pretty, 0, Escaping::All) == expected);
+    };
+
     test_get_and_set();
     test_copy_element();
     test_operators();
     test_constructors();
     test_string_get();
     test_builder();
+    test_parameters();
+    test_escaping();
 }
 
 void HTML::test_section() {
@@ -833,6 +921,59 @@ void HTML::test_section() {
         }
     };
 
+    const auto test_filtered_iterators = []() {
+        using namespace bygg::HTML;
+
+        Section section{Tag::Html,
+            Section{Tag::Head},
+            Element{Tag::H1, "Header"},
+            Section{Tag::Body},
+            Section{Tag::Footer},
+            Element{Tag::H2, "Subheader"},
+        };
+
+        // the iterators refer to the members in place
+        REQUIRE(&*section.element_begin() == &std::get<Element>(section.get_all().at(1)));
+        REQUIRE(&*section.section_begin() == &std::get<Section>(section.get_all().at(0)));
+
+        REQUIRE(std::distance(section.element_begin(), section.element_end()) == 2);
+        REQUIRE(std::distance(section.section_cbegin(), section.section_cend()) == 3);
+        REQUIRE(std::distance(section.section_rbegin(), section.section_rend()) == 3);
+
+        for (auto it = section.element_begin(); it != section.element_end(); ++it) {
+            it->set_data(it->get_data() + "!");
+        }
+
+        REQUIRE(section.get_elements().at(0).get_data() == "Header!");
+        REQUIRE(section.get_elements().at(1).get_data() == "Subheader!");
+
+        *section.section_rbegin() = Section{Tag::Main};
+        REQUIRE(section.get_sections().at(2).get_tag() == "main");
+
+        const Section& const_section = section;
+        Section::section_const_iterator it = section.section_begin();
+        REQUIRE(it == const_section.section_begin());
+        REQUIRE((it++)->get_tag() == "head");
+        REQUIRE(it->get_tag() == "body");
+        REQUIRE((--it)->get_tag() == "head");
+
+        std::vector<bygg::string_type> tags{};
+        for (auto r_it = const_section.element_crbegin(); r_it != const_section.element_crend(); ++r_it) {
+            tags.push_back(r_it->get_tag());
+        }
+        REQUIRE(tags == std::vector<bygg::string_type>{"h2", "h1"});
+
+        const Section empty{Tag::Div};
+        REQUIRE(empty.element_begin() == empty.element_end());
+        REQUIRE(empty.section_crbegin() == empty.section_crend());
+
+        section.erase(Element{Tag::H1, "Header!"});
+        section.erase(Section{Tag::Body});
+        REQUIRE(section.size() == 3);
+        REQUIRE(section.get_elements().size() == 1);
+        REQUIRE(section.get_sections().size() == 2);
+    };
+
     const auto test_variant_iterators = []() {
         using namespace bygg::HTML;
 
@@ -916,6 +1057,21 @@ void HTML::test_section() {
         REQUIRE(section.find("data") == 0);
         REQUIRE(section.find("h1") == Section::npos);
         REQUIRE(section.find("bygg sucks") == Section::npos);
+
+        // sections are found by property, including right after an element
+        Section mixed{Tag::Div};
+        mixed.push_back(Element{Tag::P, Properties{Property{"class", "match"}}, "First"});
+        mixed.push_back(Section{Tag::Div, Properties{Property{"class", "match"}}});
+        mixed.push_back(Element{Tag::P, "Second"});
+        mixed.push_back(Section{Tag::Div, Properties{Property{"class", "match"}}});
+
+        const Property match{"class", "match"};
+        REQUIRE(mixed.find(match) == 0);
+        REQUIRE(mixed.find(match, 0, FindParameters::Search_Properties | FindParameters::Only_Sections) == 1);
+        REQUIRE(mixed.find(match, 2, FindParameters::Search_Properties | FindParameters::Only_Sections) == 3);
+        REQUIRE(mixed.find(match, 4, FindParameters::Search_Properties | FindParameters::Only_Sections) == Section::npos);
+        REQUIRE(mixed.find(match, 1) == 1);
+        REQUIRE(mixed.find(match, 0, FindParameters::Search_Properties | FindParameters::Only_Elements) == 0);
     };
 
     const auto test_insert = []() {
@@ -1146,13 +1302,666 @@ void HTML::test_section() {
         REQUIRE(Section().get<std::string>() == "");
     };
 
+    const auto test_move_semantics = []() {
+        using namespace bygg::HTML;
+
+        static_assert(std::is_nothrow_move_constructible_v<Property>);
+        static_assert(std::is_nothrow_move_constructible_v<Properties>);
+        static_assert(std::is_nothrow_move_constructible_v<Element>);
+        static_assert(std::is_nothrow_move_constructible_v<Section>);
+        static_assert(std::is_nothrow_move_constructible_v<Document>);
+        static_assert(std::is_nothrow_move_assignable_v<Property>);
+        static_assert(std::is_nothrow_move_assignable_v<Properties>);
+        static_assert(std::is_nothrow_move_assignable_v<Element>);
+        static_assert(std::is_nothrow_move_assignable_v<Section>);
+        static_assert(std::is_nothrow_move_assignable_v<Document>);
+        static_assert(std::is_nothrow_move_constructible_v<SharedSection>);
+        static_assert(std::is_nothrow_move_assignable_v<SharedSection>);
+        static_assert(std::is_nothrow_move_constructible_v<Section::variant_t>);
+        static_assert(std::is_nothrow_move_assignable_v<Section::variant_t>);
+
+        Section section{Tag::Div, make_properties(Property("class", "main"))};
+
+        Element& p = section.emplace_back<Element>(Tag::P, "Paragraph");
+        REQUIRE(p.get_tag() == "p");
+        Section& inner = section.emplace_back<Section>(Tag::Span);
+        inner.push_back(Element{Tag::B, "Bold"});
+
+        Element element{Tag::H1, "Heading"};
+        section.push_front(std::move(element));
+
+        REQUIRE(section.size() == 3);
+        REQUIRE(section.get<std::string>() == "<div class=\"main\"><h1>Heading</h1><p>Paragraph</p><span><b>Bold</b></span></div>");
+
+        const std::string expected = section.get<std::string>();
+        Section moved{std::move(section)};
+        REQUIRE(moved.get<std::string>() == expected);
+
+        Section assigned{};
+        assigned = std::move(moved);
+        REQUIRE(assigned.get<std::string>() == expected);
+
+        Properties properties{};
+        properties.emplace_back("id", "first");
+        properties.push_back(Property{"class", "second"});
+        REQUIRE(properties.size() == 2);
+        REQUIRE(properties.at(0).get_key() == "id");
+        REQUIRE(properties.at(1).get_value() == "second");
+
+        Document document{std::move(assigned)};
+        REQUIRE(document.get_section().get<std::string>() == expected);
+    };
+
+    const auto test_render_cache = []() {
+        using namespace bygg::HTML;
+
+        Section page{Tag::Html,
+            Section{Tag::Head,
+                Element{Tag::Title, "Title"}
+            },
+            Section{Tag::Body,
+                Section{Tag::Header,
+                    Element{Tag::H1, "Header"}
+                },
+                Section{Tag::Div, make_properties(Property("class", "content")),
+                    Element{Tag::P, "Content"}
+                },
+                Section{Tag::Footer,
+                    Element{Tag::P, "Footer"}
+                },
+            },
+        };
+
+        const auto expected = [&page](const Formatting formatting, const bygg::integer_type tabc) {
+            return Tree{page}.get(formatting, tabc);
+        };
+
+        page.enable_cache();
+        page.at_section(1).at_section(0).enable_cache();
+        page.at_section(1).at_section(2).enable_cache();
+
+        REQUIRE(page.is_cache_enabled());
+        REQUIRE(!page.at_section(1).is_cache_enabled());
+
+        for (const auto formatting : {Formatting::None, Formatting::Pretty, Formatting::Newline}) {
+            for (const bygg::integer_type tabc : {0, 2}) {
+                REQUIRE(page.get(formatting, tabc) == expected(formatting, tabc));
+                REQUIRE(page.get(formatting, tabc) == expected(formatting, tabc));
+                REQUIRE(page.serialized_size(formatting, tabc) == expected(formatting, tabc).size());
+            }
+        }
+
+        // references taken before rendering still invalidate every cache above them
+        Element& content = page.at_section(1).at_section(1).at(0);
+        Element& header = page.at_section(1).at_section(0).at(0);
+
+        REQUIRE(page.get(Formatting::Pretty) == expected(Formatting::Pretty, 0));
+
+        content.set_data("Changed content");
+        REQUIRE(page.get(Formatting::Pretty).find("Changed content") != std::string::npos);
+        REQUIRE(page.get(Formatting::Pretty) == expected(Formatting::Pretty, 0));
+
+        header.set_data("Changed header");
+        REQUIRE(page.get().find("Changed header") != std::string::npos);
+        REQUIRE(page.get() == expected(Formatting::None, 0));
+
+        page.at_section(1).at_section(2).set_tag(Tag::Div);
+        REQUIRE(page.get() == expected(Formatting::None, 0));
+
+        // growing the root moves its members; links are kept up to date
+        for (int i = 0; i < 64; ++i) {
+            page.push_back(Element{Tag::P, std::to_string(i)});
+        }
+        REQUIRE(page.get(Formatting::Pretty) == expected(Formatting::Pretty, 0));
+
+        page.at_section(1).at_section(0).at(0).set_data("Header again");
+        REQUIRE(page.get(Formatting::Pretty).find("Header again") != std::string::npos);
+        REQUIRE(page.get(Formatting::Pretty) == expected(Formatting::Pretty, 0));
+
+        page.erase(0);
+        REQUIRE(page.get() == expected(Formatting::None, 0));
+
+        page.at_section(0).at_section(2).push_back(Element{Tag::Span, "New"});
+        REQUIRE(page.get() == expected(Formatting::None, 0));
+
+        // changes through the underlying members after rendering need an explicit invalidation
+        const std::string before = page.get();
+        auto& members = page.at_section(0).at_section(0).get_all();
+        REQUIRE(page.get() == before);
+        members.push_back(Element{Tag::P, "Untracked"});
+        REQUIRE(page.get() == before);
+        page.at_section(0).at_section(0).invalidate_cache();
+        REQUIRE(page.get() != before);
+        REQUIRE(page.get() == expected(Formatting::None, 0));
+
+        // copies render the same, and disabling the cache drops it
+        Section copy = page;
+        REQUIRE(copy.get(Formatting::Pretty) == page.get(Formatting::Pretty));
+        copy.enable_cache(false);
+        REQUIRE(!copy.is_cache_enabled());
+        REQUIRE(copy.get(Formatting::Pretty) == page.get(Formatting::Pretty));
+
+        // once prepared, a cached section is only read when rendered, so it can be rendered from several threads
+        page.at_section(0).at_section(1).at(0).set_data("Prepared");
+        page.prepare_cache(Formatting::Pretty, 1);
+        const std::string prepared = expected(Formatting::Pretty, 1);
+
+        std::vector<std::string> results(4);
+        std::vector<std::thread> renderers{};
+        const Section& shared_page = page;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            renderers.emplace_back([&shared_page, &results, i]() {
+                for (int j = 0; j < 100; ++j) {
+                    results[i] = shared_page.get(Formatting::Pretty, 1);
+                }
+            });
+        }
+        for (auto& it : renderers) {
+            it.join();
+        }
+        for (const auto& it : results) {
+            REQUIRE(it == prepared);
+        }
+        REQUIRE(prepared.find("Prepared") != std::string::npos);
+    };
+
+    const auto test_remove_if = []() {
+        using namespace bygg::HTML;
+
+        const auto is_tag = [](const std::string& tag) {
+            return [tag](const Section::variant_t& member) {
+                return std::visit([&tag](const auto& it) { return it.get_tag() == tag; }, member);
+            };
+        };
+
+        Section section{Tag::Div};
+        for (int i{0}; i < 10; ++i) {
+            section.push_back(Element{i % 2 ? Tag::P : Tag::Span, std::to_string(i)});
+        }
+        section.push_back(Section{Tag::Script});
+
+        int calls{0};
+        REQUIRE(section.remove_if([&](const Section::variant_t& member) {
+            ++calls;
+            return std::holds_alternative<Element>(member) && std::get<Element>(member).get_tag() == "span";
+        }) == 5);
+        REQUIRE(calls == 11);
+        REQUIRE(section.get() == "<div><p>1</p><p>3</p><p>5</p><p>7</p><p>9</p><script></script></div>");
+        REQUIRE(section.remove_if(is_tag("table")) == 0);
+
+        REQUIRE(section.retain(is_tag("p")) == 1);
+        REQUIRE(section.size() == 5);
+
+        const auto it = section.erase(section.cbegin() + 1, section.cbegin() + 3);
+        REQUIRE(std::get<Element>(*it).get_data() == "7");
+        REQUIRE(section.get() == "<div><p>1</p><p>7</p><p>9</p></div>");
+        REQUIRE(section.erase(section.cbegin(), section.cbegin()) == section.begin());
+        section.erase(section.cbegin(), section.cend());
+        REQUIRE(section.empty());
+
+        Section page{Tag::Html,
+            Section{Tag::Head, Element{Tag::Script, "a()"}, Element{Tag::Title, "Title"}},
+            Section{Tag::Body,
+                Element{Tag::Script, "b()"},
+                Section{Tag::Div, Element{Tag::P, "Text"}, Element{Tag::Script, "c()"}},
+                Section{Tag::Script, Element{Tag::P, "Inside"}},
+            },
+        };
+        page.enable_cache();
+        REQUIRE(page.get().find("c()") != std::string::npos);
+
+        // erased sections are not descended into, and cached output is dropped
+        REQUIRE(page.remove_if_recursive(is_tag("script")) == 4);
+        REQUIRE(page.get() == "<html><head><title>Title</title></head><body><div><p>Text</p></div></body></html>");
+
+        REQUIRE(page.retain_recursive([](const Section::variant_t& member) { return std::holds_alternative<Section>(member); }) == 2);
+        REQUIRE(page.get() == "<html><head></head><body><div></div></body></html>");
+
+        // elements in the compacted sections still report changes to the section
+        std::get<Section>(page.at_section(1).get_all().at(0)).push_back(Element{Tag::P, "New"});
+        REQUIRE(page.get() == "<html><head></head><body><div><p>New</p></div></body></html>");
+    };
+
+    const auto test_shared_section = []() {
+        using namespace bygg::HTML;
+
+        Section nav{Tag::Nav, Properties{Property{"id", "nav"}},
+            Element{Tag::A, Properties{Property{"href", "/"}}, "Home"},
+            Element{Tag::A, Properties{Property{"href", "/about"}}, "About"},
+        };
+        const SharedSection header{Section{Tag::Header, Element{Tag::H1, "Site"}, nav}};
+        REQUIRE(header.get_tag() == "header");
+        REQUIRE(header.get() == "<header><h1>Site</h1><nav id=\"nav\"><a href=\"/\">Home</a><a href=\"/about\">About</a></nav></header>");
+
+        std::vector<Section> pages{};
+        for (int i{0}; i < 3; ++i) {
+            Section page{Tag::Body};
+            page += header;
+            page.push_back(Element{Tag::P, std::to_string(i)});
+            page.push_front(Element{Tag::Span, "Top"});
+            pages.push_back(page);
+        }
+        REQUIRE(header.use_count() == 4);
+        REQUIRE(std::get<SharedSection>(pages.at(0).get_all().at(1)).use_count() == 4);
+        REQUIRE(&*std::get<SharedSection>(pages.at(0).get_all().at(1)) == &*header);
+
+        // the output is the same as that of a deep copy
+        Section copy{Tag::Body};
+        copy.push_back(Element{Tag::Span, "Top"});
+        copy.push_back(*header);
+        copy.push_back(Element{Tag::P, "0"});
+        for (const Formatting formatting : {Formatting::None, Formatting::Pretty, Formatting::Newline}) {
+            REQUIRE(pages.at(0).get(formatting) == copy.get(formatting));
+            REQUIRE(pages.at(0).serialized_size(formatting) == copy.get(formatting).size());
+        }
+        REQUIRE(pages.at(0).get(Formatting::Pretty, 0, ParallelOptions{2, 1, 2}) == copy.get(Formatting::Pretty));
+        REQUIRE(Tree{pages.at(0)}.get(Formatting::Pretty) == copy.get(Formatting::Pretty));
+        REQUIRE(pages.at(0) == pages.at(0));
+        REQUIRE(pages.at(0) != pages.at(1));
+
+        // a shared subtree is opaque to lookups
+        REQUIRE(pages.at(0).get_by_id("nav") == nullptr);
+        REQUIRE(query_selector(pages.at(0), "a") == nullptr);
+        REQUIRE(query_selector_all(pages.at(0), "span, p").size() == 2);
+
+        // the shared subtree is never recorded in its own cache while rendering pages
+        Section& page{pages.at(1)};
+        page.enable_cache();
+        REQUIRE(page.get() == "<body><span>Top</span>" + header.get() + "<p>1</p></body>");
+
+        // changing one handle copies the subtree, and the page holding it is rendered again
+        std::get<SharedSection>(page.get_all().at(1)).modify([](Section& section) {
+            section.at_section(1).push_back(Element{Tag::A, Properties{Property{"href", "/blog"}}, "Blog"});
+        });
+        REQUIRE(header.use_count() == 3);
+        REQUIRE(page.get().find("Blog") != std::string::npos);
+        REQUIRE(pages.at(0).get().find("Blog") == std::string::npos);
+        REQUIRE(header.get().find("Blog") == std::string::npos);
+
+        // a handle that is not shared is changed in place
+        SharedSection footer{Section{Tag::Footer, Element{Tag::P, "Footer"}}};
+        const Section* previous{&*footer};
+        footer.modify([](Section& section) { section.set_tag(Tag::Div); });
+        REQUIRE(&*footer == previous);
+        REQUIRE(footer.get() == "<div><p>Footer</p></div>");
+
+        // the members of a shared subtree can only be read through the handle
+        static_assert(std::is_const_v<std::remove_reference_t<decltype(header->get_all())>>);
+        static_assert(std::is_const_v<std::remove_reference_t<decltype((*header).get_all())>>);
+
+        // moving a handle moves the reference rather than adding one
+        SharedSection moved{std::move(footer)};
+        REQUIRE(moved.use_count() == 1);
+        REQUIRE(&*moved == previous);
+        footer = std::move(moved);
+        REQUIRE(footer.use_count() == 1);
+        REQUIRE(&*footer == previous);
+
+        // a cache filled before sharing is reused by every page
+        Section cached{Tag::Footer, Element{Tag::P, "Cached"}};
+        cached.enable_cache();
+        REQUIRE(cached.get() == "<footer><p>Cached</p></footer>");
+        const SharedSection shared_footer{std::move(cached)};
+        pages.at(2).push_back(shared_footer);
+        REQUIRE(pages.at(2).get().find("<footer><p>Cached</p></footer>") != std::string::npos);
+    };
+
+    const auto test_compiled_template = []() {
+        using namespace bygg::HTML;
+
+        const auto make_page = [](const std::string& title, const std::string& link, const Section& content) {
+            return Section{Tag::Html,
+                Section{Tag::Head, Element{Tag::Title, title}},
+                Section{Tag::Body,
+                    Element{Tag::A, Properties{Property{"href", link}, Property{"class", "link"}}, title},
+                    Section{Tag::Div, Properties{Property{"id", "content"}}, content},
+                    Element{Tag::P, "Footer"},
+                },
+            };
+        };
+
+        REQUIRE(make_slot("title") == "\xEF\xB7\x90title\xEF\xB7\x91");
+        REQUIRE_THROWS_AS(make_slot("no spaces"), bygg::invalid_argument);
+        REQUIRE_THROWS_AS(make_slot(""), bygg::invalid_argument);
+
+        const Section content{Tag::Ul, Element{Tag::Li, "One"}, Element{Tag::Li, "Two"}};
+        const Section markers{make_page(make_slot("title"), make_slot("link"), Section{"", Element{"", make_slot("content"), Type::Text_No_Formatting}})};
+
+        const CompiledTemplate tmpl{markers};
+        REQUIRE(tmpl.get_slots() == std::vector<std::string>{"title", "link", "content"});
+        REQUIRE(tmpl.has_slot("link"));
+        REQUIRE_FALSE(tmpl.has_slot("footer"));
+
+        // filling the slots gives the same output as building the page
+        const Slots slots{{"title", std::string{"Home"}}, {"link", std::string{"/"}}, {"content", content}};
+        REQUIRE(tmpl.get(slots) == make_page("Home", "/", content).get());
+        {
+            std::string out{};
+            bygg::StringSink sink{out};
+            tmpl.write_to(sink, slots);
+            REQUIRE(out == tmpl.get(slots));
+        }
+
+        // missing slots are left empty, and values of every kind can be used
+        REQUIRE(tmpl.get() == "<html><head><title></title></head><body><a href=\"\" class=\"link\"></a><div id=\"content\"></div><p>Footer</p></body></html>");
+        Slots other{};
+        other.set("title", std::string{"A & B"}).set("content", Element{Tag::Span, "Text"});
+        REQUIRE(tmpl.get(other).find("<title>A & B</title>") != std::string::npos);
+        REQUIRE(tmpl.get(other).find("<div id=\"content\"><span>Text</span></div>") != std::string::npos);
+        other.set("content", SharedSection{content});
+        REQUIRE(tmpl.get(other).find(content.get()) != std::string::npos);
+        other.clear();
+        REQUIRE(other.get("title") == nullptr);
+
+        // text is escaped as the template requires, in attributes or everywhere
+        const Slots unsafe{{"title", std::string{"<b>"}}, {"link", std::string{"/?a=\"1\""}}};
+        const std::string attributes{CompiledTemplate{markers, Formatting::None, 0, Escaping::Attributes}.get(unsafe)};
+        REQUIRE(attributes.find("<title><b></title>") != std::string::npos);
+        REQUIRE(attributes.find("href=\"/?a=&quot;1&quot;\"") != std::string::npos);
+        REQUIRE(CompiledTemplate{markers, Formatting::None, 0, Escaping::All}.get(unsafe) == make_page("<b>", "/?a=\"1\"", Section{}).get(Formatting::None, 0, Escaping::All));
+
+        // markers that start a line are indented like the line
+        const CompiledTemplate pretty{make_page(make_slot("title"), make_slot("link"), Section{"", Element{"", make_slot("content"), Type::Text}}), Formatting::Pretty};
+        const std::string page{pretty.get({{"title", std::string{"Home"}}, {"link", std::string{"/"}}, {"content", content}})};
+        REQUIRE(page.find("\t\t<div id=\"content\">\n\t\t\t<ul>\n\t\t\t\t<li>One</li>\n") != std::string::npos);
+        REQUIRE(page.find("\t\t\t</ul>\n\t\t</div>") != std::string::npos);
+        REQUIRE(pretty.get().find("<div id=\"content\">\n\t\t\t\t\t</div>") != std::string::npos);
+
+        // text that only looks like a marker is kept
+        const CompiledTemplate plain{Section{Tag::P, Element{"", "{{not a slot}} {x}} {{}}", Type::Text_No_Formatting}}};
+        REQUIRE(plain.get_slots().empty());
+        REQUIRE(plain.get() == "<p>{{not a slot}} {x}} {{}}</p>");
+
+        // such as the templates of other tools, even with the same names as slots
+        const CompiledTemplate literal{Section{Tag::Body,
+            Element{Tag::Pre, "{{title}} {{ title }}"},
+            Element{Tag::Script, "app.title = '{{title}}';"},
+            Element{Tag::H1, make_slot("title")},
+        }};
+        REQUIRE(literal.get_slots() == std::vector<std::string>{"title"});
+        REQUIRE(literal.get({{"title", std::string{"Home"}}}) == "<body><pre>{{title}} {{ title }}</pre><script>app.title = '{{title}}';</script><h1>Home</h1></body>");
+
+        // each marker is escaped as its own place requires, not as the other markers of the slot
+        const CompiledTemplate mixed{Section{Tag::Div, Properties{Property{"title", make_slot("name")}}, Element{Tag::P, make_slot("name")}}, Formatting::None, 0, Escaping::Attributes};
+        REQUIRE(mixed.get({{"name", std::string{"<a & \"b\">"}}}) == "<div title=\"&lt;a &amp; &quot;b&quot;&gt;\"><p><a & \"b\"></p></div>");
+
+        const Section reserved{Tag::P, Element{Tag::Span, "\xEF\xB7\x92" "0\xEF\xB7\x91"}};
+        REQUIRE_THROWS_AS(CompiledTemplate{reserved}, bygg::invalid_argument);
+    };
+
+    const auto test_index = []() {
+        using namespace bygg::HTML;
+
+        Section root{Tag::Body};
+        Section& nav = root.emplace_back<Section>(Tag::Nav, Properties{Property{"id", "nav"}, Property{"class", "menu  dark"}});
+        nav.push_back(Element{Tag::A, Properties{Property{"class", "link"}, Property{"href", "/"}}, "Home"});
+        nav.push_back(Element{Tag::A, Properties{Property{"class", "link dark"}, Property{"href", "/about"}}, "About"});
+        root.push_back(Element{Tag::P, Properties{Property{"id", "text"}}, "Text"});
+
+        const auto lookups = [](const Section& section) {
+            REQUIRE(section.get_by_id("nav") != nullptr);
+            REQUIRE(std::get<Section>(*section.get_by_id("nav")).get_tag() == "nav");
+            REQUIRE(std::get<Element>(*section.get_by_id("text")).get_data() == "Text");
+            REQUIRE(section.get_by_id("missing") == nullptr);
+            REQUIRE(section.get_by_class("link").size() == 2);
+            REQUIRE(section.get_by_class("dark").size() == 2);
+            REQUIRE(section.get_by_class("menu").size() == 1);
+            REQUIRE(section.get_by_tag(Tag::A).size() == 2);
+            REQUIRE(std::get<Element>(*section.get_by_tag("a").at(1)).get_data() == "About");
+            REQUIRE(section.get_by_tag(Tag::Body).empty());
+        };
+
+        // lookups work without the index as well
+        lookups(root);
+
+        root.enable_index();
+        REQUIRE(root.is_index_enabled());
+        lookups(root);
+
+        // changes anywhere below the section are picked up by the next lookup
+        std::get<Section>(*root.get_by_id("nav")).push_back(Element{Tag::A, Properties{Property{"class", "link"}}, "Contact"});
+        REQUIRE(root.get_by_class("link").size() == 3);
+
+        std::get<Element>(*root.get_by_tag(Tag::A).at(0)).set_properties(Properties{Property{"id", "home"}});
+        REQUIRE(root.get_by_class("link").size() == 2);
+        REQUIRE(std::get<Element>(*root.get_by_id("home")).get_data() == "Home");
+
+        std::get<Section>(*root.get_by_id("nav")).set_properties(Properties{});
+        REQUIRE(root.get_by_id("nav") == nullptr);
+        REQUIRE(root.get_by_class("menu").empty());
+
+        for (int i{0}; i < 100; ++i) {
+            root.push_back(Section{Tag::Div, Properties{Property{"id", "div" + std::to_string(i)}}});
+        }
+
+        REQUIRE(root.get_by_tag(Tag::Div).size() == 100);
+        std::get<Section>(*root.get_by_id("div42")).push_back(Element{Tag::Span, Properties{Property{"id", "deep"}}, "Deep"});
+        REQUIRE(std::get<Element>(*root.get_by_id("deep")).get_data() == "Deep");
+
+        root.erase(0);
+        REQUIRE(root.get_by_tag(Tag::A).empty());
+        REQUIRE(root.get_by_id("home") == nullptr);
+
+        const Section copy{root};
+        REQUIRE(copy.is_index_enabled());
+        REQUIRE(copy.get_by_id("deep") != nullptr);
+        REQUIRE(copy.get_by_id("deep") != root.get_by_id("deep"));
+
+        root.enable_index(false);
+        REQUIRE(root.get_by_tag(Tag::Div).size() == 100);
+
+        // dropping an inner index leaves an index further up intact
+        Section outer{Tag::Body, {Section{Tag::Main, {Section{Tag::Div, {Element{Tag::P, "Text"}}}}}}};
+        outer.enable_index();
+        REQUIRE(outer.get_by_tag(Tag::P).size() == 1);
+
+        Section& inner{outer.at_section(0)};
+        inner.enable_index();
+        REQUIRE(inner.get_by_tag(Tag::P).size() == 1);
+        inner.enable_index(false);
+
+        inner.at_section(0).push_back(Element{Tag::P, Properties{Property{"id", "second"}}, "More"});
+        REQUIRE(outer.get_by_tag(Tag::P).size() == 2);
+        REQUIRE(outer.get_by_id("second") != nullptr);
+        inner.at_section(0).push_back(Element{Tag::P, "Last"});
+        REQUIRE(outer.get_by_tag(Tag::P).size() == 3);
+        REQUIRE(inner.get_by_tag(Tag::P).size() == 3);
+    };
+
+    const auto test_parallel = []() {
+        using namespace bygg::HTML;
+
+        Section table{Tag::Table};
+        for (int i{0}; i < 2000; ++i) {
+            Section row{Tag::Tr, make_properties(Property("id", std::to_string(i)))};
+            row += Element{Tag::Td, "Cell " + std::to_string(i)};
+            row += Element{Tag::Td, "<b>" + std::to_string(i * 2) + "</b>"};
+            table += row;
+        }
+
+        Section list{Tag::Ul};
+        for (int i{0}; i < 1500; ++i) {
+            list += Element{Tag::Li, "Item " + std::to_string(i)};
+        }
+
+        Document document{Section{Tag::Html,
+            Section{Tag::Head,
+                Element{Tag::Title, "Title"}
+            },
+            Section{Tag::Body,
+                table,
+                Section{},
+                list,
+            },
+        }};
+
+        const Section& page = document.get_section();
+
+        ParallelOptions options{};
+        options.threads = 4;
+        options.min_members = 1000;
+
+        for (const Formatting formatting : {Formatting::None, Formatting::Pretty, Formatting::Newline}) {
+            for (const bygg::integer_type tabc : {0, 2}) {
+                REQUIRE(page.get(formatting, tabc, options) == page.get(formatting, tabc));
+                REQUIRE(document.get(formatting, tabc, options) == document.get(formatting, tabc));
+            }
+        }
+
+        options.chunk_size = 7;
+        REQUIRE(page.get(Formatting::Pretty, 0, options) == page.get(Formatting::Pretty));
+
+        std::string out{};
+        bygg::StringSink sink{out};
+        page.write_to(sink, Formatting::Pretty, 1, options);
+        REQUIRE(out == page.get(Formatting::Pretty, 1));
+
+        // sections below the threshold are serialized on the calling thread
+        options.min_members = 100000;
+        REQUIRE(page.get(Formatting::Pretty, 0, options) == page.get(Formatting::Pretty));
+
+        // a custom executor receives every chunk but the first of each section
+        int submitted{0};
+        options.min_members = 1000;
+        options.chunk_size = 100;
+        options.executor = [&submitted](std::function<void()> task) {
+            ++submitted;
+            task();
+        };
+        REQUIRE(page.get(Formatting::Newline, 0, options) == page.get(Formatting::Newline));
+        REQUIRE(submitted == 19 + 14);
+
+        std::vector<std::thread> threads{};
+        options.executor = [&threads](std::function<void()> task) {
+            threads.emplace_back(std::move(task));
+        };
+        REQUIRE(page.get(Formatting::Pretty, 0, options) == page.get(Formatting::Pretty));
+        for (auto& it : threads) {
+            it.join();
+        }
+
+        // exceptions thrown by the executor are passed on
+        options.executor = [](std::function<void()>) {
+            throw std::runtime_error{"Executor is full"};
+        };
+        REQUIRE_THROWS_AS(page.get(Formatting::None, 0, options), std::runtime_error);
+
+        // caching is kept up to date by parallel rendering
+        Section cached{page};
+        cached.enable_cache();
+        options.executor = {};
+        options.chunk_size = 0;
+        REQUIRE(cached.get(Formatting::Pretty, 0, options) == page.get(Formatting::Pretty));
+        cached.at_section(1).at_section(0).at_section(1999).at(0).set_data("Changed");
+        REQUIRE(cached.get(Formatting::Pretty).find("Changed") != std::string::npos);
+        REQUIRE(cached.get(Formatting::Pretty, 0, options) == cached.get(Formatting::Pretty));
+    };
+
+    const auto test_hash = []() {
+        using namespace bygg::HTML;
+
+        const auto make_list = [](const std::string& last) {
+            return Section{Tag::Div, Properties{Property{"class", "list"}},
+                Section{Tag::Ul,
+                    Section{Tag::Li, Element{Tag::A, Properties{Property{"href", "/a"}}, "A"}},
+                    Section{Tag::Li, Element{Tag::A, Properties{Property{"href", "/b"}}, last}},
+                },
+                Element{Tag::P, "Footer"},
+            };
+        };
+
+        Section section{make_list("B")};
+        const Section same{make_list("B")};
+        REQUIRE(section.get_hash() == same.get_hash());
+        REQUIRE(std::hash<Section>{}(section) == std::hash<Section>{}(same));
+        REQUIRE(section == same);
+        REQUIRE(section.get_hash() != make_list("C").get_hash());
+        REQUIRE(section != make_list("C"));
+
+        // elements, sections and their parts do not hash alike
+        REQUIRE(Element{Tag::P, "Text"}.get_hash() == Element{Tag::P, "Text"}.get_hash());
+        REQUIRE(Element{Tag::P, "Text"}.get_hash() != Element{Tag::P, "Other"}.get_hash());
+        REQUIRE(Element{Tag::P, "Text"}.get_hash() != Element{Tag::Span, "Text"}.get_hash());
+        REQUIRE(Element{Tag::P, "Text"}.get_hash() != Section{Tag::P}.get_hash());
+        REQUIRE(Element{Tag::P, Properties{Property{"a", "bc"}}}.get_hash() != Element{Tag::P, Properties{Property{"ab", "c"}}}.get_hash());
+        REQUIRE(Section{Tag::Div, Section{Tag::Div}}.get_hash() != Section{Tag::Div, Element{Tag::Div}}.get_hash());
+
+        // changes deep in the tree reach the hash of the root
+        const std::uint64_t previous{section.get_hash()};
+        section.at_section(0).at_section(1).at(0).set_data("C");
+        REQUIRE(section.get_hash() != previous);
+        REQUIRE(section.get_hash() == make_list("C").get_hash());
+        section.at_section(0).at_section(1).at(0).set_data("B");
+        REQUIRE(section.get_hash() == previous);
+        section.at_section(0).push_back(Element{Tag::Li, "New"});
+        REQUIRE(section.get_hash() != previous);
+        REQUIRE(section != same);
+
+        // hashing and caching keep each other up to date
+        Section cached{make_list("B")};
+        cached.enable_cache();
+        REQUIRE(cached.get() == same.get());
+        REQUIRE(cached.get_hash() == same.get_hash());
+        cached.at_section(0).at_section(0).at(0).set_data("Changed");
+        REQUIRE(cached.get().find("Changed") != std::string::npos);
+        REQUIRE(cached.get_hash() != same.get_hash());
+
+        std::unordered_set<Section> sections{};
+        for (int i{0}; i < 10; ++i) {
+            sections.insert(make_list(std::to_string(i % 3)));
+        }
+        REQUIRE(sections.size() == 3);
+        REQUIRE(sections.count(make_list("1")) == 1);
+        REQUIRE(std::unordered_set<Element>{Element{Tag::P, "A"}, Element{Tag::P, "A"}, Element{Tag::P, "B"}}.size() == 2);
+
+        // shared sections hash like the section they hold
+        SharedSection shared{make_list("B")};
+        REQUIRE(shared.get_hash() == same.get_hash());
+        SharedSection copy{shared};
+        REQUIRE(copy == shared);
+        copy.modify([](Section& it) { it.at_section(0).at_section(1).at(0).set_data("C"); });
+        REQUIRE(copy.get_hash() == make_list("C").get_hash());
+        REQUIRE(copy != shared);
+
+        Section page{Tag::Body, shared};
+        const std::uint64_t page_hash{page.get_hash()};
+        REQUIRE(page_hash == Section{Tag::Body, same}.get_hash());
+        std::get<SharedSection>(page.get_all().at(0)).modify([](Section& it) { it.set_tag(Tag::Nav); });
+        REQUIRE(page.get_hash() != page_hash);
+
+        // comparing does not rely on hashes, which changes made through references to the members do not reach
+        Section edited{make_list("B")};
+        Section other{make_list("B")};
+        auto& members = edited.get_all();
+        REQUIRE(edited == other);
+        members.push_back(Element{Tag::P, "Added"});
+        REQUIRE(edited != other);
+        other.get_all().push_back(Element{Tag::P, "Added"});
+        REQUIRE(edited.get() == other.get());
+        REQUIRE(edited == other);
+
+        // documents compare their sections without serializing them
+        REQUIRE(Document{make_list("B")} == Document{make_list("B")});
+        REQUIRE(Document{make_list("B")} != Document{make_list("C")});
+        REQUIRE(Document{make_list("B")} != Document{make_list("B"), "<!DOCTYPE other>"});
+    };
+
     test_get_and_set();
     test_copy_section();
     test_operators();
     test_constructors();
     test_iterators();
     test_variant_iterators();
+    test_render_cache();
+    test_parallel();
+    test_index();
+    test_remove_if();
+    test_shared_section();
+    test_compiled_template();
+    test_hash();
+    test_move_semantics();
     test_section_iterators();
+    test_filtered_iterators();
     test_find();
     test_insert();
     test_swap();
@@ -1340,6 +2149,728 @@ void HTML::test_document() {
     test_constructors();
 }
 
+void HTML::test_sink() {
+    const auto make_page = []() {
+        using namespace bygg::HTML;
+
+        return Section{Tag::Html,
+            Section{Tag::Head,
+                Element{Tag::Title, "Title"}
+            },
+            Section{Tag::Body, make_properties(Property("class", "main")),
+                Element{Tag::H1, "Hello, World!"},
+                Element{Tag::Img, make_properties(Property("src", "image.png"))},
+                Section{Tag::Div,
+                    Element{Tag::P, "Paragraph"}
+                },
+            },
+        };
+    };
+
+    const auto test_string_sink = [&make_page]() {
+        using namespace bygg::HTML;
+
+        const Section section = make_page();
+
+        for (const auto formatting : {Formatting::None, Formatting::Pretty, Formatting::Newline}) {
+            std::string out{};
+            bygg::StringSink sink{out};
+            section.write_to(sink, formatting);
+
+            REQUIRE(out == section.get(formatting));
+
+            std::string out_tabbed{};
+            bygg::StringSink sink_tabbed{out_tabbed};
+            section.write_to(sink_tabbed, formatting, 2);
+
+            REQUIRE(out_tabbed == section.get(formatting, 2));
+        }
+
+        std::string empty{};
+        bygg::StringSink empty_sink{empty};
+        Section{}.write_to(empty_sink);
+
+        REQUIRE(empty.empty());
+
+        const Element element{Tag::P, make_properties(Property("id", "p")), "data"};
+
+        std::string element_out{};
+        bygg::StringSink element_sink{element_out};
+        element.write_to(element_sink, Formatting::Pretty, 1);
+
+        REQUIRE(element_out == element.get(Formatting::Pretty, 1));
+    };
+
+    const auto test_stream_sink = [&make_page]() {
+        using namespace bygg::HTML;
+
+        const Document document{make_page()};
+
+        std::ostringstream stream{};
+        bygg::StreamSink sink{stream};
+        document.write_to(sink, Formatting::Pretty);
+
+        REQUIRE(stream.str() == document.get(Formatting::Pretty));
+    };
+
+    const auto test_fixed_buffer_sink = [&make_page]() {
+        using namespace bygg::HTML;
+
+        const Document document{make_page()};
+
+        char buffer[7]{};
+        std::string drained{};
+        bygg::FixedBufferSink sink{buffer, sizeof(buffer), [&drained](const char* data, bygg::size_type size) {
+            drained.append(data, size);
+        }};
+
+        document.write_to(sink, Formatting::Newline);
+        sink.flush();
+
+        REQUIRE(sink.size() == 0);
+        REQUIRE(drained == document.get(Formatting::Newline));
+
+        char small[4]{};
+        bygg::FixedBufferSink full_sink{small, sizeof(small)};
+
+        REQUIRE_THROWS_AS(document.write_to(full_sink), bygg::out_of_range);
+        REQUIRE(full_sink.size() == sizeof(small));
+    };
+
+    const auto test_serialized_size = [&make_page]() {
+        using namespace bygg::HTML;
+
+        const Section page = make_page();
+        const Document document{page};
+        const Section edge_cases{Tag::Div,
+            Element{Tag::P, "  multiple   spaces\tand\ttabs  "},
+            Element{Tag::P, "<'quoted' \"text\">", ElementParameters::Replace_All},
+            Element{"", "no tag"},
+            Element{"", "text", Type::Text},
+            Section{},
+            Section{bygg::string_type{}, make_properties(Property("class", "ignored"))},
+            Element{"", "trailing\n", Type::Text_No_Formatting, ElementParameters::Erase_None},
+        };
+        const Section trailing_text{bygg::string_type{},
+            Element{"", "text\n", Type::Text, ElementParameters::Erase_None},
+        };
+
+        for (const auto formatting : {Formatting::None, Formatting::Pretty, Formatting::Newline}) {
+            for (const bygg::integer_type tabc : {0, 1, 3}) {
+                REQUIRE(page.serialized_size(formatting, tabc) == page.get(formatting, tabc).size());
+                REQUIRE(document.serialized_size(formatting, tabc) == document.get(formatting, tabc).size());
+                REQUIRE(edge_cases.serialized_size(formatting, tabc) == edge_cases.get(formatting, tabc).size());
+                REQUIRE(trailing_text.serialized_size(formatting, tabc) == trailing_text.get(formatting, tabc).size());
+
+                for (const auto& it : edge_cases) {
+                    if (std::holds_alternative<Element>(it)) {
+                        const auto& element = std::get<Element>(it);
+                        REQUIRE(element.serialized_size(formatting, tabc) == element.get(formatting, tabc).size());
+                    }
+                }
+            }
+        }
+
+        REQUIRE(Section{}.serialized_size() == 0);
+        REQUIRE(Document{}.serialized_size() == Document{}.get().size());
+    };
+
+#ifndef _WIN32
+    const auto test_file_descriptor_sink = [&make_page]() {
+        using namespace bygg::HTML;
+
+        const Section section = make_page();
+        const std::string expected = section.get(Formatting::Pretty);
+
+        int fds[2]{};
+        REQUIRE(pipe(fds) == 0);
+
+        const auto read_all = [](const int fd) {
+            std::string out{};
+            char buffer[4096]{};
+            ssize_t n{};
+            while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+                out.append(buffer, static_cast<std::size_t>(n));
+            }
+            return out;
+        };
+
+        {
+            bygg::FileDescriptorSink sink{fds[1]};
+            section.write_to(sink, Formatting::Pretty);
+        }
+        close(fds[1]);
+
+        REQUIRE(read_all(fds[0]) == expected);
+        close(fds[0]);
+
+        // output is held in the buffer until it fills up or is flushed
+        Section table{Tag::Table};
+        for (int i{0}; i < 5000; ++i) {
+            table += Section{Tag::Tr, Element{Tag::Td, Properties{Property{"class", "x"}}, "Cell " + std::to_string(i)}};
+        }
+        const std::string large = table.get(Formatting::Pretty);
+        REQUIRE(large.size() > 2 * bygg::FileDescriptorSink::buffer_size);
+
+        FILE* file = std::tmpfile();
+        REQUIRE(file != nullptr);
+        const int fd = fileno(file);
+
+        bygg::FileDescriptorSink file_sink{fd};
+        section.write_to(file_sink, Formatting::Pretty);
+        REQUIRE(lseek(fd, 0, SEEK_END) == 0);
+
+        file_sink.flush();
+        REQUIRE(lseek(fd, 0, SEEK_END) == static_cast<off_t>(expected.size()));
+
+        table.write_to(file_sink, Formatting::Pretty);
+        file_sink.write(large.data(), large.size());
+        file_sink.flush();
+
+        REQUIRE(lseek(fd, 0, SEEK_SET) == 0);
+        REQUIRE(read_all(fd) == expected + large + large);
+        std::fclose(file);
+    };
+#endif
+
+    const auto test_renderer = [&make_page]() {
+        using namespace bygg::HTML;
+
+        const auto render = [](Renderer& renderer, const bygg::size_type capacity) {
+            std::string out{};
+            std::vector<char> buffer(capacity);
+            bygg::size_type largest{0};
+
+            for (bygg::size_type n{}; (n = renderer.next_chunk(buffer.data(), buffer.size())) != 0;) {
+                largest = std::max(largest, n);
+                out.append(buffer.data(), n);
+            }
+
+            REQUIRE(largest <= capacity);
+            REQUIRE(renderer.done());
+            return out;
+        };
+
+        const SharedSection shared{Section{Tag::Footer, Element{Tag::P, "Shared"}}};
+        Section cached{Tag::Div, Element{Tag::P, "Cached"}};
+        cached.enable_cache();
+
+        Section page{make_page()};
+        page.push_back(Section{bygg::string_type{},
+            Element{"", "text", Type::Text},
+            Section{},
+            Element{"", "trailing\n", Type::Text_No_Formatting, ElementParameters::Erase_None},
+        });
+        page.push_back(shared);
+        page.push_back(cached);
+        static_cast<void>(page.get(Formatting::Pretty));
+
+        for (const auto formatting : {Formatting::None, Formatting::Pretty, Formatting::Newline}) {
+            for (const bygg::integer_type tabc : {0, 2}) {
+                for (const bygg::size_type capacity : {1, 7, 4096}) {
+                    Renderer renderer{page, formatting, tabc};
+                    REQUIRE(render(renderer, capacity) == page.get(formatting, tabc));
+
+                    const Document document{page};
+                    Renderer doc_renderer{document, formatting, tabc, Escaping::All};
+                    REQUIRE(render(doc_renderer, capacity) == document.get(formatting, tabc, Escaping::All));
+                }
+            }
+        }
+
+        const Section empty_section{};
+        Renderer empty{empty_section};
+        REQUIRE(render(empty, 16).empty());
+        const Document empty_document{};
+        Renderer doctype{empty_document, Formatting::Pretty};
+        REQUIRE(render(doctype, 16) == empty_document.get(Formatting::Pretty));
+
+        // a chunk ends after a flush point, however much room is left
+        Section flushed{make_page()};
+        flushed.at_section(0).set_flush_point();
+        REQUIRE(Section{flushed}.is_flush_point() == false);
+        REQUIRE(Section{flushed}.at_section(0).is_flush_point());
+
+        Renderer renderer{flushed, Formatting::Pretty};
+        char buffer[4096]{};
+        const bygg::size_type first{renderer.next_chunk(buffer, sizeof(buffer))};
+        REQUIRE(std::string(buffer, first) == "<html>\n\t<head>\n\t\t<title>Title</title>\n\t</head>");
+        REQUIRE(!renderer.done());
+        REQUIRE(std::string(buffer, first) + render(renderer, 4096) == flushed.get(Formatting::Pretty));
+    };
+
+    const auto test_writer = []() {
+        using namespace bygg::HTML;
+
+        const auto write = [](Writer& writer) {
+            writer.open(Tag::Html)
+                .open(Tag::Head).element(Tag::Title, "Title").close(Tag::Head)
+                .open(Tag::Body, make_properties(Property("class", "main"), Property("empty", "")))
+                    .element(Tag::H1, "Hello, <World>!")
+                    .element(Tag::Img, make_properties(Property("src", "a\"b.png")))
+                    .open("")
+                        .text("text")
+                        .element("", "trailing\n", Type::Text_No_Formatting, ElementParameters::Erase_None)
+                    .close()
+                    .open(Tag::Div, make_properties(Property("id", "rows")));
+
+            for (int i{0}; i < 3; ++i) {
+                writer.open(Tag::Tr, make_properties(Property("id", "row-" + std::to_string(i))))
+                    .element(Tag::Td, std::to_string(i))
+                    .element("td", make_properties(Property("class", "name")), "Name & more")
+                    .close(Tag::Tr);
+            }
+
+            writer.element(Element{Tag::P, "<'quoted' \"text\">", ElementParameters::Replace_All})
+                .open(Tag::Span).close()
+                .close(Tag::Div)
+                .close(Tag::Body)
+                .close(Tag::Html);
+        };
+
+        Section rows{Tag::Div, make_properties(Property("id", "rows"))};
+        for (int i{0}; i < 3; ++i) {
+            rows.push_back(Section{Tag::Tr, make_properties(Property("id", "row-" + std::to_string(i))),
+                Element{Tag::Td, std::to_string(i)},
+                Element{"td", make_properties(Property("class", "name")), "Name & more"},
+            });
+        }
+        rows.push_back(Element{Tag::P, "<'quoted' \"text\">", ElementParameters::Replace_All});
+        rows.push_back(Section{Tag::Span});
+
+        const Section expected{Tag::Html,
+            Section{Tag::Head, Element{Tag::Title, "Title"}},
+            Section{Tag::Body, make_properties(Property("class", "main"), Property("empty", "")),
+                Element{Tag::H1, "Hello, <World>!"},
+                Element{Tag::Img, make_properties(Property("src", "a\"b.png"))},
+                Section{bygg::string_type{},
+                    Element{"", "text", Type::Text},
+                    Element{"", "trailing\n", Type::Text_No_Formatting, ElementParameters::Erase_None},
+                },
+                rows,
+            },
+        };
+
+        for (const auto formatting : {Formatting::None, Formatting::Pretty, Formatting::Newline}) {
+            for (const bygg::integer_type tabc : {0, 2}) {
+                for (const auto escaping : {Escaping::None, Escaping::All}) {
+                    std::string out{};
+                    bygg::StringSink sink{out};
+                    Writer writer{sink, formatting, tabc, escaping};
+                    write(writer);
+                    writer.finish();
+
+                    REQUIRE(out == expected.get(formatting, tabc, escaping));
+                }
+            }
+        }
+
+        // sections must be closed in the order they were opened
+        std::string out{};
+        bygg::StringSink sink{out};
+        Writer writer{sink};
+        writer.open(Tag::Div).open("custom");
+        REQUIRE(writer.depth() == 2);
+        REQUIRE_THROWS_AS(writer.close(Tag::Div), bygg::invalid_argument);
+        REQUIRE_THROWS_AS(writer.finish(), bygg::invalid_argument);
+        writer.close("custom").close(Tag::Div);
+        REQUIRE(writer.depth() == 0);
+        REQUIRE_THROWS_AS(writer.close(), bygg::out_of_range);
+        writer.finish();
+        REQUIRE(out == "<div><custom></custom></div>");
+    };
+
+#ifndef _WIN32
+    const auto test_renderer_socket = []() {
+        using namespace bygg::HTML;
+
+        const auto make_large_page = [](const bygg::size_type paragraphs) {
+            Section page{Tag::Html,
+                Section{Tag::Head, Element{Tag::Title, "Title"}},
+                Section{Tag::Body},
+            };
+            page.at_section(0).set_flush_point();
+
+            for (bygg::size_type i{0}; i < paragraphs; ++i) {
+                page.at_section(1).push_back(Element{Tag::P, "Paragraph " + std::to_string(i)});
+            }
+
+            return page;
+        };
+
+        // sends the page over one end of a socket pair and reads it back from the other, keeping the chunks in the order they were sent
+        const auto serve = [](const Section& page) {
+            int fds[2]{};
+            REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+            std::string received{};
+            std::thread reader{[&received, fd = fds[1]]() {
+                char buffer[4096]{};
+                ssize_t n{};
+                while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+                    received.append(buffer, static_cast<std::size_t>(n));
+                }
+            }};
+
+            Renderer renderer{page, Formatting::Pretty};
+            std::vector<std::string> chunks{};
+            char buffer[1024]{};
+            bool failed{false};
+
+            for (bygg::size_type n{}; !failed && (n = renderer.next_chunk(buffer, sizeof(buffer))) != 0;) {
+                chunks.emplace_back(buffer, n);
+
+                for (bygg::size_type written{0}; !failed && written < n;) {
+                    const ssize_t ret{write(fds[0], buffer + written, n - written)};
+                    failed = ret <= 0;
+                    written += failed ? 0 : static_cast<bygg::size_type>(ret);
+                }
+            }
+
+            close(fds[0]);
+            reader.join();
+            close(fds[1]);
+
+            REQUIRE(!failed);
+            REQUIRE(received == page.get(Formatting::Pretty));
+            return chunks;
+        };
+
+        const std::string head{"<html>\n\t<head>\n\t\t<title>Title</title>\n\t</head>"};
+        const auto small{serve(make_large_page(10))};
+        const auto large{serve(make_large_page(100000))};
+
+        // the head is sent on its own, before anything in the body has been rendered, however large the body is
+        REQUIRE(small.at(0) == head);
+        REQUIRE(large.at(0) == head);
+        REQUIRE(large.size() > 1000);
+        REQUIRE(large.at(1).rfind("\n\t<body>\n\t\t<p>Paragraph 0</p>", 0) == 0);
+    };
+#endif
+
+    test_string_sink();
+    test_stream_sink();
+    test_fixed_buffer_sink();
+    test_serialized_size();
+    test_renderer();
+    test_writer();
+#ifndef _WIN32
+    test_file_descriptor_sink();
+    test_renderer_socket();
+#endif
+}
+
+void HTML::test_tree() {
+    const auto make_page = []() {
+        using namespace bygg::HTML;
+
+        return Section{Tag::Html,
+            Section{Tag::Head,
+                Element{Tag::Title, "Title"}
+            },
+            Section{Tag::Body, make_properties(Property("class", "main")),
+                Element{Tag::H1, "Hello, World!"},
+                Element{Tag::Img, make_properties(Property("src", "image.png"))},
+                Section{Tag::Div,
+                    Element{Tag::P, "  multiple   spaces\tand\ttabs  "},
+                    Element{Tag::P, "<'quoted' \"text\">", ElementParameters::Replace_All},
+                    Section{},
+                },
+                Section{bygg::string_type{},
+                    Element{"", "text", Type::Text},
+                    Element{"", "trailing\n", Type::Text_No_Formatting, ElementParameters::Erase_None},
+                },
+                Section{Tag::Span},
+            },
+        };
+    };
+
+    const auto test_conversion = [&make_page]() {
+        using namespace bygg::HTML;
+
+        const Section page = make_page();
+        const Tree tree{page};
+
+        REQUIRE(tree.size() == 14);
+        REQUIRE(tree.get_tag(Tree::root()) == "html");
+        REQUIRE(tree.to_section() == page);
+        REQUIRE(tree.to_section().get(Formatting::Pretty) == page.get(Formatting::Pretty));
+
+        for (const auto formatting : {Formatting::None, Formatting::Pretty, Formatting::Newline}) {
+            for (const bygg::integer_type tabc : {0, 1, 3}) {
+                REQUIRE(tree.get(formatting, tabc) == page.get(formatting, tabc));
+                REQUIRE(tree.serialized_size(formatting, tabc) == page.get(formatting, tabc).size());
+            }
+        }
+
+        const Tree empty{};
+        REQUIRE(empty.empty());
+        REQUIRE(empty.size() == 1);
+        REQUIRE(empty.get().empty());
+        REQUIRE(empty.to_section() == Section{});
+    };
+
+    const auto test_building = []() {
+        using namespace bygg::HTML;
+
+        Tree tree{};
+        const Tree::index_type body = tree.add_section(Tree::root(), Tag::Body, make_properties(Property("id", "body")));
+        const Tree::index_type h1 = tree.add_element(body, Tag::H1, "Heading");
+        tree.add_element(body, Tag::Img, make_properties(Property("src", "a.png")));
+        tree.add_element(body, "p", {}, "Paragraph", Type::Data);
+
+        REQUIRE(!tree.empty());
+        REQUIRE(tree.at(h1).parent == body);
+        REQUIRE(tree.at(body).first_child == h1);
+        REQUIRE(tree.at(body).section);
+        REQUIRE(!tree.at(h1).section);
+        REQUIRE(tree.get_data(h1) == "Heading");
+        REQUIRE(tree.get_properties(body).at(0).get_value() == "body");
+        REQUIRE(tree.get() == "<body id=\"body\"><h1>Heading</h1><img src=\"a.png\"/><p>Paragraph</p></body>");
+
+        const Section expected{bygg::string_type{},
+            Section{Tag::Body, make_properties(Property("id", "body")),
+                Element{Tag::H1, "Heading"},
+                Element{Tag::Img, make_properties(Property("src", "a.png"))},
+                Element{"p", "Paragraph"},
+            },
+        };
+        REQUIRE(tree.to_section() == expected);
+        REQUIRE(tree.get(Formatting::Pretty) == expected.get(Formatting::Pretty));
+
+        try {
+            tree.add_element(h1, Tag::P, "Not a section");
+            REQUIRE(false);
+        } catch (const bygg::out_of_range&) {
+            REQUIRE(true);
+        }
+
+        try {
+            static_cast<void>(tree.at(100));
+            REQUIRE(false);
+        } catch (const bygg::out_of_range&) {
+            REQUIRE(true);
+        }
+
+        tree.clear();
+        REQUIRE(tree.empty());
+        REQUIRE(tree.get().empty());
+    };
+
+    const auto test_memory_resource = [&make_page]() {
+        using namespace bygg::HTML;
+
+        const Section page = make_page();
+        Section with_footer = page;
+        with_footer.push_back(Section{Tag::Footer, Element{Tag::P, "Footer"}});
+
+        std::byte buffer[16384]{};
+        std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+        // anything not taken from the arena would fail to allocate
+        std::pmr::memory_resource* previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+        Tree tree{page, &arena};
+        const Tree::index_type extra = tree.add_section(Tree::root(), Tag::Footer);
+        tree.add_element(extra, Tag::P, "Footer");
+
+        std::pmr::set_default_resource(previous);
+
+        REQUIRE(tree.get_resource() == &arena);
+        REQUIRE(tree.get(Formatting::Pretty) == with_footer.get(Formatting::Pretty));
+
+        Tree moved{std::move(tree)};
+        REQUIRE(moved.get_resource() == &arena);
+
+        const Tree copied{moved};
+        REQUIRE(copied.get_resource() == std::pmr::get_default_resource());
+        REQUIRE(copied.get() == moved.get());
+
+        // tags are looked up without allocating, however long they are
+        class CountingResource : public std::pmr::memory_resource {
+                void* do_allocate(const std::size_t bytes, const std::size_t alignment) override {
+                    ++this->count;
+                    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+                }
+                void do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) override {
+                    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+                }
+                [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+                    return this == &other;
+                }
+            public:
+                std::size_t count{};
+        };
+
+        const auto count_allocations = [](const std::string_view tag) {
+            CountingResource resource{};
+            Tree tags{&resource};
+
+            for (int i{0}; i < 1000; ++i) {
+                tags.add_element(Tree::root(), tag, {});
+            }
+
+            REQUIRE(tags.get_tag(tags.at(Tree::root()).first_child) == tag);
+            return resource.count;
+        };
+
+        REQUIRE(count_allocations("x") + 1 == count_allocations("a-long-custom-element-tag"));
+    };
+
+    test_conversion();
+    test_building();
+    test_memory_resource();
+}
+
+void HTML::test_selector() {
+    const auto make_page = []() {
+        using namespace bygg::HTML;
+
+        return Section{Tag::Html,
+            Section{Tag::Body, Properties{Property{"class", "page"}},
+                Section{Tag::Div, Properties{Property{"id", "content"}, Property{"class", "content main"}},
+                    Element{Tag::P, "First"},
+                    Element{Tag::P, Properties{Property{"class", "note"}}, "Second"},
+                    Element{Tag::Span, "Third"},
+                    Element{Tag::P, "Fourth"},
+                },
+                Section{Tag::Div, Properties{Property{"class", "footer"}, Property{"lang", "en-US"}},
+                    Element{Tag::A, Properties{Property{"href", "https://example.com/index.html"}}, "Link"},
+                },
+            },
+        };
+    };
+
+    const auto data = [](const bygg::HTML::Section::variant_t* member) {
+        return member == nullptr ? std::string{"null"} : std::get<bygg::HTML::Element>(*member).get_data();
+    };
+
+    const auto test_compound_selectors = [&]() {
+        using namespace bygg::HTML;
+
+        Section page = make_page();
+
+        REQUIRE(query_selector_all(page, "p").size() == 3);
+        REQUIRE(query_selector_all(page, "*").size() == 8);
+        REQUIRE(query_selector_all(page, "P").size() == 3);
+        REQUIRE(query_selector_all(page, "div").size() == 2);
+        REQUIRE(std::get<Section>(*query_selector(page, "#content")).get_properties().at(0).get_value() == "content");
+        REQUIRE(query_selector_all(page, ".main.content").size() == 1);
+        REQUIRE(query_selector_all(page, "div.footer").size() == 1);
+        REQUIRE(query_selector(page, "div.missing") == nullptr);
+        REQUIRE(data(query_selector(page, "p.note")) == "Second");
+        REQUIRE(data(query_selector(page, "[href]")) == "Link");
+        REQUIRE(data(query_selector(page, "a[href^='https://']")) == "Link");
+        REQUIRE(data(query_selector(page, "a[href$=\".html\"]")) == "Link");
+        REQUIRE(data(query_selector(page, "a[href*=example]")) == "Link");
+        REQUIRE(query_selector(page, "a[href=index]") == nullptr);
+        REQUIRE(query_selector_all(page, "[class~=main]").size() == 1);
+        REQUIRE(query_selector_all(page, "[lang|=en]").size() == 1);
+    };
+
+    const auto test_combinators = [&]() {
+        using namespace bygg::HTML;
+
+        Section page = make_page();
+
+        REQUIRE(query_selector_all(page, "div.content > p").size() == 3);
+        REQUIRE(query_selector_all(page, "body p").size() == 3);
+        REQUIRE(query_selector_all(page, "html > p").empty());
+        REQUIRE(query_selector_all(page, ".page a").size() == 1);
+        REQUIRE(data(query_selector(page, "p + span")) == "Third");
+        REQUIRE(data(query_selector(page, "span + p")) == "Fourth");
+        REQUIRE(query_selector_all(page, "p ~ p").size() == 2);
+        REQUIRE(query_selector_all(page, "p.note ~ *").size() == 2);
+        REQUIRE(query_selector_all(page, "div ~ div").size() == 1);
+        REQUIRE(query_selector_all(page, "span, a").size() == 2);
+
+        // the section being searched takes part in matching, but is never returned
+        REQUIRE(query_selector_all(page, "html p").size() == 3);
+        REQUIRE(query_selector(page, "html") == nullptr);
+    };
+
+    const auto test_pseudo_classes = [&]() {
+        using namespace bygg::HTML;
+
+        Section page = make_page();
+
+        REQUIRE(data(query_selector(page, "div.content > p:first-child")) == "First");
+        REQUIRE(data(query_selector(page, "div.content > :last-child")) == "Fourth");
+        REQUIRE(data(query_selector(page, "p:last-of-type")) == "Fourth");
+        REQUIRE(data(query_selector(page, "span:first-of-type")) == "Third");
+        REQUIRE(data(query_selector(page, "a:only-child")) == "Link");
+        REQUIRE(data(query_selector(page, "span:only-of-type")) == "Third");
+        REQUIRE(query_selector_all(page, "p:only-of-type").empty());
+        REQUIRE(data(query_selector(page, ":nth-child(2)")) == "Second");
+        REQUIRE(query_selector_all(page, "div > :nth-child(odd)").size() == 3);
+        REQUIRE(query_selector_all(page, "div > :nth-child(2n)").size() == 2);
+        REQUIRE(query_selector_all(page, "div > :nth-child(-n + 2)").size() == 3);
+        REQUIRE(data(query_selector(page, "p:nth-of-type(3)")) == "Fourth");
+        REQUIRE(data(query_selector(page, "p:nth-last-child(2)")) == "null");
+        REQUIRE(data(query_selector(page, "span:nth-last-child(2)")) == "Third");
+        REQUIRE(data(query_selector(page, "p:nth-last-of-type(3)")) == "First");
+        REQUIRE(query_selector_all(page, "p:not(.note)").size() == 2);
+        REQUIRE(query_selector_all(page, "div > :not(p, a)").size() == 1);
+
+        Section empty{Tag::Div, Section{Tag::Span}, Element{Tag::B, ""}, Element{Tag::I, "text"}};
+        REQUIRE(query_selector_all(empty, ":empty").size() == 2);
+    };
+
+    const auto test_fragments = []() {
+        using namespace bygg::HTML;
+
+        // members of sections without a tag belong to the section containing them
+        Section list{Tag::Ul,
+            Element{Tag::Li, "One"},
+            Section{"", Element{Tag::Li, "Two"}, Element{Tag::Li, "Three"}},
+            Element{"", "text", Type::Text},
+            Element{Tag::Li, "Four"},
+        };
+
+        Section root{};
+        root.push_back(list);
+
+        REQUIRE(query_selector_all(root, "ul > li").size() == 4);
+        REQUIRE(std::get<Element>(*query_selector(root, "li:nth-child(3)")).get_data() == "Three");
+        REQUIRE(std::get<Element>(*query_selector(root, "li + li + li + li")).get_data() == "Four");
+        REQUIRE(std::get<Element>(*query_selector(root, "li:last-child")).get_data() == "Four");
+    };
+
+    const auto test_compiled = [&]() {
+        using namespace bygg::HTML;
+
+        const Selector selector{"div.content > p:first-child"};
+        REQUIRE(selector.get() == "div.content > p:first-child");
+
+        Section first = make_page();
+        const Section second = make_page();
+
+        // results refer to the members in the tree, so changes go through to it
+        Section::variant_t* paragraph = selector.query(first);
+        REQUIRE(paragraph != nullptr);
+        std::get<Element>(*paragraph).set_data("Changed");
+        REQUIRE(first.get().find("<p>Changed</p>") != std::string::npos);
+
+        REQUIRE(selector.query_all(second).size() == 1);
+        REQUIRE(query_selector(second, selector) != nullptr);
+        REQUIRE(query_selector_all(first, selector).size() == 1);
+
+        REQUIRE_THROWS_AS(Selector{""}, bygg::invalid_argument);
+        REQUIRE_THROWS_AS(Selector{"div >"}, bygg::invalid_argument);
+        REQUIRE_THROWS_AS(Selector{"p,"}, bygg::invalid_argument);
+        REQUIRE_THROWS_AS(Selector{"[href"}, bygg::invalid_argument);
+        REQUIRE_THROWS_AS(Selector{"p::before"}, bygg::invalid_argument);
+        REQUIRE_THROWS_AS(Selector{"p:hover"}, bygg::invalid_argument);
+        REQUIRE_THROWS_AS(Selector{"p:nth-child(2n3)"}, bygg::invalid_argument);
+    };
+
+    test_compound_selectors();
+    test_combinators();
+    test_pseudo_classes();
+    test_fragments();
+    test_compiled();
+}
+
 void HTML::test_pseudocode_generator() {
     using namespace bygg::HTML;
 
@@ -8,6 +8,15 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <memory_resource>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string_view>
+#include <utility>
 #include <bygg/bygg.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include "test.hpp"
@@ -16,7 +25,6 @@
 // Disable linting. This is a test program and the code is intentionally bad in some places.
 // As such, I think it's best to turn linting off rather than to try and resolve any such warnings.
 
-#ifdef BYGG_USE_LIBXML2
 void Parser::test_html_parser() {
     /*
     const auto test_struct_output = []() {
@@ -77,6 +85,277 @@ void Parser::test_html_parser() {
         REQUIRE(document.get() == html);
     };
 
+    const auto test_inline_markup = []() {
+        using namespace bygg::HTML::Parser;
+
+        const std::string html = "<p>a<!-- c -->b <b> x </b><!-- c --> y </p><p><b>only</b></p><p><input disabled> z</p>";
+
+        REQUIRE(bygg::HTML::Parser::parse_html_string(html).get() == "<html><body><p>ab <b>x</b> y</p><p><b>only</b></p><p><input disabled=\"disabled\"/> z</p></body></html>");
+
+        bygg::HTML::Parser::Options options{};
+        options.handle_inner_tags = false;
+
+        REQUIRE(bygg::HTML::Parser::parse_html_string(html, options).get() == "<html><body><p>ab y</p><b>x</b><p></p><b>only</b><p>z</p><input disabled=\"disabled\"/></body></html>");
+
+        // nested inline markup is written into the data of the element holding it
+        std::string nested{"<p>"};
+        std::string expected{"<html><body><p>"};
+
+        for (int i = 0; i < 100; ++i) {
+            nested += "<span>" + std::to_string(i) + " ";
+            expected += "<span>" + std::to_string(i) + (i < 99 ? " " : "");
+        }
+
+        for (int i = 0; i < 100; ++i) {
+            nested += "</span>";
+            expected += "</span>";
+        }
+
+        REQUIRE(bygg::HTML::Parser::parse_html_string(nested + "</p>").get() == expected + "</p></body></html>");
+    };
+
+    const auto test_stream = []() {
+        using namespace bygg::HTML::Parser;
+        using bygg::HTML::Section;
+
+        const std::vector<std::string> inputs{
+            "<html><head><title>Test</title></head><body><h1>Hello, World!</h1></body></html>",
+            "<html><head><title>Title</title></head><body><p>Paragraph with a <strong>strong</strong> tag in between. And an <em>Italic</em> for good measure.</p></body></html>",
+            "<!DOCTYPE html>\n<html>\n  <head>\n    <meta charset=\"utf-8\">\n    <script>var a = \"<p>\";</script>\n  </head>\n"
+                "  <body class=\"main\">\n    <!-- comment -->\n    <div id=\"a\">\n      <p>Line one\n      line two &amp; <a href=\"/x?a=1&amp;b=2\">link <b>bold</b></a> end</p>\n"
+                "      <input type=\"checkbox\" checked>\n      <ul><li>One</li><li>Two <em>2</em></li></ul>\n    </div>\n    <p>After</p>\n  </body>\n</html>\n",
+            "<p>Unclosed <b>tags",
+        };
+
+        for (const auto& html : inputs) {
+            const Section expected = bygg::HTML::Parser::parse_html_string(html);
+
+            for (const std::size_t size : {std::size_t{1}, std::size_t{7}, html.size()}) {
+                bygg::HTML::Parser::StreamParser parser{};
+
+                for (std::size_t i = 0; i < html.size(); i += size) {
+                    parser.feed(html.data() + i, std::min(size, html.size() - i));
+                }
+
+                REQUIRE(parser.finish() == expected);
+            }
+
+            std::istringstream stream{html};
+            REQUIRE(bygg::HTML::Parser::parse_html_stream(stream) == expected);
+        }
+
+        // elements following one with inline markup are kept
+        const std::string html = "<html><body><p>a <b>x</b></p><p>next</p></body></html>";
+        std::istringstream stream{html};
+        REQUIRE(bygg::HTML::Parser::parse_html_stream(stream).get() == html);
+        REQUIRE(bygg::HTML::Parser::parse_html_string(html).get() == html);
+
+        bygg::HTML::Parser::StreamParser empty{};
+        REQUIRE(empty.finish().empty());
+        REQUIRE_THROWS_AS(empty.feed("<p>"), bygg::invalid_argument);
+    };
+
+    const auto test_parsed_document = []() {
+        using namespace bygg::HTML::Parser;
+        using Document = bygg::HTML::Parser::ParsedDocument;
+
+        const std::string html = "<html><body><div id=\"main\" class=\"a b\">Loose text<p>Text &amp; <b>bold</b> tail</p><input checked></div></body></html>";
+
+        std::pmr::monotonic_buffer_resource resource{};
+        const Document document{html, &resource};
+
+        REQUIRE(document.get_resource() == &resource);
+        REQUIRE(document.size() == 10);
+        REQUIRE(document.get_tag(0) == "html");
+        REQUIRE(document.at(0).parent == Document::npos);
+        REQUIRE(document.at(0).end == document.size());
+        REQUIRE(document.get_tag(2) == "div");
+        REQUIRE(document.at(2).parent == 1);
+        REQUIRE(document.find_attribute(2, "class") == "a b");
+        REQUIRE(document.find_attribute(2, "missing").empty());
+        REQUIRE(document.get_attribute(2, 0) == std::pair<std::string_view, std::string_view>{"id", "main"});
+        REQUIRE(document.get_properties(2) == bygg::HTML::make_properties(bygg::HTML::Property{"id", "main"}, bygg::HTML::Property{"class", "a b"}));
+        REQUIRE(document.get_text(3) == "Loose text");
+        REQUIRE(document.get_tag(3).empty());
+        REQUIRE(document.get_text(5) == "Text & ");
+        REQUIRE(document.get_tag(6) == "b");
+        REQUIRE(document.at(4).end == 9);
+        REQUIRE(document.find_attribute(9, "checked") == "checked");
+        REQUIRE_THROWS_AS(document.at(10), bygg::out_of_range);
+        REQUIRE_THROWS_AS(document.get_attribute(2, 2), bygg::out_of_range);
+
+        REQUIRE(document.to_section() == bygg::HTML::Parser::parse_html_string(html));
+
+        bygg::HTML::Parser::Options options{};
+        options.handle_inner_tags = false;
+        REQUIRE(document.to_section(options) == bygg::HTML::Parser::parse_html_string(html, options));
+
+        REQUIRE(Document{""}.empty());
+    };
+
+    const auto test_native_backend = []() {
+        using namespace bygg::HTML::Parser;
+
+        bygg::HTML::Parser::Options options{};
+        options.backend = bygg::HTML::Parser::Backend::Native;
+
+        const auto parse = [&options](const std::string& html) {
+            return bygg::HTML::Parser::parse_html_string(html, options).get();
+        };
+
+        // html, head, body and p are implied, and void elements need no closing tag
+        REQUIRE(parse("<title>T</title><p>a<br>b<img src=x></p>") == "<html><head><title>T</title></head><body><p>a<br/>b<img src=\"x\"/></p></body></html>");
+        REQUIRE(parse("Loose text") == "<html><body><p>Loose text</p></body></html>");
+        REQUIRE(parse("<p>a<p>b<div><p>c</div>") == "<html><body><p>a</p><p>b</p><div><p>c</p></div></body></html>");
+
+        // tags and attribute names are lowercased, and the first of duplicate attributes is kept
+        REQUIRE(parse("<DIV ID=a id=b Class='c d'><P>x</DIV>") == "<html><body><div id=\"a\" class=\"c d\"><p>x</p></div></body></html>");
+        REQUIRE(parse("<input type=checkbox checked><a href=\"/?a=1&amp;b=2\">l</a>") == "<html><body><input type=\"checkbox\" checked=\"checked\"/><a href=\"/?a=1&b=2\">l</a></body></html>");
+
+        // named references need a semicolon, numeric ones do not
+        REQUIRE(parse("<p>&lt;&amp;&gt; &#65;&#x42 &copy; &nosuch; &amp</p>") == "<html><body><p><&> AB \xC2\xA9 &nosuch; &amp</p></body></html>");
+
+        // tags in scripts and comments are not parsed, and doctypes are dropped
+        REQUIRE(parse("<!DOCTYPE html><script>if (a < b && c) x = \"<p>\";</script><!-- <p> -->") == "<html><head><script></script></head></html>");
+
+        // closing tags that match nothing are ignored
+        REQUIRE(parse("<div><p>a</h1></p></div>") == "<html><body><div><p>a</p></div></body></html>");
+
+        // input split anywhere gives the same sections
+        const std::string html = "<html><head><title>&lt;Test&gt;</title></head><body><p class=\"a\">caf\xC3\xA9 &eacute;<!-- x --><br/></p><script>a</b</script></body></html>";
+        const auto expected = bygg::HTML::Parser::parse_html_string(html, options);
+
+        for (std::size_t size = 1; size < 8; ++size) {
+            bygg::HTML::Parser::StreamParser parser{options};
+
+            for (std::size_t i = 0; i < html.size(); i += size) {
+                parser.feed(html.data() + i, std::min(size, html.size() - i));
+            }
+
+            REQUIRE(parser.finish() == expected);
+        }
+
+        REQUIRE(bygg::HTML::Parser::ParsedDocument{html, std::pmr::get_default_resource(), bygg::HTML::Parser::Backend::Native}.to_section() == expected);
+    };
+
+    const auto test_backends = []() {
+        using namespace bygg::HTML::Parser;
+        using bygg::HTML::Parser::Backend;
+
+        REQUIRE(bygg::HTML::Parser::is_backend_available(Backend::Default));
+        REQUIRE(bygg::HTML::Parser::is_backend_available(Backend::Native));
+        REQUIRE(bygg::HTML::Parser::get_default_backend() != Backend::Default);
+
+        const auto initial = bygg::HTML::Parser::get_default_backend();
+
+        bygg::HTML::Parser::set_default_backend(Backend::Native);
+        REQUIRE(bygg::HTML::Parser::get_default_backend() == Backend::Native);
+        bygg::HTML::Parser::set_default_backend(Backend::Default);
+        REQUIRE(bygg::HTML::Parser::get_default_backend() == initial);
+
+#ifdef BYGG_USE_LIBXML2
+        REQUIRE(bygg::HTML::Parser::is_backend_available(Backend::Libxml2));
+
+        // both backends build the same sections from the same input
+        const std::vector<std::string> inputs{
+            "<html><head><title>Test</title></head><body><h1>Hello, World!</h1></body></html>",
+            "<!DOCTYPE html>\n<html>\n  <head>\n    <meta charset=\"utf-8\">\n    <script>var a = \"<p>\";</script>\n  </head>\n"
+                "  <body class=\"main\">\n    <!-- comment -->\n    <div id=\"a\">\n      <p>Line one\n      line two &amp; <a href=\"/x?a=1&amp;b=2\">link <b>bold</b></a> end</p>\n"
+                "      <input type=\"checkbox\" checked>\n      <ul><li>One</li><li>Two <em>2</em></li></ul>\n    </div>\n    <p>After</p>\n  </body>\n</html>\n",
+            "<p>Unclosed <b>tags",
+            "text &copy; &#169; <table><tr><td>a<td>b<tr><td>c</table><dl><dt>t<dd>d</dl>",
+        };
+
+        bygg::HTML::Parser::Options native{};
+        native.backend = Backend::Native;
+        bygg::HTML::Parser::Options libxml2{};
+        libxml2.backend = Backend::Libxml2;
+
+        for (const auto& html : inputs) {
+            REQUIRE(bygg::HTML::Parser::parse_html_string(html, native) == bygg::HTML::Parser::parse_html_string(html, libxml2));
+            native.handle_inner_tags = libxml2.handle_inner_tags = false;
+            REQUIRE(bygg::HTML::Parser::parse_html_string(html, native) == bygg::HTML::Parser::parse_html_string(html, libxml2));
+            native.handle_inner_tags = libxml2.handle_inner_tags = true;
+        }
+#else
+        REQUIRE_FALSE(bygg::HTML::Parser::is_backend_available(Backend::Libxml2));
+
+        bygg::HTML::Parser::Options options{};
+        options.backend = Backend::Libxml2;
+        REQUIRE_THROWS_AS(bygg::HTML::Parser::parse_html_string("<p>", options), bygg::invalid_argument);
+#endif
+    };
+
+    const auto test_parse_many = []() {
+        using namespace bygg::HTML::Parser;
+        using bygg::HTML::Section;
+
+        std::vector<std::string> documents{};
+
+        for (int i = 0; i < 64; ++i) {
+            documents.push_back("<html><head><title>Page " + std::to_string(i) + "</title></head><body><div id=\"d" + std::to_string(i) + "\"><p>Text &amp; <b>bold</b> " + std::to_string(i) + "</p></div></body></html>");
+        }
+
+        bygg::HTML::ParallelOptions parallel{};
+        parallel.threads = 4;
+
+        std::vector<bygg::HTML::Parser::Backend> backends{bygg::HTML::Parser::Backend::Native};
+#ifdef BYGG_USE_LIBXML2
+        backends.push_back(bygg::HTML::Parser::Backend::Libxml2);
+#endif
+
+        for (const auto backend : backends) {
+            bygg::HTML::Parser::Options options{};
+            options.backend = backend;
+
+            const auto sections = bygg::HTML::Parser::parse_many(documents, options, parallel);
+
+            REQUIRE(sections.size() == documents.size());
+            for (std::size_t i = 0; i < documents.size(); ++i) {
+                REQUIRE(sections[i] == bygg::HTML::Parser::parse_html_string(documents[i], options));
+            }
+
+            // every document but the first is given to the executor
+            int submitted{0};
+            bygg::HTML::ParallelOptions executor{};
+            executor.executor = [&submitted](std::function<void()> task) {
+                ++submitted;
+                task();
+            };
+            REQUIRE(bygg::HTML::Parser::parse_many(documents, options, executor) == sections);
+            REQUIRE(submitted == 63);
+
+            // the first error is thrown once every document has been parsed
+            std::vector<std::string> invalid{documents};
+            invalid[10].clear();
+            REQUIRE_THROWS_AS(bygg::HTML::Parser::parse_many(invalid, options, parallel), bygg::invalid_argument);
+        }
+
+        REQUIRE(bygg::HTML::Parser::parse_many({}).empty());
+
+        const auto directory = std::filesystem::temp_directory_path();
+        std::vector<std::string> paths{};
+
+        for (std::size_t i = 0; i < 8; ++i) {
+            paths.push_back((directory / ("bygg_parse_many_" + std::to_string(i) + ".html")).string());
+            std::ofstream{paths.back(), std::ios::binary} << documents[i];
+        }
+
+        const auto files = bygg::HTML::Parser::parse_many_files(paths, {}, parallel);
+
+        REQUIRE(files.size() == paths.size());
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            REQUIRE(files[i] == bygg::HTML::Parser::parse_html_string(documents[i]));
+        }
+
+        paths.push_back((directory / "bygg_parse_many_missing.html").string());
+        REQUIRE_THROWS_AS(bygg::HTML::Parser::parse_many_files(paths, {}, parallel), bygg::invalid_argument);
+
+        for (const auto& path : paths) {
+            std::filesystem::remove(path);
+        }
+    };
+
     /*
     test_struct_output();
     */
@@ -84,5 +363,10 @@ void Parser::test_html_parser() {
     test_slightly_more_advanced();
     test_divs();
     test_with_tags_in_between();
-}
-#endif
\ No newline at end of file
+    test_inline_markup();
+    test_stream();
+    test_parsed_document();
+    test_native_backend();
+    test_backends();
+    test_parse_many();
+}
\ No newline at end of file
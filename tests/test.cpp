@@ -34,6 +34,9 @@ SCENARIO("Test HTML", "[HTML]") {
     HTML::test_element();
     HTML::test_section();
     HTML::test_document();
+    HTML::test_sink();
+    HTML::test_tree();
+    HTML::test_selector();
     HTML::test_pseudocode_generator();
 }
 
@@ -49,13 +52,11 @@ SCENARIO("Test CSS", "[CSS]") {
     CSS::test_function();
 }
 
-#ifdef BYGG_USE_LIBXML2
 /**
  * @brief Test cases for the bygg namespace.
  */
-SCENARIO("Test HTML parser", "[libxml2]") {
+SCENARIO("Test HTML parser", "[parser]") {
     Parser::test_html_parser();
 }
-#endif
 
 // NOLINTEND
\ No newline at end of file
@@ -16,6 +16,9 @@ namespace HTML {
     void test_element();
     void test_section();
     void test_document();
+    void test_sink();
+    void test_tree();
+    void test_selector();
     void test_pseudocode_generator();
 } // namespace HTML
 
@@ -34,8 +37,6 @@ inline namespace General {
     void test_version();
 }
 
-#ifdef BYGG_USE_LIBXML2
 inline namespace Parser {
     void test_html_parser();
-}
-#endif
\ No newline at end of file
+}
\ No newline at end of file